@@ -858,6 +858,12 @@ extern "C"
         SlangCompileRequest* request,
         ISlangBlob** outBlob);
 
+    /// Write the reflection information in the flat binary format described in
+    /// `slang-reflection-snapshot.h`.
+    SLANG_API SlangResult spReflection_ToSnapshot(
+        SlangReflection* reflection,
+        ISlangBlob** outBlob);
+
     SLANG_API unsigned spReflection_GetParameterCount(SlangReflection* reflection);
     SLANG_API SlangReflectionParameter* spReflection_GetParameterByIndex(
         SlangReflection* reflection,
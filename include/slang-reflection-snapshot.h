@@ -0,0 +1,307 @@
+#ifndef SLANG_REFLECTION_SNAPSHOT_H
+#define SLANG_REFLECTION_SNAPSHOT_H
+
+// A flat binary snapshot of the reflection information of a linked program, and a
+// reader for it that doesn't depend on anything else from Slang.
+//
+// A snapshot is produced by `spReflection_ToSnapshot` (or
+// `slang::ShaderReflection::toSnapshot`), by `slangc -reflection-snapshot <path>`,
+// or as an artifact associated with the results of `IComponentType::getResultAsFileSystem`
+// when `CompilerOptionName::ReflectionSnapshotArtifact` is set.
+//
+// The snapshot holds no pointers, so it can be used directly from memory that a file is
+// mapped to. It is made of
+//
+// * A `Header`, at offset 0
+// * Arrays of fixed-size records for types, fields, bindings and entry points
+// * A table of 0-terminated strings, which records refer to by their byte offset
+//
+// Records refer to each other by index, and use `kNone` for a missing reference.
+// All values are 32 bit unsigned integers in the byte order of the host that wrote the
+// snapshot, so that they can be used in place. A snapshot written on a host with the other
+// byte order is rejected by `Reader::init`, because its `Header::magic` doesn't match.
+//
+// The size of each kind of record is stored in the header. Later versions of the format
+// may add values to the end of a record without changing `kVersion`, and a reader only
+// relies on the values it knows about.
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace slang
+{
+namespace reflection_snapshot
+{
+
+static const uint32_t kMagic = 0x4c465253; // "SRFL"
+static const uint32_t kVersion = 1;
+
+/// Used for a missing reference, and for sizes or counts that are unbounded.
+static const uint32_t kNone = 0xffffffff;
+
+enum class SectionKind : uint32_t
+{
+    Types,
+    Fields,
+    Bindings,
+    EntryPoints,
+    CountOf,
+};
+
+struct Section
+{
+    /// Offset of the first record, in bytes from the start of the snapshot
+    uint32_t offset;
+    /// The number of records
+    uint32_t count;
+    /// The size of a record, which is at least the size of the record type
+    uint32_t recordSize;
+};
+
+struct Header
+{
+    /// `kMagic`
+    uint32_t magic;
+    /// `kVersion`
+    uint32_t version;
+    /// The size of the whole snapshot in bytes
+    uint32_t size;
+
+    Section sections[uint32_t(SectionKind::CountOf)];
+
+    /// Offset of the string table, which starts with an empty string
+    uint32_t stringsOffset;
+    /// Size of the string table, which ends with a 0
+    uint32_t stringsSize;
+
+    /// Index of the field for the first global shader parameter
+    uint32_t firstParameter;
+    /// The number of global shader parameters
+    uint32_t parameterCount;
+};
+
+/// The layout of a type. Layouts of the same type can differ, for example between a
+/// type used in a constant buffer and used for varying input.
+struct TypeRecord
+{
+    /// Offset of the name of the type in the string table
+    uint32_t name;
+    /// `SlangTypeKind`
+    uint32_t kind;
+    /// `SlangScalarType`, for scalars, vectors and matrices
+    uint32_t scalarType;
+    uint32_t rowCount;
+    uint32_t columnCount;
+    /// For arrays. `kNone` for unbounded arrays
+    uint32_t elementCount;
+    /// Type of the elements of an array, buffer, or parameter group
+    uint32_t elementType;
+    /// `SlangResourceShape`
+    uint32_t resourceShape;
+    /// `SlangResourceAccess`
+    uint32_t resourceAccess;
+    /// Size of the ordinary data of the type in bytes
+    uint32_t uniformSize;
+    uint32_t uniformAlignment;
+    /// For arrays, the distance between elements in bytes
+    uint32_t uniformStride;
+    /// For structures, index of the first field
+    uint32_t firstField;
+    uint32_t fieldCount;
+};
+
+/// A variable: a field of a structure, a shader parameter, or an entry point parameter
+/// or result.
+struct FieldRecord
+{
+    /// Offset of the name of the variable in the string table
+    uint32_t name;
+    /// Index of the type
+    uint32_t type;
+    uint32_t firstBinding;
+    uint32_t bindingCount;
+    /// Offset of the semantic name in the string table
+    uint32_t semanticName;
+    uint32_t semanticIndex;
+};
+
+/// The resources of one parameter category that a variable uses.
+struct BindingRecord
+{
+    /// `SlangParameterCategory`
+    uint32_t category;
+    /// The first binding, or the byte offset for uniform data
+    uint32_t index;
+    /// The binding space or set
+    uint32_t space;
+    /// The number of bindings, or bytes. `kNone` if unbounded
+    uint32_t count;
+};
+
+struct EntryPointRecord
+{
+    /// Offset of the name of the entry point in the string table
+    uint32_t name;
+    /// `SlangStage`
+    uint32_t stage;
+    uint32_t threadGroupSize[3];
+    /// Index of the field for the first parameter
+    uint32_t firstParameter;
+    uint32_t parameterCount;
+    /// Index of the field for the result, or `kNone`
+    uint32_t result;
+};
+
+/// Reads the records of a snapshot held in memory, without copying them.
+///
+/// `init` checks that the header and all of the arrays lie within the snapshot. Indices
+/// held in records are checked when they are used to access another record.
+class Reader
+{
+public:
+    /// Start reading the snapshot in `data`, which must be 4 byte aligned and stay valid
+    /// while the reader is used. Returns false if `data` doesn't hold a snapshot that
+    /// this reader understands.
+    bool init(const void* data, size_t size)
+    {
+        m_data = nullptr;
+        if (!data || (size_t(data) & 3) != 0 || size < sizeof(Header))
+            return false;
+
+        const Header* header = (const Header*)data;
+        if (header->magic != kMagic || header->version != kVersion || header->size > size)
+            return false;
+
+        const size_t minRecordSizes[] = {
+            sizeof(TypeRecord),
+            sizeof(FieldRecord),
+            sizeof(BindingRecord),
+            sizeof(EntryPointRecord)};
+        for (uint32_t i = 0; i < uint32_t(SectionKind::CountOf); ++i)
+        {
+            const Section& section = header->sections[i];
+            if ((section.offset & 3) != 0 || (section.recordSize & 3) != 0 ||
+                section.recordSize < minRecordSizes[i] ||
+                uint64_t(section.offset) + uint64_t(section.count) * section.recordSize >
+                    header->size)
+            {
+                return false;
+            }
+        }
+
+        if (header->stringsSize == 0 ||
+            uint64_t(header->stringsOffset) + header->stringsSize > header->size ||
+            ((const char*)data)[header->stringsOffset + header->stringsSize - 1] != 0)
+        {
+            return false;
+        }
+
+        if (uint64_t(header->firstParameter) + header->parameterCount >
+            header->sections[uint32_t(SectionKind::Fields)].count)
+        {
+            return false;
+        }
+
+        m_data = (const char*)data;
+        return true;
+    }
+
+    bool isValid() const { return m_data != nullptr; }
+    const Header* getHeader() const { return (const Header*)m_data; }
+
+    /// Get the string at `offset` in the string table. Returns an empty string for an
+    /// invalid offset.
+    const char* getString(uint32_t offset) const
+    {
+        const Header* header = getHeader();
+        if (!header || offset >= header->stringsSize)
+            return "";
+        return m_data + header->stringsOffset + offset;
+    }
+
+    uint32_t getTypeCount() const { return _getCount(SectionKind::Types); }
+    const TypeRecord* getType(uint32_t index) const
+    {
+        return (const TypeRecord*)_getRecord(SectionKind::Types, index);
+    }
+
+    uint32_t getFieldCount() const { return _getCount(SectionKind::Fields); }
+    const FieldRecord* getField(uint32_t index) const
+    {
+        return (const FieldRecord*)_getRecord(SectionKind::Fields, index);
+    }
+
+    uint32_t getBindingCount() const { return _getCount(SectionKind::Bindings); }
+    const BindingRecord* getBinding(uint32_t index) const
+    {
+        return (const BindingRecord*)_getRecord(SectionKind::Bindings, index);
+    }
+
+    uint32_t getEntryPointCount() const { return _getCount(SectionKind::EntryPoints); }
+    const EntryPointRecord* getEntryPoint(uint32_t index) const
+    {
+        return (const EntryPointRecord*)_getRecord(SectionKind::EntryPoints, index);
+    }
+
+    /// The global shader parameters of the program.
+    uint32_t getParameterCount() const { return m_data ? getHeader()->parameterCount : 0; }
+    const FieldRecord* getParameter(uint32_t index) const
+    {
+        if (index >= getParameterCount())
+            return nullptr;
+        return getField(getHeader()->firstParameter + index);
+    }
+
+    /// Find the global shader parameter or entry point with the given name.
+    const FieldRecord* findParameter(const char* name) const
+    {
+        for (uint32_t i = 0; i < getParameterCount(); ++i)
+        {
+            const FieldRecord* parameter = getParameter(i);
+            if (_isEqual(getString(parameter->name), name))
+                return parameter;
+        }
+        return nullptr;
+    }
+    const EntryPointRecord* findEntryPoint(const char* name) const
+    {
+        for (uint32_t i = 0; i < getEntryPointCount(); ++i)
+        {
+            const EntryPointRecord* entryPoint = getEntryPoint(i);
+            if (_isEqual(getString(entryPoint->name), name))
+                return entryPoint;
+        }
+        return nullptr;
+    }
+
+private:
+    uint32_t _getCount(SectionKind kind) const
+    {
+        return m_data ? getHeader()->sections[uint32_t(kind)].count : 0;
+    }
+
+    const void* _getRecord(SectionKind kind, uint32_t index) const
+    {
+        if (index >= _getCount(kind))
+            return nullptr;
+        const Section& section = getHeader()->sections[uint32_t(kind)];
+        return m_data + section.offset + size_t(index) * section.recordSize;
+    }
+
+    static bool _isEqual(const char* a, const char* b)
+    {
+        while (*a && *a == *b)
+        {
+            ++a;
+            ++b;
+        }
+        return *a == *b;
+    }
+
+    const char* m_data = nullptr;
+};
+
+} // namespace reflection_snapshot
+} // namespace slang
+
+#endif
@@ -1008,6 +1008,33 @@ typedef uint32_t SlangSizeT;
 
         EmitReflectionJSON, // bool
         SaveGLSLModuleBinSource,
+
+        DisablePrecompiledPrelude, // bool
+
+        AutodiffCheckpointPolicy, // enum AutodiffCheckpointPolicy
+        AutodiffCheckpointBudget, // int, bytes
+
+        InlineThreshold, // int
+
+        DynamicDispatchProfile, // stringValue0: type name, intValue0: invocation count
+
+        UnrollSizeLimit,     // int
+        PartialUnrollFactor, // int
+
+        FastSPIRVOptimization, // bool
+        ParallelSPIRVFinalization, // bool
+
+        ValidateModuleTimestamps, // bool
+        ModuleDigestCache,        // string, path of the file holding the cache
+
+        LazyFunctionBodyChecking, // bool
+        DemandDrivenIRLowering,   // bool
+
+        EmitReflectionSnapshot, // string, path of the reflection snapshot to write
+        EmitIRPassTelemetry,    // string, path slangc writes the IR pass telemetry to
+
+        ReflectionSnapshotArtifact, // bool, add the reflection snapshot to the results
+        IRPassTelemetryArtifact,    // bool, record IR pass telemetry and add it to the results
         CountOf,
     };
 
@@ -3377,6 +3404,13 @@ struct ShaderReflection
     {
         return spReflection_ToJson((SlangReflection*)this, nullptr, outBlob);
     }
+
+    /// Get the reflection information in the flat binary format described in
+    /// `slang-reflection-snapshot.h`, which can be read without linking to Slang.
+    SlangResult toSnapshot(ISlangBlob** outBlob)
+    {
+        return spReflection_ToSnapshot((SlangReflection*)this, outBlob);
+    }
 };
 
 
@@ -228,6 +228,8 @@ SLANG_HIERARCHICAL_ENUM(ArtifactKind, SLANG_ARTIFACT_KIND, SLANG_ARTIFACT_KIND_E
                 x(PdbDebugInfo, DebugInfo) \
             x(Diagnostics, Metadata) \
             x(PostEmitMetadata, Metadata) \
+            x(ReflectionSnapshot, Metadata) \
+            x(IRPassTelemetry, Metadata) \
         x(Miscellaneous, Base) \
             x(Log, Miscellaneous) \
             x(Lock, Miscellaneous) \
@@ -650,6 +652,16 @@ static const KindExtension g_cpuKindExts[] = {
         return ArtifactDesc::make(ArtifactKind::Json, ArtifactPayload::SourceMap);
     }
 
+    if (slice == toSlice("slang-reflection"))
+    {
+        return ArtifactDesc::make(ArtifactKind::BinaryFormat, ArtifactPayload::ReflectionSnapshot);
+    }
+
+    if (slice == toSlice("slang-pass-telemetry"))
+    {
+        return ArtifactDesc::make(ArtifactKind::Json, ArtifactPayload::IRPassTelemetry);
+    }
+
     if (slice == toSlice("pdb"))
     {
         // Program database
@@ -738,6 +750,10 @@ static UnownedStringSlice _getPayloadExtension(ArtifactPayload payload)
         return toSlice("pdb");
     case Payload::SourceMap:
         return toSlice("map");
+    case Payload::ReflectionSnapshot:
+        return toSlice("slang-reflection");
+    case Payload::IRPassTelemetry:
+        return toSlice("slang-pass-telemetry");
 
     default:
         break;
@@ -838,6 +854,15 @@ SlangResult ArtifactDescUtil::appendDefaultExtension(const ArtifactDesc& desc, S
             out << "json";
             return SLANG_OK;
         }
+    case ArtifactKind::BinaryFormat:
+        {
+            if (desc.payload == Payload::ReflectionSnapshot)
+            {
+                out << _getPayloadExtension(desc.payload);
+                return SLANG_OK;
+            }
+            break;
+        }
     case ArtifactKind::CompileBinary:
         {
             if (isDerivedFrom(desc.payload, ArtifactPayload::SlangIR) ||
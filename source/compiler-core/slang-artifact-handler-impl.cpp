@@ -19,6 +19,23 @@ namespace Slang
 
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!! DefaultArtifactHandler !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
+// Write the contents of `blob` to the file at `path`. A segmented blob (such as large generated
+// source) is written a segment at a time, so its contents never have to be joined in memory.
+static SlangResult _writeBlob(const String& path, ISlangBlob* blob)
+{
+    auto castable = CastableUtil::getCastable(blob);
+    if (auto segmentedBlob = as<SegmentedBlob>(castable))
+    {
+        FileStream stream;
+        SLANG_RETURN_ON_FAIL(
+            stream.init(path, FileMode::Create, FileAccess::Write, FileShare::ReadWrite));
+        return segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice& segment)
+            { return stream.write(segment.begin(), segment.getLength()); });
+    }
+    return File::writeAllBytes(path, blob->getBufferPointer(), blob->getBufferSize());
+}
+
 /* static */ DefaultArtifactHandler DefaultArtifactHandler::g_singleton;
 
 SlangResult DefaultArtifactHandler::queryInterface(SlangUUID const& uuid, void** outObject)
@@ -302,8 +319,7 @@ SlangResult DefaultArtifactHandler::_createOSFile(
     const auto path = StringUtil::getSlice(pathBlob);
 
     // Write the contents
-    SLANG_RETURN_ON_FAIL(
-        File::writeAllBytes(path, blob->getBufferPointer(), blob->getBufferSize()));
+    SLANG_RETURN_ON_FAIL(_writeBlob(path, blob));
     if (artifact->getDesc().kind == ArtifactKind::Executable)
     {
         SLANG_RETURN_ON_FAIL(File::makeExecutable(path));
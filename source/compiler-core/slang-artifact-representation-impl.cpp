@@ -2,12 +2,25 @@
 #include "slang-artifact-representation-impl.h"
 
 #include "../core/slang-array-view.h"
+#include "../core/slang-blob.h"
 #include "../core/slang-castable.h"
 #include "../core/slang-file-system.h"
 #include "../core/slang-io.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-artifact-util.h"
 
+#if SLANG_LINUX_FAMILY
+#include <dlfcn.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_memfd_create)
+#define SLANG_HAS_MEMFD 1
+#ifndef MFD_CLOEXEC
+#define MFD_CLOEXEC 0x0001U
+#endif
+#endif
+#endif
+
 namespace Slang
 {
 
@@ -241,6 +254,123 @@ OSFileArtifactRepresentation::~OSFileArtifactRepresentation()
     }
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!! AnonymousFileArtifactRepresentation !!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */ bool AnonymousFileArtifactRepresentation::isSupported()
+{
+#if SLANG_HAS_MEMFD
+    return true;
+#else
+    return false;
+#endif
+}
+
+/* static */ SlangResult AnonymousFileArtifactRepresentation::create(
+    const char* name,
+    ComPtr<IOSFileArtifactRepresentation>& outRep)
+{
+#if SLANG_HAS_MEMFD
+    // The file is close-on-exec, so it doesn't leak into processes launched concurrently (such as
+    // other downstream compiles). The processes we launch to use it access it through our /proc
+    // entry instead, which is why the path names our process id rather than `self`.
+    const int fd = int(::syscall(SYS_memfd_create, name, MFD_CLOEXEC));
+    if (fd < 0)
+    {
+        // Typically because the kernel is too old to support memfd
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder path;
+    path << "/proc/" << ::getpid() << "/fd/" << fd;
+
+    outRep = new ThisType(fd, path.getUnownedSlice());
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(name);
+    SLANG_UNUSED(outRep);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+/* static */ SlangResult AnonymousFileArtifactRepresentation::create(
+    const char* name,
+    const void* data,
+    size_t size,
+    ComPtr<IOSFileArtifactRepresentation>& outRep)
+{
+    ComPtr<IOSFileArtifactRepresentation> rep;
+    SLANG_RETURN_ON_FAIL(create(name, rep));
+    SLANG_RETURN_ON_FAIL(static_cast<ThisType*>(rep.get())->_write(data, size));
+
+    outRep.swap(rep);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult AnonymousFileArtifactRepresentation::create(
+    const char* name,
+    const UnownedStringSlice& prefix,
+    ISlangBlob* blob,
+    ComPtr<IOSFileArtifactRepresentation>& outRep)
+{
+    ComPtr<IOSFileArtifactRepresentation> rep;
+    SLANG_RETURN_ON_FAIL(create(name, rep));
+    auto anonymousRep = static_cast<ThisType*>(rep.get());
+
+    SLANG_RETURN_ON_FAIL(anonymousRep->_write(prefix.begin(), size_t(prefix.getLength())));
+    if (auto segmentedBlob = as<SegmentedBlob>(CastableUtil::getCastable(blob)))
+    {
+        SLANG_RETURN_ON_FAIL(segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice& segment)
+            { return anonymousRep->_write(segment.begin(), size_t(segment.getLength())); }));
+    }
+    else
+    {
+        SLANG_RETURN_ON_FAIL(anonymousRep->_write(blob->getBufferPointer(), blob->getBufferSize()));
+    }
+
+    outRep.swap(rep);
+    return SLANG_OK;
+}
+
+SlangResult AnonymousFileArtifactRepresentation::_write(const void* data, size_t size)
+{
+#if SLANG_HAS_MEMFD
+    const char* cur = (const char*)data;
+    while (size > 0)
+    {
+        const auto written = ::write(m_fd, cur, size);
+        if (written <= 0)
+        {
+            return SLANG_FAIL;
+        }
+        cur += written;
+        size -= size_t(written);
+    }
+    return SLANG_OK;
+#else
+    SLANG_UNUSED(data);
+    SLANG_UNUSED(size);
+    return SLANG_E_NOT_AVAILABLE;
+#endif
+}
+
+AnonymousFileArtifactRepresentation::~AnonymousFileArtifactRepresentation()
+{
+#if SLANG_HAS_MEMFD
+    // The loader finds libraries that are already loaded by their path, and a library can stay
+    // loaded after it is unloaded (for example if it has unique symbols). If the descriptor was
+    // closed its number could be reused by another anonymous file, with the same path, and
+    // loading that would return the stale library. So while a library loaded from this file is
+    // resident, the descriptor is deliberately left open.
+    if (void* handle = ::dlopen(getPath(), RTLD_LAZY | RTLD_NOLOAD))
+    {
+        ::dlclose(handle);
+        return;
+    }
+    ::close(m_fd);
+#endif
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! PostEmitMetadataArtifactRepresentation !!!!!!!!!!!!!!!!!!!!!!!!!!!
  */
 
@@ -82,6 +82,53 @@ protected:
     ComPtr<ISlangMutableFileSystem> m_fileSystem;
 };
 
+/* A representation of an artifact held in an anonymous in-memory file (memfd on Linux).
+The path is of the form /proc/<pid>/fd/N, so the file can be used anywhere an OS path can, including
+by child processes (through this process's /proc entry, as the descriptor isn't inherited) and by
+the shared library loader, but nothing is ever written to the file system. The file is released
+when the representation goes out of scope, unless a library loaded from it is still resident. */
+class AnonymousFileArtifactRepresentation : public OSFileArtifactRepresentation
+{
+public:
+    typedef OSFileArtifactRepresentation Super;
+    typedef AnonymousFileArtifactRepresentation ThisType;
+
+    /// True if anonymous files can be created on this platform.
+    static bool isSupported();
+
+    /// Create an empty anonymous file. `name` is only used for debugging purposes.
+    /// Returns SLANG_E_NOT_AVAILABLE if anonymous files are not supported.
+    static SlangResult create(const char* name, ComPtr<IOSFileArtifactRepresentation>& outRep);
+
+    /// Create an anonymous file holding `size` bytes of `data`
+    static SlangResult create(
+        const char* name,
+        const void* data,
+        size_t size,
+        ComPtr<IOSFileArtifactRepresentation>& outRep);
+
+    /// Create an anonymous file holding `prefix` followed by the contents of `blob`. A
+    /// `SegmentedBlob` is written a segment at a time, so it is never joined in memory.
+    static SlangResult create(
+        const char* name,
+        const UnownedStringSlice& prefix,
+        ISlangBlob* blob,
+        ComPtr<IOSFileArtifactRepresentation>& outRep);
+
+    ~AnonymousFileArtifactRepresentation();
+
+protected:
+    /// Append `size` bytes of `data` to the file
+    SlangResult _write(const void* data, size_t size);
+
+    AnonymousFileArtifactRepresentation(int fd, const UnownedStringSlice& path)
+        : Super(Kind::Reference, path, nullptr), m_fd(fd)
+    {
+    }
+
+    int m_fd;
+};
+
 class ExtFileArtifactRepresentation : public ComBaseObject, public IExtFileArtifactRepresentation
 {
 public:
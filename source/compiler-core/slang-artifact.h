@@ -223,6 +223,10 @@ enum class ArtifactPayload : uint8_t
 
     PostEmitMetadata, ///< Metadata from post emit (binding information)
 
+    ReflectionSnapshot, ///< Reflection information in the format of slang-reflection-snapshot.h
+
+    IRPassTelemetry, ///< Time taken by, and IR size after, each pass of IR optimization
+
     CountOf,
 };
 
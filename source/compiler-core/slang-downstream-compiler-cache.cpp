@@ -0,0 +1,574 @@
+// slang-downstream-compiler-cache.cpp
+#include "slang-downstream-compiler-cache.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-char-util.h"
+#include "../core/slang-crypto.h"
+#include "../core/slang-io.h"
+#include "../core/slang-riff.h"
+#include "../core/slang-string-util.h"
+#include "slang-artifact-associated-impl.h"
+#include "slang-artifact-desc-util.h"
+#include "slang-artifact-util.h"
+#include "slang-slice-allocator.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+// Identifies the layout of the key, and of the entries. Bump if either changes, so that entries
+// written by a different version of Slang are never found.
+const uint32_t kCacheFormatVersion = 1;
+
+const FourCC kEntryFourCC = SLANG_FOUR_CC('S', 'D', 'C', 'E');
+
+struct KeyBuilder
+{
+    template<typename T>
+    void appendValue(const T& value)
+    {
+        m_builder.append(value);
+    }
+
+    /// Strings are length prefixed, so that adjacent strings can't alias.
+    void appendString(const UnownedStringSlice& slice)
+    {
+        m_builder.append(uint64_t(slice.getLength()));
+        m_builder.append(slice);
+    }
+    void appendString(const CharSlice& slice) { appendString(asStringSlice(slice)); }
+
+    void appendBlob(ISlangBlob* blob)
+    {
+        m_builder.append(uint64_t(blob->getBufferSize()));
+        m_builder.append(blob);
+    }
+
+    void appendVersion(const SemanticVersion& version)
+    {
+        m_builder.append(version.m_major);
+        m_builder.append(version.m_minor);
+        m_builder.append(version.m_patch);
+    }
+
+    KeyBuilder(DigestBuilder<CacheKeyHash>& builder)
+        : m_builder(builder)
+    {
+    }
+
+    DigestBuilder<CacheKeyHash>& m_builder;
+};
+
+/* Finds the headers included by a source, and adds their contents to the key.
+
+This is not a preprocessor - it doesn't evaluate conditionals, so it may add headers that are not
+actually used by the compilation. That is conservative, in that it can only cause misses, not
+incorrect hits. */
+struct IncludeScanner
+{
+    void scan(const String& sourcePath, ISlangBlob* blob)
+    {
+        const UnownedStringSlice text(
+            (const char*)blob->getBufferPointer(),
+            blob->getBufferSize());
+
+        const String sourceDir = sourcePath.getLength() ? Path::getParentDirectory(sourcePath)
+                                                        : String();
+
+        List<UnownedStringSlice> lines;
+        StringUtil::calcLines(text, lines);
+
+        for (auto line : lines)
+        {
+            line = line.trim();
+            if (!line.startsWith(toSlice("#")))
+            {
+                continue;
+            }
+            line = UnownedStringSlice(line.begin() + 1, line.end()).trim();
+            if (!line.startsWith(toSlice("include")))
+            {
+                continue;
+            }
+            line = UnownedStringSlice(line.begin() + 7, line.end()).trim();
+            if (line.getLength() < 2)
+            {
+                continue;
+            }
+
+            const char open = line[0];
+            const char close = (open == '<') ? '>' : '"';
+            if (open != '<' && open != '"')
+            {
+                continue;
+            }
+            const UnownedStringSlice rest = line.tail(1);
+            const Index closeIndex = rest.indexOf(close);
+            if (closeIndex < 0)
+            {
+                continue;
+            }
+
+            const String name(rest.head(closeIndex));
+
+            m_keyBuilder->appendValue(uint8_t(open));
+            m_keyBuilder->appendString(name.getUnownedSlice());
+
+            String foundPath;
+            ComPtr<ISlangBlob> foundBlob;
+            if (Path::isAbsolute(name))
+            {
+                _tryLoad(name, foundPath, foundBlob);
+            }
+            else
+            {
+                // Quoted includes are searched for relative to the including file first
+                if (open == '"' && sourceDir.getLength())
+                {
+                    _tryLoad(Path::combine(sourceDir, name), foundPath, foundBlob);
+                }
+                for (Index i = 0; !foundBlob && i < m_includePaths.getCount(); ++i)
+                {
+                    _tryLoad(Path::combine(m_includePaths[i], name), foundPath, foundBlob);
+                }
+            }
+
+            if (!foundBlob)
+            {
+                // Not found, so presumably a system header, which we assume only changes along
+                // with the compiler.
+                m_keyBuilder->appendValue(uint8_t(0));
+                continue;
+            }
+
+            m_keyBuilder->appendValue(uint8_t(1));
+            m_keyBuilder->appendBlob(foundBlob);
+
+            // Only scan each header once. This also stops include cycles.
+            if (m_scannedPaths.add(foundPath))
+            {
+                scan(foundPath, foundBlob);
+            }
+        }
+    }
+
+    void _tryLoad(const String& path, String& outPath, ComPtr<ISlangBlob>& outBlob)
+    {
+        if (m_fileSystem)
+        {
+            if (SLANG_FAILED(m_fileSystem->loadFile(path.getBuffer(), outBlob.writeRef())))
+            {
+                outBlob.setNull();
+                return;
+            }
+        }
+        else
+        {
+            ScopedAllocation contents;
+            if (!File::exists(path) || SLANG_FAILED(File::readAllBytes(path, contents)))
+            {
+                return;
+            }
+            outBlob = RawBlob::moveCreate(contents);
+        }
+        outPath = path;
+    }
+
+    IncludeScanner(
+        KeyBuilder* keyBuilder,
+        ISlangFileSystemExt* fileSystem,
+        const Slice<TerminatedCharSlice>& includePaths)
+        : m_keyBuilder(keyBuilder), m_fileSystem(fileSystem)
+    {
+        for (const auto& includePath : includePaths)
+        {
+            m_includePaths.add(asString(includePath));
+        }
+    }
+
+    KeyBuilder* m_keyBuilder;
+    ISlangFileSystemExt* m_fileSystem;
+    List<String> m_includePaths;
+    HashSet<String> m_scannedPaths;
+};
+
+struct EntryWriter
+{
+    template<typename T>
+    void write(const T& value)
+    {
+        m_data.addRange((const uint8_t*)&value, sizeof(T));
+    }
+    void writeString(const UnownedStringSlice& slice)
+    {
+        write(uint32_t(slice.getLength()));
+        m_data.addRange((const uint8_t*)slice.begin(), slice.getLength());
+    }
+
+    List<uint8_t> m_data;
+};
+
+struct EntryReader
+{
+    template<typename T>
+    SlangResult read(T& out)
+    {
+        SLANG_RETURN_ON_FAIL(_check(sizeof(T)));
+        ::memcpy(&out, m_cur, sizeof(T));
+        m_cur += sizeof(T);
+        return SLANG_OK;
+    }
+    SlangResult readString(UnownedStringSlice& out)
+    {
+        uint32_t length;
+        SLANG_RETURN_ON_FAIL(read(length));
+        SLANG_RETURN_ON_FAIL(_check(length));
+        out = UnownedStringSlice((const char*)m_cur, length);
+        m_cur += length;
+        return SLANG_OK;
+    }
+
+    SlangResult _check(size_t size) const
+    {
+        return (size_t(m_end - m_cur) >= size) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    EntryReader(ISlangBlob* blob)
+        : m_cur((const uint8_t*)blob->getBufferPointer())
+        , m_end((const uint8_t*)blob->getBufferPointer() + blob->getBufferSize())
+    {
+    }
+
+    const uint8_t* m_cur;
+    const uint8_t* m_end;
+};
+
+} // namespace
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! DownstreamCompilerCacheUtil !!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+/* static */ SlangResult DownstreamCompilerCacheUtil::writeEntry(
+    IArtifact* artifact,
+    ComPtr<ISlangBlob>& outEntry)
+{
+    const auto desc = artifact->getDesc();
+    if (isDerivedFrom(desc.kind, ArtifactKind::Executable))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    ComPtr<ISlangBlob> productBlob;
+    SLANG_RETURN_ON_FAIL(artifact->loadBlob(ArtifactKeep::No, productBlob.writeRef()));
+
+    EntryWriter writer;
+    writer.write(kEntryFourCC);
+    writer.write(kCacheFormatVersion);
+    writer.write(uint32_t(desc.getPacked()));
+
+    if (auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact))
+    {
+        writer.write(uint8_t(1));
+        writer.write(int32_t(diagnostics->getResult()));
+        writer.writeString(asStringSlice(diagnostics->getRaw()));
+
+        const Count count = diagnostics->getCount();
+        writer.write(uint32_t(count));
+        for (Index i = 0; i < count; ++i)
+        {
+            const auto& diagnostic = *diagnostics->getAt(i);
+            writer.write(uint8_t(diagnostic.severity));
+            writer.write(uint8_t(diagnostic.stage));
+            writer.writeString(asStringSlice(diagnostic.text));
+            writer.writeString(asStringSlice(diagnostic.code));
+            writer.writeString(asStringSlice(diagnostic.filePath));
+            writer.write(int64_t(diagnostic.location.line));
+            writer.write(int64_t(diagnostic.location.column));
+        }
+    }
+    else
+    {
+        writer.write(uint8_t(0));
+    }
+
+    writer.write(uint64_t(productBlob->getBufferSize()));
+    writer.m_data.addRange(
+        (const uint8_t*)productBlob->getBufferPointer(),
+        Count(productBlob->getBufferSize()));
+
+    outEntry = ListBlob::moveCreate(writer.m_data);
+    return SLANG_OK;
+}
+
+/* static */ SlangResult DownstreamCompilerCacheUtil::readEntry(
+    ISlangBlob* entry,
+    ComPtr<IArtifact>& outArtifact)
+{
+    EntryReader reader(entry);
+
+    FourCC fourCC;
+    uint32_t formatVersion;
+    uint32_t packedDesc;
+    SLANG_RETURN_ON_FAIL(reader.read(fourCC));
+    SLANG_RETURN_ON_FAIL(reader.read(formatVersion));
+    if (fourCC != kEntryFourCC || formatVersion != kCacheFormatVersion)
+    {
+        return SLANG_FAIL;
+    }
+    SLANG_RETURN_ON_FAIL(reader.read(packedDesc));
+
+    auto artifact =
+        ArtifactUtil::createArtifact(ArtifactDesc::make(ArtifactDesc::Packed(packedDesc)));
+
+    uint8_t hasDiagnostics;
+    SLANG_RETURN_ON_FAIL(reader.read(hasDiagnostics));
+    if (hasDiagnostics)
+    {
+        auto diagnostics = ArtifactDiagnostics::create();
+
+        int32_t result;
+        UnownedStringSlice raw;
+        uint32_t count;
+        SLANG_RETURN_ON_FAIL(reader.read(result));
+        SLANG_RETURN_ON_FAIL(reader.readString(raw));
+        SLANG_RETURN_ON_FAIL(reader.read(count));
+
+        diagnostics->setResult(SlangResult(result));
+        diagnostics->setRaw(asCharSlice(raw));
+
+        // The diagnostic slices are only used for the duration of `add`, which copies them
+        List<String> strings;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            uint8_t severity, stage;
+            UnownedStringSlice text, code, filePath;
+            int64_t line, column;
+
+            SLANG_RETURN_ON_FAIL(reader.read(severity));
+            SLANG_RETURN_ON_FAIL(reader.read(stage));
+            SLANG_RETURN_ON_FAIL(reader.readString(text));
+            SLANG_RETURN_ON_FAIL(reader.readString(code));
+            SLANG_RETURN_ON_FAIL(reader.readString(filePath));
+            SLANG_RETURN_ON_FAIL(reader.read(line));
+            SLANG_RETURN_ON_FAIL(reader.read(column));
+
+            if (severity >= uint8_t(ArtifactDiagnostic::Severity::CountOf))
+            {
+                return SLANG_FAIL;
+            }
+
+            // TerminatedCharSlice requires zero termination, which the entry doesn't have.
+            const String textString(text), codeString(code), filePathString(filePath);
+
+            ArtifactDiagnostic diagnostic;
+            diagnostic.severity = ArtifactDiagnostic::Severity(severity);
+            diagnostic.stage = ArtifactDiagnostic::Stage(stage);
+            diagnostic.text = SliceUtil::asTerminatedCharSlice(textString);
+            diagnostic.code = SliceUtil::asTerminatedCharSlice(codeString);
+            diagnostic.filePath = SliceUtil::asTerminatedCharSlice(filePathString);
+            diagnostic.location.line = Int(line);
+            diagnostic.location.column = Int(column);
+
+            diagnostics->add(diagnostic);
+        }
+
+        ArtifactUtil::addAssociated(artifact, diagnostics);
+    }
+
+    uint64_t productSize;
+    SLANG_RETURN_ON_FAIL(reader.read(productSize));
+    SLANG_RETURN_ON_FAIL(reader._check(size_t(productSize)));
+
+    artifact->addRepresentationUnknown(RawBlob::create(reader.m_cur, size_t(productSize)));
+
+    outArtifact = artifact;
+    return SLANG_OK;
+}
+
+/* static */ void DownstreamCompilerCacheUtil::appendSourceWithIncludes(
+    DigestBuilder<CacheKeyHash>& builder,
+    const String& path,
+    ISlangBlob* blob,
+    const Slice<TerminatedCharSlice>& includePaths,
+    ISlangFileSystemExt* fileSystem)
+{
+    KeyBuilder keyBuilder(builder);
+    keyBuilder.appendBlob(blob);
+
+    IncludeScanner scanner(&keyBuilder, fileSystem, includePaths);
+    scanner.scan(path, blob);
+}
+
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!! CachingDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+/* static */ SlangResult CachingDownstreamCompiler::calcKey(
+    IDownstreamCompiler* compiler,
+    const CompileOptions& inOptions,
+    PersistentCache::Key& outKey)
+{
+    const CompileOptions options = getCompatibleVersion(&inOptions);
+
+    DigestBuilder<CacheKeyHash> digestBuilder;
+    KeyBuilder builder(digestBuilder);
+
+    builder.appendString(toSlice("slang-downstream-compiler-cache"));
+    builder.appendValue(kCacheFormatVersion);
+
+    // The compiler
+    {
+        const auto& desc = compiler->getDesc();
+        builder.appendValue(desc.type);
+        builder.appendVersion(desc.version);
+
+        ComPtr<ISlangBlob> versionString;
+        if (SLANG_SUCCEEDED(compiler->getVersionString(versionString.writeRef())) && versionString)
+        {
+            builder.appendBlob(versionString);
+        }
+        else
+        {
+            builder.appendValue(uint64_t(0));
+        }
+    }
+
+    // The options
+    builder.appendValue(options.optimizationLevel);
+    builder.appendValue(options.debugInfoType);
+    builder.appendValue(options.targetType);
+    builder.appendValue(options.sourceLanguage);
+    builder.appendValue(options.floatingPointMode);
+    builder.appendValue(options.pipelineType);
+    builder.appendValue(options.matrixLayout);
+    builder.appendValue(options.flags);
+    builder.appendValue(options.platform);
+    builder.appendValue(options.stage);
+    builder.appendValue(options.m_debugInfoFormat);
+
+    builder.appendString(options.modulePath);
+    builder.appendString(options.entryPointName);
+    builder.appendString(options.profileName);
+
+    builder.appendValue(uint64_t(options.defines.count));
+    for (const auto& define : options.defines)
+    {
+        builder.appendString(define.nameWithSig);
+        builder.appendString(define.value);
+    }
+
+    builder.appendValue(uint64_t(options.requiredCapabilityVersions.count));
+    for (const auto& capabilityVersion : options.requiredCapabilityVersions)
+    {
+        builder.appendValue(capabilityVersion.kind);
+        builder.appendVersion(capabilityVersion.version);
+    }
+
+    for (const auto& slices :
+         {options.includePaths, options.libraryPaths, options.compilerSpecificArguments})
+    {
+        builder.appendValue(uint64_t(slices.count));
+        for (const auto& slice : slices)
+        {
+            builder.appendString(slice);
+        }
+    }
+
+    // The sources, and the headers they include
+    {
+        IncludeScanner scanner(&builder, options.fileSystemExt, options.includePaths);
+
+        builder.appendValue(uint64_t(options.sourceArtifacts.count));
+        for (auto sourceArtifact : options.sourceArtifacts)
+        {
+            ComPtr<ISlangBlob> blob;
+            if (SLANG_FAILED(sourceArtifact->loadBlob(ArtifactKeep::No, blob.writeRef())))
+            {
+                return SLANG_E_NOT_AVAILABLE;
+            }
+
+            builder.appendValue(uint32_t(sourceArtifact->getDesc().getPacked()));
+            // The name is used in diagnostics and debug info, so is part of the key. The path may
+            // be a temporary, so it is only used to find includes.
+            builder.appendString(UnownedStringSlice(sourceArtifact->getName()));
+            builder.appendBlob(blob);
+
+            scanner.scan(ArtifactUtil::findPath(sourceArtifact), blob);
+        }
+    }
+
+    // The libraries
+    builder.appendValue(uint64_t(options.libraries.count));
+    for (auto library : options.libraries)
+    {
+        ComPtr<ISlangBlob> blob;
+        if (SLANG_FAILED(library->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+        builder.appendValue(uint32_t(library->getDesc().getPacked()));
+        builder.appendString(UnownedStringSlice(library->getName()));
+        builder.appendBlob(blob);
+    }
+
+    // The inputs are hashed with the fast hash, as they include all of the source. Its digest is
+    // then hashed again to get a key of the size the persistent cache uses.
+    const auto digest = digestBuilder.finalize();
+    outKey = SHA1::compute(digest.data, sizeof(digest.data));
+    return SLANG_OK;
+}
+
+SlangResult CachingDownstreamCompiler::compile(
+    const CompileOptions& options,
+    IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(options))
+    {
+        // Not possible to compile with this version of the interface.
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    PersistentCache::Key key;
+    if (SLANG_FAILED(calcKey(m_inner, options, key)))
+    {
+        return m_inner->compile(options, outArtifact);
+    }
+
+    // Try the cache. A corrupt or stale entry is treated as a miss and overwritten below.
+    {
+        ComPtr<ISlangBlob> entry;
+        ComPtr<IArtifact> artifact;
+        if (SLANG_SUCCEEDED(m_cache->readEntry(key, entry.writeRef())) &&
+            SLANG_SUCCEEDED(DownstreamCompilerCacheUtil::readEntry(entry, artifact)))
+        {
+            *outArtifact = artifact.detach();
+            return SLANG_OK;
+        }
+    }
+
+    ComPtr<IArtifact> artifact;
+    SLANG_RETURN_ON_FAIL(m_inner->compile(options, artifact.writeRef()));
+
+    // Only store successful compilations. Failures are cheap to reproduce, and may be due to
+    // something outside of the key (such as a missing license or a transient file system error).
+    auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
+    const bool succeeded =
+        artifact->exists() &&
+        (diagnostics == nullptr ||
+         (SLANG_SUCCEEDED(diagnostics->getResult()) &&
+          !diagnostics->hasOfAtLeastSeverity(ArtifactDiagnostic::Severity::Error)));
+
+    if (succeeded)
+    {
+        ComPtr<ISlangBlob> entry;
+        if (SLANG_SUCCEEDED(DownstreamCompilerCacheUtil::writeEntry(artifact, entry)))
+        {
+            // Failing to write to the cache doesn't fail the compilation
+            m_cache->writeEntry(key, entry);
+        }
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
+} // namespace Slang
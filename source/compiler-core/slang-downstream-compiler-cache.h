@@ -0,0 +1,119 @@
+// slang-downstream-compiler-cache.h
+#ifndef SLANG_DOWNSTREAM_COMPILER_CACHE_H
+#define SLANG_DOWNSTREAM_COMPILER_CACHE_H
+
+#include "../core/slang-persistent-cache.h"
+#include "slang-downstream-compiler.h"
+
+namespace Slang
+{
+
+/* A downstream compiler that sits in front of another compiler and memoizes the results of
+`compile` in a `PersistentCache`, in the style of ccache.
+
+The cache key is a digest of
+
+* The desc and version string of the wrapped compiler
+* All of the `CompileOptions` that can influence the output
+* The contents of the source artifacts, and of any header they (transitively) `#include` that can be
+  found relative to the source or on the include paths. Headers are loaded through the options
+  `fileSystemExt` if one is set, so the key sees the same files as the compiler. Headers that
+  cannot be found (typically system headers) contribute only their name.
+* The contents of the library artifacts
+
+Only successful compilations whose product can be represented as a blob are stored. An entry holds
+the product and its diagnostics, so that warnings are reproduced on a cache hit. Compilations that
+cannot be keyed reliably (for example if a source or library cannot be loaded as a blob) go straight
+to the wrapped compiler. Executables are never stored, as the file recreated from a blob would not
+be executable.
+
+All other methods forward to the wrapped compiler. */
+class CachingDownstreamCompiler : public DownstreamCompilerBase
+{
+public:
+    typedef DownstreamCompilerBase Super;
+
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW bool SLANG_MCALL
+    canConvert(const ArtifactDesc& from, const ArtifactDesc& to) SLANG_OVERRIDE
+    {
+        return m_inner->canConvert(from, to);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    convert(IArtifact* from, const ArtifactDesc& to, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        return m_inner->convert(from, to, outArtifact);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL getVersionString(slang::IBlob** outVersionString)
+        SLANG_OVERRIDE
+    {
+        return m_inner->getVersionString(outVersionString);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    validate(const uint32_t* contents, int contentsSize) SLANG_OVERRIDE
+    {
+        return m_inner->validate(contents, contentsSize);
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    disassemble(const uint32_t* contents, int contentsSize) SLANG_OVERRIDE
+    {
+        return m_inner->disassemble(contents, contentsSize);
+    }
+    virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE
+    {
+        return m_inner->isFileBased();
+    }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL link(
+        const uint32_t* const* modules,
+        const size_t* moduleSizes,
+        size_t moduleCount,
+        IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        return m_inner->link(modules, moduleSizes, moduleCount, outArtifact);
+    }
+
+    /// Calculate the cache key for compiling `options` with `compiler`.
+    /// Returns SLANG_E_NOT_AVAILABLE if the compilation cannot be reliably keyed.
+    static SlangResult calcKey(
+        IDownstreamCompiler* compiler,
+        const CompileOptions& options,
+        PersistentCache::Key& outKey);
+
+    /// Get the wrapped compiler
+    IDownstreamCompiler* getInner() const { return m_inner; }
+    /// Get the cache results are stored in
+    PersistentCache* getCache() const { return m_cache; }
+
+    CachingDownstreamCompiler(IDownstreamCompiler* inner, PersistentCache* cache)
+        : Super(inner->getDesc()), m_inner(inner), m_cache(cache)
+    {
+    }
+
+protected:
+    ComPtr<IDownstreamCompiler> m_inner;
+    RefPtr<PersistentCache> m_cache;
+};
+
+struct DownstreamCompilerCacheUtil
+{
+    /// Serialize the product blob and diagnostics of a successful compilation into a cache entry
+    static SlangResult writeEntry(IArtifact* artifact, ComPtr<ISlangBlob>& outEntry);
+    /// Recreate an artifact from a cache entry produced by `writeEntry`
+    static SlangResult readEntry(ISlangBlob* entry, ComPtr<IArtifact>& outArtifact);
+
+    /// Append the contents of `blob`, and of the headers it (transitively) `#include`s, to
+    /// `builder`. Headers are searched for relative to `path` and then on `includePaths`, and are
+    /// loaded through `fileSystem` if it is set.
+    static void appendSourceWithIncludes(
+        DigestBuilder<CacheKeyHash>& builder,
+        const String& path,
+        ISlangBlob* blob,
+        const Slice<TerminatedCharSlice>& includePaths,
+        ISlangFileSystemExt* fileSystem);
+};
+
+} // namespace Slang
+
+#endif
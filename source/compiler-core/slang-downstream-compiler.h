@@ -274,6 +274,13 @@ struct DownstreamCompileOptions
 
     // The debug info format to use.
     SlangDebugInfoFormat m_debugInfoFormat = SLANG_DEBUG_INFO_FORMAT_DEFAULT;
+
+    /// Text that the source artifacts may start with, such as a prelude. A compiler that supports
+    /// it may compile this text once into a precompiled header, and reuse it for every source
+    /// that starts with it.
+    TerminatedCharSlice precompiledHeaderText;
+    /// Directory precompiled headers are stored in. If not set no precompiled header is used.
+    TerminatedCharSlice precompiledHeaderDirectory;
 };
 static_assert(std::is_trivially_copyable_v<DownstreamCompileOptions>);
 
@@ -343,6 +350,15 @@ public:
 
     /// True if underlying compiler uses file system to communicate source
     virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() = 0;
+
+    /// Link `moduleCount` binary modules (such as SPIR-V) into a single artifact,
+    /// resolving the imports of each module against the exports of the others.
+    /// `moduleSizes` holds the size of each module in 32-bit words.
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL link(
+        const uint32_t* const* modules,
+        const size_t* moduleSizes,
+        size_t moduleCount,
+        IArtifact** outArtifact) = 0;
 };
 
 class DownstreamCompilerBase : public ComBaseObject, public IDownstreamCompiler
@@ -384,6 +400,18 @@ public:
         SLANG_UNUSED(contentsSize);
         return SLANG_FAIL;
     }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL link(
+        const uint32_t* const* modules,
+        const size_t* moduleSizes,
+        size_t moduleCount,
+        IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(modules);
+        SLANG_UNUSED(moduleSizes);
+        SLANG_UNUSED(moduleCount);
+        SLANG_UNUSED(outArtifact);
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
 
     DownstreamCompilerBase(const Desc& desc)
         : m_desc(desc)
@@ -1,17 +1,28 @@
 // slang-gcc-compiler-util.cpp
 #include "slang-gcc-compiler-util.h"
 
+#include "../core/slang-blob.h"
+#include "../core/slang-castable.h"
 #include "../core/slang-char-util.h"
 #include "../core/slang-common.h"
+#include "../core/slang-crypto.h"
 #include "../core/slang-io.h"
+#include "../core/slang-process.h"
 #include "../core/slang-shared-library.h"
+#include "../core/slang-string-escape-util.h"
 #include "../core/slang-string-slice-pool.h"
 #include "../core/slang-string-util.h"
+#include "slang-artifact-associated-impl.h"
 #include "slang-artifact-desc-util.h"
 #include "slang-artifact-diagnostic-util.h"
 #include "slang-artifact-representation-impl.h"
 #include "slang-artifact-util.h"
 #include "slang-com-helper.h"
+#include "slang-downstream-compiler-cache.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdio.h>
 
 namespace Slang
 {
@@ -487,12 +498,10 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
-/* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
+/* static */ SlangResult GCCDownstreamCompilerUtil::calcCompileFlagArgs(
     const CompileOptions& options,
     CommandLine& cmdLine)
 {
-    SLANG_ASSERT(options.modulePath.count);
-
     PlatformKind platformKind = (options.platform == PlatformKind::Unknown)
                                     ? PlatformUtil::getPlatformKind()
                                     : options.platform;
@@ -563,11 +572,6 @@ static SlangResult _parseGCCFamilyLine(
         cmdLine.addArg("-g");
     }
 
-    if (options.flags & CompileOptions::Flag::Verbose)
-    {
-        cmdLine.addArg("-v");
-    }
-
     switch (options.floatingPointMode)
     {
     case FloatingPointMode::Default:
@@ -587,23 +591,11 @@ static SlangResult _parseGCCFamilyLine(
         }
     }
 
-    StringBuilder moduleFilePath;
-    SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(
-        targetDesc,
-        asStringSlice(options.modulePath),
-        moduleFilePath));
-
-    cmdLine.addArg("-o");
-    cmdLine.addArg(moduleFilePath);
-
     switch (options.targetType)
     {
     case SLANG_SHADER_SHARED_LIBRARY:
     case SLANG_HOST_SHARED_LIBRARY:
         {
-            // Shared library
-            cmdLine.addArg("-shared");
-
             if (PlatformUtil::isFamily(PlatformFamily::Unix, platformKind))
             {
                 // Position independent
@@ -611,17 +603,6 @@ static SlangResult _parseGCCFamilyLine(
             }
             break;
         }
-    case SLANG_HOST_EXECUTABLE:
-        {
-            cmdLine.addArg("-rdynamic");
-            break;
-        }
-    case SLANG_OBJECT_CODE:
-        {
-            // Don't link, just produce object file
-            cmdLine.addArg("-c");
-            break;
-        }
     default:
         break;
     }
@@ -648,6 +629,69 @@ static SlangResult _parseGCCFamilyLine(
         cmdLine.addArg(asString(include));
     }
 
+    return SLANG_OK;
+}
+
+/* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
+    const CompileOptions& options,
+    CommandLine& cmdLine)
+{
+    SLANG_ASSERT(options.modulePath.count);
+
+    const auto targetDesc = ArtifactDescUtil::makeDescForCompileTarget(options.targetType);
+
+    StringBuilder moduleFilePath;
+    SLANG_RETURN_ON_FAIL(ArtifactDescUtil::calcPathForDesc(
+        targetDesc,
+        asStringSlice(options.modulePath),
+        moduleFilePath));
+
+    return calcArgs(options, moduleFilePath.getUnownedSlice(), cmdLine);
+}
+
+/* static */ SlangResult GCCDownstreamCompilerUtil::calcArgs(
+    const CompileOptions& options,
+    const UnownedStringSlice& outputPath,
+    CommandLine& cmdLine)
+{
+    PlatformKind platformKind = (options.platform == PlatformKind::Unknown)
+                                    ? PlatformUtil::getPlatformKind()
+                                    : options.platform;
+
+    SLANG_RETURN_ON_FAIL(calcCompileFlagArgs(options, cmdLine));
+
+    if (options.flags & CompileOptions::Flag::Verbose)
+    {
+        cmdLine.addArg("-v");
+    }
+
+    cmdLine.addArg("-o");
+    cmdLine.addArg(outputPath);
+
+    switch (options.targetType)
+    {
+    case SLANG_SHADER_SHARED_LIBRARY:
+    case SLANG_HOST_SHARED_LIBRARY:
+        {
+            // Shared library
+            cmdLine.addArg("-shared");
+            break;
+        }
+    case SLANG_HOST_EXECUTABLE:
+        {
+            cmdLine.addArg("-rdynamic");
+            break;
+        }
+    case SLANG_OBJECT_CODE:
+        {
+            // Don't link, just produce object file
+            cmdLine.addArg("-c");
+            break;
+        }
+    default:
+        break;
+    }
+
     // Link options
     if (0) // && options.targetType != TargetType::Object)
     {
@@ -668,6 +712,7 @@ static SlangResult _parseGCCFamilyLine(
     }
 
     // Files to compile, need to be on the file system.
+    bool hasLanguageArg = false;
     for (IArtifact* sourceArtifact : options.sourceArtifacts)
     {
         ComPtr<IOSFileArtifactRepresentation> fileRep;
@@ -675,7 +720,40 @@ static SlangResult _parseGCCFamilyLine(
         // TODO(JS):
         // Do we want to keep the file on the file system? It's probably reasonable to do so.
         SLANG_RETURN_ON_FAIL(sourceArtifact->requireFile(ArtifactKeep::Yes, fileRep.writeRef()));
-        cmdLine.addArg(fileRep->getPath());
+
+        const UnownedStringSlice path(fileRep->getPath());
+
+        // The compiler infers the language from the extension. Without one (as is the case for
+        // anonymous files) it would be treated as linker input, so the language has to be given.
+        if (!hasLanguageArg && Path::getPathExt(path).getLength() == 0)
+        {
+            const char* language = nullptr;
+            switch (options.sourceLanguage)
+            {
+            case SLANG_SOURCE_LANGUAGE_C:
+                language = "c";
+                break;
+            case SLANG_SOURCE_LANGUAGE_CPP:
+                language = "c++";
+                break;
+            default:
+                break;
+            }
+            if (language)
+            {
+                cmdLine.addArg("-x");
+                cmdLine.addArg(language);
+                hasLanguageArg = true;
+            }
+        }
+
+        cmdLine.addArg(path);
+    }
+    if (hasLanguageArg)
+    {
+        // Go back to inferring from the extension for anything that follows
+        cmdLine.addArg("-x");
+        cmdLine.addArg("none");
     }
 
     // Add the library paths
@@ -745,6 +823,247 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
+/* static */ SlangResult GCCDownstreamCompilerUtil::stripPrecompiledHeaderText(
+    const CompileOptions& options,
+    List<ComPtr<IArtifact>>& outSourceArtifacts)
+{
+    const UnownedStringSlice headerText = asStringSlice(options.precompiledHeaderText);
+    if (headerText.getLength() == 0 || options.sourceArtifacts.count == 0)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The #line directive puts the remainder of the source on the line it was on originally, so
+    // diagnostics are unchanged.
+    Index lineNumber = 1;
+    for (const char c : headerText)
+    {
+        lineNumber += Index(c == '\n');
+    }
+
+    for (IArtifact* sourceArtifact : options.sourceArtifacts)
+    {
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::No, blob.writeRef()));
+
+        StringBuilder lineDirective;
+        lineDirective << "#line " << lineNumber << "\n";
+
+        // Generated source is segmented, and the stripped source can share its segments rather
+        // than joining and copying them.
+        ComPtr<ISlangBlob> strippedBlob;
+        if (auto segmentedBlob = as<SegmentedBlob>(CastableUtil::getCastable(blob)))
+        {
+            if (!segmentedBlob->startsWith(headerText))
+            {
+                return SLANG_E_NOT_AVAILABLE;
+            }
+            strippedBlob = segmentedBlob->createTail(
+                lineDirective.getUnownedSlice(),
+                size_t(headerText.getLength()));
+        }
+        else
+        {
+            const UnownedStringSlice text = StringUtil::getSlice(blob);
+            if (!text.startsWith(headerText))
+            {
+                return SLANG_E_NOT_AVAILABLE;
+            }
+            lineDirective << text.tail(headerText.getLength());
+            strippedBlob = StringBlob::moveCreate(lineDirective);
+        }
+
+        auto strippedArtifact = ArtifactUtil::createArtifact(sourceArtifact->getDesc());
+        strippedArtifact->setName(sourceArtifact->getName());
+        strippedArtifact->addRepresentationUnknown(strippedBlob);
+
+        outSourceArtifacts.add(strippedArtifact);
+    }
+    return SLANG_OK;
+}
+
+// Remove the least recently used precompiled headers from `directory`, keeping at most
+// `kMaxPrecompiledHeaderCount`. A precompiled header's modification time is updated whenever it
+// is used, so the oldest are those unused for longest.
+// Another process may be about to use a header it has just found, so only headers that haven't
+// been used for `kMinUnusedSeconds` are removed. If one is removed anyway, the compile that
+// wanted it falls back to compiling without it.
+static void _evictPrecompiledHeaders(const String& directory)
+{
+    struct Visitor : Path::Visitor
+    {
+        void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+        {
+            if (type == Path::Type::File && fileName.startsWith(toSlice("slang-pch-")) &&
+                fileName.endsWith(toSlice(".h.gch")))
+            {
+                fileNames.add(fileName);
+            }
+        }
+        List<String> fileNames;
+    };
+    Visitor visitor;
+    Path::find(directory, nullptr, &visitor);
+
+    const Index kMaxPrecompiledHeaderCount = 16;
+    if (visitor.fileNames.getCount() <= kMaxPrecompiledHeaderCount)
+    {
+        return;
+    }
+
+    struct Entry
+    {
+        String path;
+        uint64_t modifiedTime;
+    };
+    List<Entry> entries;
+    for (const auto& fileName : visitor.fileNames)
+    {
+        Entry entry;
+        entry.path = Path::combine(directory, fileName);
+        FileStamp stamp;
+        entry.modifiedTime = SLANG_SUCCEEDED(File::getStamp(entry.path, stamp)) ? stamp.modifiedTime
+                                                                                : 0;
+        entries.add(entry);
+    }
+    entries.sort([](const Entry& a, const Entry& b) { return a.modifiedTime > b.modifiedTime; });
+
+    const uint64_t kMinUnusedSeconds = 60 * 60;
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const uint64_t nowNanoseconds =
+        uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+
+    for (Index i = kMaxPrecompiledHeaderCount; i < entries.getCount(); ++i)
+    {
+        if (entries[i].modifiedTime + kMinUnusedSeconds * 1000000000 > nowNanoseconds)
+        {
+            continue;
+        }
+        // The precompiled header goes first, as a compile that finds only the header can still
+        // use it.
+        File::remove(entries[i].path);
+        File::remove(Path::getPathWithoutExt(entries[i].path));
+    }
+}
+
+/* static */ SlangResult GCCDownstreamCompilerUtil::calcPrecompiledHeader(
+    const CommandLine& cmdLine,
+    const DownstreamCompilerDesc& desc,
+    const CompileOptions& options,
+    String& outHeaderPath)
+{
+    if (options.precompiledHeaderText.count == 0 ||
+        options.precompiledHeaderDirectory.count == 0 ||
+        options.sourceLanguage != SLANG_SOURCE_LANGUAGE_CPP)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // The flags used to build the precompiled header, which must match those used by the
+    // compilations that use it.
+    CommandLine flagsCmdLine;
+    SLANG_RETURN_ON_FAIL(calcCompileFlagArgs(options, flagsCmdLine));
+    for (auto compilerSpecificArg : options.compilerSpecificArguments)
+    {
+        flagsCmdLine.addArg(asString(compilerSpecificArg));
+    }
+
+    // The name is a digest of the compiler, the flags, and the header text along with anything
+    // it includes. Any change produces a new precompiled header, so a stale one is never used.
+    String headerPath;
+    {
+        DigestBuilder<CacheKeyHash> builder;
+        builder.append(cmdLine.m_executableLocation.m_pathOrName);
+        builder.append(desc.type);
+        builder.append(desc.version.m_major);
+        builder.append(desc.version.m_minor);
+        builder.append(desc.version.m_patch);
+        for (const auto& arg : flagsCmdLine.m_args)
+        {
+            builder.append(arg.getLength());
+            builder.append(arg);
+        }
+
+        auto textBlob = StringBlob::create(asStringSlice(options.precompiledHeaderText));
+        DownstreamCompilerCacheUtil::appendSourceWithIncludes(
+            builder,
+            String(),
+            textBlob,
+            options.includePaths,
+            nullptr);
+
+        StringBuilder name;
+        name << "slang-pch-" << builder.finalize().toString() << ".h";
+        headerPath = Path::combine(asString(options.precompiledHeaderDirectory), name);
+    }
+
+    const String pchPath = headerPath + ".gch";
+
+    if (File::exists(headerPath) && File::exists(pchPath))
+    {
+        // Mark it as recently used, so it isn't evicted. Only the precompiled header is
+        // touched, as clang checks the header's modification time hasn't changed.
+        File::touch(pchPath);
+        outHeaderPath = headerPath;
+        return SLANG_OK;
+    }
+
+    Path::createDirectoryRecursive(asString(options.precompiledHeaderDirectory));
+
+    // Other processes, or threads in this one, may be building the same precompiled header
+    // concurrently, so the files are written under unique names, and then renamed into place.
+    // The contents are the same whoever wins.
+    static std::atomic<uint32_t> counter;
+    StringBuilder tempSuffix;
+    tempSuffix << "." << Process::getId() << "." << uint32_t(counter++) << ".tmp";
+
+    if (!File::exists(headerPath))
+    {
+        const String tempHeaderPath = headerPath + tempSuffix;
+        SLANG_RETURN_ON_FAIL(File::writeAllText(
+            tempHeaderPath,
+            asString(options.precompiledHeaderText)));
+        if (::rename(tempHeaderPath.getBuffer(), headerPath.getBuffer()) != 0)
+        {
+            File::remove(tempHeaderPath);
+        }
+    }
+
+    const String tempPchPath = pchPath + tempSuffix;
+
+    CommandLine pchCmdLine;
+    pchCmdLine.setExecutableLocation(cmdLine.m_executableLocation);
+    pchCmdLine.m_args.addRange(cmdLine.m_args);
+    pchCmdLine.m_args.addRange(flagsCmdLine.m_args);
+    pchCmdLine.addArg("-x");
+    pchCmdLine.addArg("c++-header");
+    pchCmdLine.addArg(headerPath);
+    pchCmdLine.addArg("-o");
+    pchCmdLine.addArg(tempPchPath);
+
+    ExecuteResult exeRes;
+    if (SLANG_FAILED(ProcessUtil::execute(pchCmdLine, exeRes)) || exeRes.resultCode != 0 ||
+        !File::exists(tempPchPath))
+    {
+        File::remove(tempPchPath);
+        return SLANG_FAIL;
+    }
+
+    if (::rename(tempPchPath.getBuffer(), pchPath.getBuffer()) != 0)
+    {
+        File::remove(tempPchPath);
+        if (!File::exists(pchPath))
+        {
+            return SLANG_FAIL;
+        }
+    }
+
+    _evictPrecompiledHeaders(asString(options.precompiledHeaderDirectory));
+
+    outHeaderPath = headerPath;
+    return SLANG_OK;
+}
+
 /* static */ SlangResult GCCDownstreamCompilerUtil::createCompiler(
     const ExecutableLocation& exe,
     ComPtr<IDownstreamCompiler>& outCompiler)
@@ -803,4 +1122,164 @@ static SlangResult _parseGCCFamilyLine(
     return SLANG_OK;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! GCCDownstreamCompiler !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!*/
+
+SlangResult GCCDownstreamCompiler::compile(const CompileOptions& inOptions, IArtifact** outArtifact)
+{
+    if (!isVersionCompatible(inOptions))
+    {
+        // Not possible to compile with this version of the interface.
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
+
+    const CompileOptions options = getCompatibleVersion(&inOptions);
+
+    // If the sources start with text that can be precompiled (typically the prelude), compile
+    // just the remainder, and have the compiler -include the header, which it will pick up in
+    // precompiled form. If anything goes wrong we just compile the sources as they are.
+    List<ComPtr<IArtifact>> strippedSourceArtifacts;
+    String headerPath;
+    if (options.precompiledHeaderDirectory.count &&
+        SLANG_SUCCEEDED(Util::stripPrecompiledHeaderText(options, strippedSourceArtifacts)) &&
+        SLANG_SUCCEEDED(Util::calcPrecompiledHeader(m_cmdLine, m_desc, options, headerPath)))
+    {
+        List<TerminatedCharSlice> compilerSpecificArguments;
+        compilerSpecificArguments.addRange(
+            options.compilerSpecificArguments.data,
+            options.compilerSpecificArguments.count);
+        compilerSpecificArguments.add(TerminatedCharSlice("-include"));
+        compilerSpecificArguments.add(SliceUtil::asTerminatedCharSlice(headerPath));
+
+        CompileOptions precompiledHeaderOptions(options);
+        precompiledHeaderOptions.sourceArtifacts = SliceUtil::asSlice(strippedSourceArtifacts);
+        precompiledHeaderOptions.compilerSpecificArguments =
+            SliceUtil::asSlice(compilerSpecificArguments);
+
+        ComPtr<IArtifact> artifact;
+        const SlangResult res = _compile(precompiledHeaderOptions, artifact.writeRef());
+
+        // Another process may have evicted the header after it was found. If the compile failed
+        // and the header is gone, compile the sources as they are instead.
+        const auto diagnostics = artifact
+                                     ? findAssociatedRepresentation<IArtifactDiagnostics>(artifact)
+                                     : nullptr;
+        const bool succeeded =
+            SLANG_SUCCEEDED(res) && (!diagnostics || SLANG_SUCCEEDED(diagnostics->getResult()));
+        if (succeeded || File::exists(headerPath))
+        {
+            *outArtifact = artifact.detach();
+            return res;
+        }
+    }
+
+    return _compile(options, outArtifact);
+}
+
+SlangResult GCCDownstreamCompiler::_compile(const CompileOptions& options, IArtifact** outArtifact)
+{
+    const SlangResult inMemoryRes = _compileInMemory(options, outArtifact);
+    if (inMemoryRes != SLANG_E_NOT_AVAILABLE)
+    {
+        return inMemoryRes;
+    }
+
+    return Super::compile(options, outArtifact);
+}
+
+SlangResult GCCDownstreamCompiler::_compileInMemory(
+    const CompileOptions& options,
+    IArtifact** outArtifact)
+{
+    // Only shared libraries (which is what host callable is compiled to) can be loaded from an
+    // anonymous file. If a module path is set, the product is wanted at that location, and with
+    // verbose output the intermediates are kept on disk to help debugging.
+    if (!AnonymousFileArtifactRepresentation::isSupported() || options.modulePath.count ||
+        (options.flags & CompileOptions::Flag::Verbose) ||
+        (options.targetType != SLANG_SHADER_SHARED_LIBRARY &&
+         options.targetType != SLANG_HOST_SHARED_LIBRARY))
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    // Linkers other than the default (such as lld and gold) may write their output to a temporary
+    // next to the output path and rename it, which isn't possible in /proc/<pid>/fd.
+    for (const auto& arg : options.compilerSpecificArguments)
+    {
+        if (asStringSlice(arg).startsWith(toSlice("-fuse-ld")))
+        {
+            return SLANG_E_NOT_AVAILABLE;
+        }
+    }
+
+    // Sources that are only held in memory are placed in anonymous files. The #line directive
+    // means diagnostics refer to the source by its name rather than the anonymous file.
+    List<ComPtr<IArtifact>> sourceArtifacts;
+    for (IArtifact* sourceArtifact : options.sourceArtifacts)
+    {
+        if (findRepresentation<IOSFileArtifactRepresentation>(sourceArtifact))
+        {
+            sourceArtifacts.add(ComPtr<IArtifact>(sourceArtifact));
+            continue;
+        }
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_RETURN_ON_FAIL(sourceArtifact->loadBlob(ArtifactKeep::No, blob.writeRef()));
+
+        StringBuilder lineDirective;
+        const auto sourcePath = ArtifactUtil::findPath(sourceArtifact);
+        if (sourcePath.getLength())
+        {
+            lineDirective << "#line 1 ";
+            StringEscapeUtil::appendQuoted(
+                StringEscapeUtil::getHandler(StringEscapeUtil::Style::Cpp),
+                sourcePath,
+                lineDirective);
+            lineDirective << "\n";
+        }
+
+        // The source is written after the directive, a segment at a time if it's segmented.
+        ComPtr<IOSFileArtifactRepresentation> sourceRep;
+        SLANG_RETURN_ON_FAIL(AnonymousFileArtifactRepresentation::create(
+            "slang-source",
+            lineDirective.getUnownedSlice(),
+            blob,
+            sourceRep));
+
+        auto anonymousSourceArtifact = ArtifactUtil::createArtifact(sourceArtifact->getDesc());
+        anonymousSourceArtifact->addRepresentation(sourceRep);
+        sourceArtifacts.add(anonymousSourceArtifact);
+    }
+
+    ComPtr<IOSFileArtifactRepresentation> productRep;
+    SLANG_RETURN_ON_FAIL(AnonymousFileArtifactRepresentation::create("slang-product", productRep));
+
+    CompileOptions inMemoryOptions(options);
+    inMemoryOptions.sourceArtifacts = SliceUtil::asSlice(sourceArtifacts);
+
+    CommandLine cmdLine(m_cmdLine);
+    // Pass intermediates between the compiler stages through pipes, rather than temporary files
+    cmdLine.addArg("-pipe");
+    SLANG_RETURN_ON_FAIL(
+        Util::calcArgs(inMemoryOptions, UnownedStringSlice(productRep->getPath()), cmdLine));
+
+    ExecuteResult exeRes;
+    SLANG_RETURN_ON_FAIL(ProcessUtil::execute(cmdLine, exeRes));
+
+    auto artifact = ArtifactUtil::createArtifact(
+        ArtifactDescUtil::makeDescForCompileTarget(options.targetType));
+
+    auto diagnostics = ArtifactDiagnostics::create();
+    SLANG_RETURN_ON_FAIL(parseOutput(exeRes, diagnostics));
+    ArtifactUtil::addAssociated(artifact, diagnostics);
+
+    // The anonymous file always exists, so whether there is a product depends on the result
+    if (exeRes.resultCode == 0)
+    {
+        artifact->addRepresentation(productRep);
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
 } // namespace Slang
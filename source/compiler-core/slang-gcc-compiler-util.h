@@ -21,6 +21,33 @@ struct GCCDownstreamCompilerUtil : public DownstreamCompilerUtilBase
 
     /// Calculate gcc family compilers (including clang) cmdLine arguments from options
     static SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine);
+    /// Calculate cmdLine arguments from options, where the product is written to `outputPath`
+    /// (rather than a path derived from the options modulePath)
+    static SlangResult calcArgs(
+        const CompileOptions& options,
+        const UnownedStringSlice& outputPath,
+        CommandLine& cmdLine);
+
+    /// Calculate the args that control how source is compiled (language, optimization, defines,
+    /// include paths...), but not what is produced. A precompiled header can only be used by a
+    /// compilation with the same flags it was built with.
+    static SlangResult calcCompileFlagArgs(const CompileOptions& options, CommandLine& cmdLine);
+
+    /// Find the precompiled header for `options.precompiledHeaderText` in
+    /// `options.precompiledHeaderDirectory`, building it with the compiler `cmdLine` if it doesn't
+    /// exist yet. `outHeaderPath` is the header to `-include`, the precompiled header is next to
+    /// it with a .gch extension.
+    static SlangResult calcPrecompiledHeader(
+        const CommandLine& cmdLine,
+        const DownstreamCompilerDesc& desc,
+        const CompileOptions& options,
+        String& outHeaderPath);
+
+    /// If every source in `options` starts with `options.precompiledHeaderText`, produces sources
+    /// with that text removed. Line numbers are preserved with a #line directive.
+    static SlangResult stripPrecompiledHeaderText(
+        const CompileOptions& options,
+        List<ComPtr<IArtifact>>& outSourceArtifacts);
 
     /// Parse ExecuteResult into diagnostics
     static SlangResult parseOutput(const ExecuteResult& exeRes, IArtifactDiagnostics* diagnostics);
@@ -57,6 +84,10 @@ public:
     typedef CommandLineDownstreamCompiler Super;
     typedef GCCDownstreamCompilerUtil Util;
 
+    // IDownstreamCompiler
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE;
+
     // CommandLineCPPCompiler impl  - just forwards to the Util
     virtual SlangResult calcArgs(const CompileOptions& options, CommandLine& cmdLine) SLANG_OVERRIDE
     {
@@ -81,6 +112,15 @@ public:
         : Super(desc)
     {
     }
+
+protected:
+    /// Compile `options` in memory if possible, and otherwise through files.
+    SlangResult _compile(const CompileOptions& options, IArtifact** outArtifact);
+
+    /// Compile a shared library entirely in anonymous in-memory files, such that nothing is
+    /// written to (or has to be cleaned up from) the file system. Returns SLANG_E_NOT_AVAILABLE if
+    /// the compilation can't be performed that way.
+    SlangResult _compileInMemory(const CompileOptions& options, IArtifact** outArtifact);
 };
 
 } // namespace Slang
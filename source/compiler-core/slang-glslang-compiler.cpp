@@ -49,6 +49,11 @@ public:
     validate(const uint32_t* contents, int contentsSize) SLANG_OVERRIDE;
     virtual SLANG_NO_THROW SlangResult SLANG_MCALL
     disassemble(const uint32_t* contents, int contentsSize) SLANG_OVERRIDE;
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL link(
+        const uint32_t* const* modules,
+        const size_t* moduleSizes,
+        size_t moduleCount,
+        IArtifact** outArtifact) SLANG_OVERRIDE;
 
     /// Must be called before use
     SlangResult init(ISlangSharedLibrary* library);
@@ -66,6 +71,7 @@ protected:
     glslang_CompileFunc_1_2 m_compile_1_2 = nullptr;
     glslang_ValidateSPIRVFunc m_validate = nullptr;
     glslang_DisassembleSPIRVFunc m_disassemble = nullptr;
+    glslang_LinkSPIRVFunc m_link = nullptr;
 
     ComPtr<ISlangSharedLibrary> m_sharedLibrary;
 
@@ -80,6 +86,7 @@ SlangResult GlslangDownstreamCompiler::init(ISlangSharedLibrary* library)
     m_validate = (glslang_ValidateSPIRVFunc)library->findFuncByName("glslang_validateSPIRV");
     m_disassemble =
         (glslang_DisassembleSPIRVFunc)library->findFuncByName("glslang_disassembleSPIRV");
+    m_link = (glslang_LinkSPIRVFunc)library->findFuncByName("glslang_linkSPIRV");
 
     if (m_compile_1_0 == nullptr && m_compile_1_1 == nullptr && m_compile_1_2 == nullptr)
     {
@@ -323,6 +330,57 @@ SlangResult GlslangDownstreamCompiler::disassemble(const uint32_t* contents, int
     return SLANG_FAIL;
 }
 
+SlangResult GlslangDownstreamCompiler::link(
+    const uint32_t* const* modules,
+    const size_t* moduleSizes,
+    size_t moduleCount,
+    IArtifact** outArtifact)
+{
+    // Older versions of slang-glslang don't provide linking
+    if (m_link == nullptr)
+    {
+        return SLANG_E_NOT_AVAILABLE;
+    }
+
+    StringBuilder diagnosticOutput;
+    auto diagnosticOutputFunc = [](void const* data, size_t size, void* userData)
+    { (*(StringBuilder*)userData).append((char const*)data, (char const*)data + size); };
+    List<uint8_t> spirv;
+    auto outputFunc = [](void const* data, size_t size, void* userData)
+    { ((List<uint8_t>*)userData)->addRange((uint8_t*)data, size); };
+
+    glslang_LinkRequest request;
+    memset(&request, 0, sizeof(request));
+    request.modules = modules;
+    request.moduleSizes = moduleSizes;
+    request.moduleCount = moduleCount;
+    request.outputFunc = outputFunc;
+    request.outputUserData = &spirv;
+    request.diagnosticFunc = diagnosticOutputFunc;
+    request.diagnosticUserData = &diagnosticOutput;
+
+    const SlangResult linkResult = m_link(&request) ? SLANG_OK : SLANG_FAIL;
+
+    auto artifact = ArtifactUtil::createArtifactForCompileTarget(SLANG_SPIRV);
+
+    auto diagnostics = ArtifactDiagnostics::create();
+    diagnostics->setResult(linkResult);
+    ArtifactUtil::addAssociated(artifact, diagnostics);
+
+    if (SLANG_FAILED(linkResult))
+    {
+        diagnostics->setRaw(SliceUtil::asCharSlice(diagnosticOutput));
+        diagnostics->requireErrorDiagnostic();
+    }
+    else
+    {
+        artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
+    }
+
+    *outArtifact = artifact.detach();
+    return SLANG_OK;
+}
+
 bool GlslangDownstreamCompiler::canConvert(const ArtifactDesc& from, const ArtifactDesc& to)
 {
     // Can only disassemble blobs that are SPIR-V
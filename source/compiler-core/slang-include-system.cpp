@@ -149,6 +149,7 @@ SlangResult IncludeSystem::loadFile(
         // If not create a new one, and add to the list of known source files
         if (!outSourceFile)
         {
+            const FileStamp stamp = SourceFile::calcStampBeforeRead(pathInfo);
             ComPtr<ISlangBlob> foundSourceBlob;
             if (SLANG_FAILED(m_fileSystemExt->loadFile(
                     pathInfo.foundPath.getBuffer(),
@@ -158,6 +159,7 @@ SlangResult IncludeSystem::loadFile(
             }
 
             outSourceFile = m_sourceManager->createSourceFileWithBlob(pathInfo, foundSourceBlob);
+            outSourceFile->setStamp(stamp);
             m_sourceManager->addSourceFile(pathInfo.uniqueIdentity, outSourceFile);
 
             outBlob = foundSourceBlob;
@@ -171,6 +173,7 @@ SlangResult IncludeSystem::loadFile(
                 return SLANG_OK;
             }
 
+            const FileStamp stamp = SourceFile::calcStampBeforeRead(pathInfo);
             ComPtr<ISlangBlob> foundSourceBlob;
             if (SLANG_FAILED(m_fileSystemExt->loadFile(
                     pathInfo.foundPath.getBuffer(),
@@ -180,6 +183,7 @@ SlangResult IncludeSystem::loadFile(
             }
 
             outSourceFile->setContents(foundSourceBlob);
+            outSourceFile->setStamp(stamp);
 
             outBlob = foundSourceBlob;
             return SLANG_OK;
@@ -21,29 +21,184 @@ const char* getCstr(Name* name)
     return name ? name->text.getBuffer() : nullptr;
 }
 
-Name* NamePool::getName(UnownedStringSlice text)
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RootNamePool !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+static const Index kInitialNameTableCapacity = 256;
+
+RootNamePool::RootNamePool()
+    : m_count(0), m_arena(16 * 1024)
+{
+    m_table.store(_createTable(kInitialNameTableCapacity), std::memory_order_relaxed);
+}
+
+RootNamePool::~RootNamePool()
+{
+    // Every name lives in the current table, and their memory is owned by the
+    // arena, so we only need to run the destructors.
+    Table* table = m_table.load(std::memory_order_relaxed);
+    for (Index i = 0; i < table->capacity; ++i)
+    {
+        if (Name* name = table->slots[i].load(std::memory_order_relaxed))
+        {
+            name->~Name();
+        }
+    }
+}
+
+RootNamePool::Table* RootNamePool::_createTable(Index capacity)
+{
+    SLANG_ASSERT((capacity & (capacity - 1)) == 0);
+
+    Table* table = m_arena.allocate<Table>();
+    table->capacity = capacity;
+    table->slots = static_cast<std::atomic<Name*>*>(
+        m_arena.allocateAligned(sizeof(std::atomic<Name*>) * capacity, alignof(std::atomic<Name*>)));
+    for (Index i = 0; i < capacity; ++i)
+    {
+        new (&table->slots[i]) std::atomic<Name*>(nullptr);
+    }
+    return table;
+}
+
+/* static */ Name* RootNamePool::_find(
+    const Table* table,
+    UnownedStringSlice text,
+    HashCode64 hash)
+{
+    const Index mask = table->capacity - 1;
+    for (Index i = Index(hash) & mask;; i = (i + 1) & mask)
+    {
+        Name* name = table->slots[i].load(std::memory_order_acquire);
+        if (!name)
+        {
+            return nullptr;
+        }
+        if (name->hash == hash && name->text.getUnownedSlice() == text)
+        {
+            return name;
+        }
+    }
+}
+
+void RootNamePool::_growIfNeeded(Index count)
+{
+    Table* table = m_table.load(std::memory_order_relaxed);
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short.
+    if (count * 2 <= table->capacity)
+    {
+        return;
+    }
+
+    Index capacity = table->capacity;
+    while (count * 2 > capacity)
+    {
+        capacity *= 2;
+    }
+
+    Table* newTable = _createTable(capacity);
+    const Index mask = capacity - 1;
+    for (Index i = 0; i < table->capacity; ++i)
+    {
+        Name* name = table->slots[i].load(std::memory_order_relaxed);
+        if (!name)
+        {
+            continue;
+        }
+        Index j = Index(name->hash) & mask;
+        while (newTable->slots[j].load(std::memory_order_relaxed))
+        {
+            j = (j + 1) & mask;
+        }
+        newTable->slots[j].store(name, std::memory_order_relaxed);
+    }
+
+    // Readers still probing the old table see a consistent (if stale) view,
+    // and will retry under the lock if they don't find what they want.
+    m_table.store(newTable, std::memory_order_release);
+}
+
+Name* RootNamePool::_findOrAddLocked(UnownedStringSlice text, HashCode64 hash)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
+    if (Name* name = _find(m_table.load(std::memory_order_relaxed), text, hash))
+    {
         return name;
+    }
+
+    const Index count = m_count.load(std::memory_order_relaxed) + 1;
+    _growIfNeeded(count);
 
-    name = new Name();
+    Name* name = new (m_arena.allocate<Name>()) Name();
     name->text = text;
-    rootPool->names.add(text, name);
+    name->hash = hash;
+    // The pool owns the name. Holding a reference means a stray `RefPtr`
+    // can never try to free arena memory.
+    name->addReference();
+
+    Table* table = m_table.load(std::memory_order_relaxed);
+    const Index mask = table->capacity - 1;
+    Index i = Index(hash) & mask;
+    while (table->slots[i].load(std::memory_order_relaxed))
+    {
+        i = (i + 1) & mask;
+    }
+    table->slots[i].store(name, std::memory_order_release);
+    m_count.store(count, std::memory_order_relaxed);
     return name;
 }
 
+Name* RootNamePool::tryGetName(UnownedStringSlice text, HashCode64 hash) const
+{
+    return _find(m_table.load(std::memory_order_acquire), text, hash);
+}
+
+Name* RootNamePool::getName(UnownedStringSlice text, HashCode64 hash)
+{
+    if (Name* name = tryGetName(text, hash))
+    {
+        return name;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _findOrAddLocked(text, hash);
+}
+
+void RootNamePool::addNames(ConstArrayView<UnownedStringSlice> texts)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _growIfNeeded(m_count.load(std::memory_order_relaxed) + texts.getCount());
+    for (auto text : texts)
+    {
+        _findOrAddLocked(text, calcHash(text));
+    }
+}
+
+void RootNamePool::reserve(Index count)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    _growIfNeeded(count);
+}
+
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! NamePool !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+Name* NamePool::getName(UnownedStringSlice text)
+{
+    return rootPool->getName(text, RootNamePool::calcHash(text));
+}
+
 Name* NamePool::getName(String const& text)
 {
     return getName(text.getUnownedSlice());
 }
 
+Name* NamePool::tryGetName(UnownedStringSlice text)
+{
+    return rootPool->tryGetName(text, RootNamePool::calcHash(text));
+}
+
 Name* NamePool::tryGetName(String const& text)
 {
-    RefPtr<Name> name;
-    if (rootPool->names.tryGetValue(text, name))
-        return name;
-    return nullptr;
+    return tryGetName(text.getUnownedSlice());
 }
 
 } // namespace Slang
@@ -6,6 +6,10 @@
 // the name of types, variables, etc. in the AST.
 
 #include "../core/slang-basic.h"
+#include "../core/slang-memory-arena.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace Slang
 {
@@ -22,6 +26,10 @@ namespace Slang
 // cleaned up when the pool is deleted), and which is responsible for
 // ensuring the uniqueness of name objects.
 //
+// Names are allocated from an arena owned by the `RootNamePool`, so a
+// `Name` must never be held by a `RefPtr` (the pool holds a reference
+// on every name it creates so that doing so by accident is harmless).
+//
 class Name : public RefObject
 {
 public:
@@ -31,6 +39,9 @@ public:
     // of name than "simple" names, and so this might change to a structured
     // ADT instead of a simple string.
     String text;
+
+    // The hash of `text`, as computed by `RootNamePool::calcHash`.
+    HashCode64 hash = 0;
 };
 
 // Get the textual string representation of a name
@@ -48,10 +59,68 @@ const char* getCstr(Name* name);
 // get equivalent names for a string like `"Foo"`, then they need to use
 // the same root name pool (directly or indirectly).
 //
+// Names are held in an open-addressed hash table keyed directly on the
+// text slice and its hash, so interning a token never has to construct
+// a `String` just to perform the lookup.
+//
+// Lookups are lock-free and may run concurrently with each other and with
+// inserts. Inserts (and table growth) are serialized by a mutex. Tables that
+// are replaced on growth are allocated from the same arena as the names, and
+// so stay valid for any reader that is still probing them.
+//
 struct RootNamePool
 {
-    // The mapping from text strings to the corresponding name.
-    Dictionary<String, RefPtr<Name>> names;
+    RootNamePool();
+    ~RootNamePool();
+
+    RootNamePool(RootNamePool const&) = delete;
+    RootNamePool& operator=(RootNamePool const&) = delete;
+
+    // Find or create the `Name` for `text`, where `hash` is `calcHash(text)`.
+    Name* getName(UnownedStringSlice text, HashCode64 hash);
+
+    // Find the `Name` for `text`, where `hash` is `calcHash(text)`.
+    // Returns nullptr if no such name has been created.
+    Name* tryGetName(UnownedStringSlice text, HashCode64 hash) const;
+
+    // Intern all of `texts` while taking the lock only once. Used to pre-seed
+    // the pool from a serialized string table.
+    void addNames(ConstArrayView<UnownedStringSlice> texts);
+
+    // Make sure at least `count` names can be held without growing the table.
+    void reserve(Index count);
+
+    // The number of distinct names in the pool.
+    Index getCount() const { return m_count.load(std::memory_order_relaxed); }
+
+    // The hash used to key names in the pool.
+    static HashCode64 calcHash(UnownedStringSlice text)
+    {
+        return getHashCode(text.begin(), size_t(text.getLength()));
+    }
+
+private:
+    struct Table
+    {
+        // Always a power of 2
+        Index capacity;
+        std::atomic<Name*>* slots;
+    };
+
+    Table* _createTable(Index capacity);
+    void _growIfNeeded(Index count);
+    Name* _findOrAddLocked(UnownedStringSlice text, HashCode64 hash);
+
+    static Name* _find(const Table* table, UnownedStringSlice text, HashCode64 hash);
+
+    std::atomic<Table*> m_table;
+    std::atomic<Index> m_count;
+
+    // Guards `m_arena` and all writes to the table.
+    std::mutex m_mutex;
+
+    // Holds the `Name`s and all tables ever created.
+    MemoryArena m_arena;
 };
 
 // A `NamePool` is effectively a way of storing a subset of the
@@ -73,6 +142,7 @@ struct NamePool
     Name* getName(String const& text);
     // Try find the `Name` that represents the given `text`.
     // If the name does not exist, return nullptr
+    Name* tryGetName(UnownedStringSlice text);
     Name* tryGetName(String const& text);
     // Set the parent name pool to use for lookup
     void setRootNamePool(RootNamePool* rootNamePool) { this->rootPool = rootNamePool; }
@@ -663,6 +663,17 @@ SHA1::Digest SourceFile::getDigest()
     return m_digest;
 }
 
+/* static */ FileStamp SourceFile::calcStampBeforeRead(const PathInfo& pathInfo)
+{
+    FileStamp stamp;
+    if (!pathInfo.hasFileFoundPath() || SLANG_FAILED(File::getStamp(pathInfo.foundPath, stamp)) ||
+        File::isRecentlyModified(stamp))
+    {
+        return FileStamp();
+    }
+    return stamp;
+}
+
 String SourceFile::calcVerbosePath() const
 {
     ISlangFileSystemExt* fileSystemExt = getSourceManager()->getFileSystemExt();
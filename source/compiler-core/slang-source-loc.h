@@ -5,6 +5,7 @@
 #include "../core/slang-basic.h"
 #include "../core/slang-castable.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-io.h"
 #include "../core/slang-memory-arena.h"
 #include "../core/slang-string-slice-pool.h"
 #include "slang-com-ptr.h"
@@ -334,6 +335,18 @@ public:
 
     SHA1::Digest getDigest();
 
+    /// Get the stamp of the file the contents were read from, taken before they were read.
+    /// Invalid if the contents didn't come from a file, or the stamp can't be trusted.
+    const FileStamp& getStamp() const { return m_stamp; }
+    /// Set the stamp, as returned by `calcStampBeforeRead`.
+    void setStamp(const FileStamp& stamp) { m_stamp = stamp; }
+
+    /// Get the stamp to record for the file at `pathInfo`. Must be called before the file is
+    /// read, so that the stamp can't describe a later version of the file than the contents.
+    /// The stamp is invalid if there is no such file, or if it was modified so recently that
+    /// a further change might not be visible in its stamp.
+    static FileStamp calcStampBeforeRead(const PathInfo& pathInfo);
+
 protected:
     SourceManager* m_sourceManager; ///< The source manager this belongs to
     PathInfo
@@ -345,6 +358,7 @@ protected:
     size_t m_contentSize;             ///< The size of the actual contents
 
     SHA1::Digest m_digest;
+    FileStamp m_stamp;
 
     // In order to speed up lookup of line number information,
     // we will cache the starting offset of each line break in
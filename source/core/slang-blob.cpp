@@ -1,5 +1,7 @@
 #include "slang-blob.h"
 
+#include "slang-math.h"
+
 namespace Slang
 {
 
@@ -150,6 +152,120 @@ void* StringBlob::getObject(const Guid& guid)
     return nullptr;
 }
 
+/* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! SegmentedBlob !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
+
+/* static */ ComPtr<ISlangBlob> SegmentedBlob::moveCreate(List<String>& segments)
+{
+    auto blob = new SegmentedBlob;
+    for (auto& segment : segments)
+    {
+        if (segment.getLength())
+        {
+            blob->m_size += segment.getLength();
+            blob->m_segments.add(_Move(segment));
+        }
+    }
+    segments.clear();
+    return ComPtr<ISlangBlob>(blob);
+}
+
+bool SegmentedBlob::startsWith(const UnownedStringSlice& text)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Index matched = 0;
+    for (const auto& segment : m_segments)
+    {
+        if (matched == text.getLength())
+        {
+            break;
+        }
+        const Index count = Math::Min(segment.getLength(), text.getLength() - matched);
+        if (segment.getUnownedSlice().head(count) != text.subString(matched, count))
+        {
+            return false;
+        }
+        matched += count;
+    }
+    return matched == text.getLength();
+}
+
+ComPtr<ISlangBlob> SegmentedBlob::createTail(const UnownedStringSlice& prefix, size_t offset)
+{
+    List<String> segments;
+    segments.add(prefix);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& segment : m_segments)
+        {
+            const size_t length = size_t(segment.getLength());
+            if (offset >= length)
+            {
+                offset -= length;
+            }
+            else if (offset)
+            {
+                segments.add(segment.getUnownedSlice().tail(Index(offset)));
+                offset = 0;
+            }
+            else
+            {
+                // Copying a string shares its contents
+                segments.add(segment);
+            }
+        }
+    }
+    return moveCreate(segments);
+}
+
+const char* SegmentedBlob::_join()
+{
+    if (m_segments.getCount() > 1)
+    {
+        StringBuilder builder;
+        builder.ensureCapacity(m_size);
+        for (auto& segment : m_segments)
+        {
+            builder.append(segment);
+            // Release each segment once it has been copied, so that joining doesn't double
+            // the memory held.
+            segment = String();
+        }
+        m_segments.setCount(1);
+        m_segments[0] = builder.produceString();
+    }
+    return m_segments.getCount() ? m_segments[0].getBuffer() : "";
+}
+
+void const* SegmentedBlob::getBufferPointer()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return _join();
+}
+
+void* SegmentedBlob::castAs(const SlangUUID& guid)
+{
+    if (auto intf = getInterface(guid))
+    {
+        return intf;
+    }
+    return getObject(guid);
+}
+
+void* SegmentedBlob::getObject(const Guid& guid)
+{
+    if (guid == getTypeGuid())
+    {
+        return this;
+    }
+    // Once joined, the contents are 0 terminated
+    if (guid == SlangTerminatedChars::getTypeGuid())
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return const_cast<char*>(_join());
+    }
+    return nullptr;
+}
+
 /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! RawBlob !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
 
 void* RawBlob::castAs(const SlangUUID& guid)
@@ -8,6 +8,7 @@
 #include "slang-string.h"
 #include "slang.h"
 
+#include <mutex>
 #include <stdarg.h>
 
 namespace Slang
@@ -127,6 +128,61 @@ protected:
     List<uint8_t> m_data;
 };
 
+/** A blob whose contents are held as a sequence of strings, such as the chunks of text that a
+source writer produces.
+
+The segments can be consumed in order without ever being joined, for example when writing
+them to a file. They are only joined into a single buffer when the contents are accessed
+through `getBufferPointer` (or as terminated chars), after which there is a single segment.
+*/
+class SegmentedBlob : public BlobBase
+{
+public:
+    SLANG_CLASS_GUID(0x5d2a7c1e, 0x93b4, 0x4f0a, {0x8e, 0x61, 0x2c, 0xd7, 0x40, 0x1b, 0xa9, 0x53});
+
+    // ICastable
+    virtual SLANG_NO_THROW void* SLANG_MCALL castAs(const SlangUUID& guid) SLANG_OVERRIDE;
+
+    // ISlangBlob
+    SLANG_NO_THROW void const* SLANG_MCALL getBufferPointer() SLANG_OVERRIDE;
+    SLANG_NO_THROW size_t SLANG_MCALL getBufferSize() SLANG_OVERRIDE { return m_size; }
+
+    /// Call `func` with each segment in order as an `UnownedStringSlice`, stopping at the
+    /// first failure.
+    template<typename F>
+    SlangResult forEachSegment(const F& func)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& segment : m_segments)
+        {
+            SLANG_RETURN_ON_FAIL(func(segment.getUnownedSlice()));
+        }
+        return SLANG_OK;
+    }
+
+    /// True if the contents start with `text`.
+    bool startsWith(const UnownedStringSlice& text);
+
+    /// Create a blob holding `prefix` followed by the contents of this blob from `offset` on.
+    /// The segments are shared rather than copied, apart from the one `offset` is within.
+    ComPtr<ISlangBlob> createTail(const UnownedStringSlice& prefix, size_t offset);
+
+    /// Moves the segments into the created blob. Empty segments are dropped.
+    static ComPtr<ISlangBlob> moveCreate(List<String>& segments);
+
+protected:
+    SegmentedBlob() = default;
+
+    void* getObject(const Guid& guid);
+
+    /// Join the segments into one. Must be called with `m_mutex` held.
+    const char* _join();
+
+    std::mutex m_mutex;
+    List<String> m_segments;
+    size_t m_size = 0;
+};
+
 class ScopedAllocation
 {
 public:
@@ -1,5 +1,18 @@
 #include "slang-byte-encode-util.h"
 
+#include <string.h>
+
+#if SLANG_PROCESSOR_FAMILY_X86
+#if SLANG_VC
+#include <intrin.h>
+#endif
+#include <tmmintrin.h>
+#define SLANG_BYTE_ENCODE_STREAM_SSSE3 1
+#elif SLANG_PROCESSOR_ARM_64
+#include <arm_neon.h>
+#define SLANG_BYTE_ENCODE_STREAM_NEON 1
+#endif
+
 namespace Slang
 {
 
@@ -307,4 +320,232 @@ SLANG_FORCE_INLINE static uint32_t _decodeLiteCut2UInt32(const uint8_t* in, int
     return size_t(encodeIn - encodeStart);
 }
 
+// !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! Stream encoding !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
+
+// The layout is that of 'Stream VByte' (Lemire et al).
+// https://arxiv.org/abs/1709.08990
+//
+// Values are in groups of 4, each group having a control byte holding the byte count - 1 of each
+// value in 2 bits, lowest value in the lowest bits. All of the control bytes come first, followed
+// by the little endian value bytes.
+
+namespace
+{ // anonymous
+
+struct StreamDecodeTables
+{
+    StreamDecodeTables()
+    {
+        for (int control = 0; control < 256; ++control)
+        {
+            int dataIndex = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                const int numBytes = ((control >> (i * 2)) & 3) + 1;
+                for (int j = 0; j < 4; ++j)
+                {
+                    // 0x80 makes the shuffle write a zero byte
+                    shuffles[control][i * 4 + j] = (j < numBytes) ? uint8_t(dataIndex + j) : 0x80;
+                }
+                dataIndex += numBytes;
+            }
+            lengths[control] = uint8_t(dataIndex);
+        }
+    }
+
+    /// The shuffle that expands the data bytes of a group into 4 uint32_t
+    uint8_t shuffles[256][16];
+    /// The total amount of data bytes in a group
+    uint8_t lengths[256];
+};
+
+static const StreamDecodeTables& _getStreamDecodeTables()
+{
+    static const StreamDecodeTables s_tables;
+    return s_tables;
+}
+
+SLANG_FORCE_INLINE static uint32_t _decodeStreamValue(const uint8_t* in, int numBytes)
+{
+    uint32_t v = in[0];
+    for (int i = 1; i < numBytes; ++i)
+    {
+        v |= uint32_t(in[i]) << (i * 8);
+    }
+    return v;
+}
+
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3
+
+#if SLANG_GCC || SLANG_CLANG
+#define SLANG_BYTE_ENCODE_SSSE3_TARGET __attribute__((target("ssse3")))
+#else
+#define SLANG_BYTE_ENCODE_SSSE3_TARGET
+#endif
+
+// SSSE3 isn't part of the x86-64 baseline, so the shuffle path is compiled for it explicitly
+// and only taken if the CPU supports it.
+static bool _hasSSSE3()
+{
+#if SLANG_VC
+    int info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 9)) != 0;
+#else
+    return __builtin_cpu_supports("ssse3");
+#endif
+}
+
+SLANG_BYTE_ENCODE_SSSE3_TARGET static size_t _decodeStreamGroupsSSSE3(
+    const uint8_t* controls,
+    const uint8_t* data,
+    const uint8_t* dataEnd,
+    size_t numGroups,
+    uint32_t* valuesOut,
+    const StreamDecodeTables& tables,
+    size_t& outDataSize)
+{
+    const uint8_t* const dataStart = data;
+    size_t i = 0;
+    // Each step loads 16 bytes, so stop while a full load is still in bounds
+    for (; i < numGroups && data + 16 <= dataEnd; ++i)
+    {
+        const uint8_t control = controls[i];
+        const __m128i bytes = _mm_loadu_si128((const __m128i*)data);
+        const __m128i shuffle = _mm_loadu_si128((const __m128i*)tables.shuffles[control]);
+        _mm_storeu_si128((__m128i*)(valuesOut + i * 4), _mm_shuffle_epi8(bytes, shuffle));
+        data += tables.lengths[control];
+    }
+    outDataSize = size_t(data - dataStart);
+    return i;
+}
+
+#elif SLANG_BYTE_ENCODE_STREAM_NEON
+
+static size_t _decodeStreamGroupsNEON(
+    const uint8_t* controls,
+    const uint8_t* data,
+    const uint8_t* dataEnd,
+    size_t numGroups,
+    uint32_t* valuesOut,
+    const StreamDecodeTables& tables,
+    size_t& outDataSize)
+{
+    const uint8_t* const dataStart = data;
+    size_t i = 0;
+    for (; i < numGroups && data + 16 <= dataEnd; ++i)
+    {
+        const uint8_t control = controls[i];
+        // Out of range indices (0x80) produce zero with vqtbl1q, as with pshufb
+        const uint8x16_t bytes = vld1q_u8(data);
+        const uint8x16_t shuffle = vld1q_u8(tables.shuffles[control]);
+        vst1q_u8((uint8_t*)(valuesOut + i * 4), vqtbl1q_u8(bytes, shuffle));
+        data += tables.lengths[control];
+    }
+    outDataSize = size_t(data - dataStart);
+    return i;
+}
+
+#endif
+
+} // namespace
+
+/* static */ void ByteEncodeUtil::encodeStreamUInt32(
+    const uint32_t* in,
+    size_t num,
+    List<uint8_t>& encodeOut)
+{
+    const size_t numControlBytes = (num + 3) / 4;
+
+    // Make space for the worst case
+    const Index startIndex = encodeOut.getCount();
+    encodeOut.setCount(startIndex + Index(numControlBytes + num * sizeof(uint32_t)));
+
+    uint8_t* controls = encodeOut.begin() + startIndex;
+    uint8_t* data = controls + numControlBytes;
+    ::memset(controls, 0, numControlBytes);
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        uint32_t v = in[i];
+        const int numBytes = v ? calcNonZeroMsByte32(v) + 1 : 1;
+
+        controls[i >> 2] |= uint8_t((numBytes - 1) << ((i & 3) * 2));
+        for (int j = 0; j < numBytes; ++j)
+        {
+            *data++ = uint8_t(v);
+            v >>= 8;
+        }
+    }
+
+    encodeOut.setCount(Index(data - encodeOut.begin()));
+}
+
+/* static */ size_t ByteEncodeUtil::decodeStreamUInt32(
+    const uint8_t* encodeIn,
+    size_t encodeSizeInBytes,
+    size_t numValues,
+    uint32_t* valuesOut)
+{
+    const size_t numControlBytes = (numValues + 3) / 4;
+    if (numControlBytes > encodeSizeInBytes)
+    {
+        return 0;
+    }
+
+    const uint8_t* const controls = encodeIn;
+    const uint8_t* data = encodeIn + numControlBytes;
+    const uint8_t* const dataEnd = encodeIn + encodeSizeInBytes;
+
+    // Only whole groups are decoded with shuffles, the rest is handled one value at a time below
+    size_t numDecoded = 0;
+    {
+        const size_t numGroups = numValues / 4;
+        const StreamDecodeTables& tables = _getStreamDecodeTables();
+        size_t dataSize = 0;
+        size_t numGroupsDecoded = 0;
+
+#if SLANG_BYTE_ENCODE_STREAM_SSSE3
+        static const bool s_hasSSSE3 = _hasSSSE3();
+        if (s_hasSSSE3)
+        {
+            numGroupsDecoded = _decodeStreamGroupsSSSE3(
+                controls,
+                data,
+                dataEnd,
+                numGroups,
+                valuesOut,
+                tables,
+                dataSize);
+        }
+#elif SLANG_BYTE_ENCODE_STREAM_NEON
+        numGroupsDecoded = _decodeStreamGroupsNEON(
+            controls,
+            data,
+            dataEnd,
+            numGroups,
+            valuesOut,
+            tables,
+            dataSize);
+#endif
+        SLANG_UNUSED(tables);
+
+        data += dataSize;
+        numDecoded = numGroupsDecoded * 4;
+    }
+
+    for (size_t i = numDecoded; i < numValues; ++i)
+    {
+        const int numBytes = ((controls[i >> 2] >> ((i & 3) * 2)) & 3) + 1;
+        if (data + numBytes > dataEnd)
+        {
+            return 0;
+        }
+        valuesOut[i] = _decodeStreamValue(data, numBytes);
+        data += numBytes;
+    }
+
+    return size_t(data - encodeIn);
+}
+
 } // namespace Slang
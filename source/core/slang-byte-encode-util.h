@@ -82,6 +82,31 @@ struct ByteEncodeUtil
     */
     static size_t decodeLiteUInt32(const uint8_t* encodeIn, size_t numValues, uint32_t* valuesOut);
 
+    /** Encode an array of uint32_t using the 'stream' layout (as in Stream VByte).
+
+    Each value is stored in 1 to 4 bytes. The 2-bit byte counts of all values are stored first,
+    packed 4 to a control byte, followed by all of the value bytes. Keeping the lengths apart from
+    the data means a group of 4 values can be decoded with a single table driven byte shuffle.
+
+    @param in The values to encode
+    @param num The amount of values to encode
+    @param encodeOut Encoded bytes are appended to this list
+    */
+    static void encodeStreamUInt32(const uint32_t* in, size_t num, List<uint8_t>& encodeOut);
+
+    /** Decode an array of uint32_t encoded with `encodeStreamUInt32`
+    @param encodeIn The encoded values
+    @param encodeSizeInBytes The size of the encoded data. Decoding never reads past this.
+    @param numValues The amount of values to be decoded
+    @param valuesOut The buffer to hold the decoded values. MUST be large enough to hold numValues
+    @return The amount of bytes decoded, or 0 if the encoding is truncated
+    */
+    static size_t decodeStreamUInt32(
+        const uint8_t* encodeIn,
+        size_t encodeSizeInBytes,
+        size_t numValues,
+        uint32_t* valuesOut);
+
     /// Table that maps 8 bits to it's most significant bit. If 0 returns -1.
     static const int8_t s_msb8[256];
 };
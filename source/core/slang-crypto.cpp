@@ -6,11 +6,16 @@
  * SHA1 implementation is based on:
  * https://github.com/983/SHA1
  * Original LICENSE is at the bottom of this file.
+ *
+ * MurmurHash3 implementation is based on:
+ * https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+ * which was written by Austin Appleby and placed in the public domain.
  */
 
 #include "slang-crypto.h"
 
 #include "../core/slang-char-util.h"
+#include "../core/slang-math.h"
 
 namespace Slang
 {
@@ -552,6 +557,183 @@ void SHA1::processBlock(const uint8_t* ptr)
     return sha1.finalize();
 }
 
+// MurmurHash3
+
+static const uint64_t kMurmurC1 = 0x87c37b91114253d5ULL;
+static const uint64_t kMurmurC2 = 0x4cf5ad432745937fULL;
+
+SLANG_FORCE_INLINE static uint64_t _rotl64(uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+SLANG_FORCE_INLINE static uint64_t _getBlock64(const uint8_t* ptr)
+{
+    // Assemble the value byte by byte, so that reads are neither unaligned nor dependent on the
+    // endianness of the target. Compilers turn this into a single load where possible.
+    uint64_t value = 0;
+    for (int i = 7; i >= 0; --i)
+    {
+        value = (value << 8) | ptr[i];
+    }
+    return value;
+}
+
+SLANG_FORCE_INLINE static uint64_t _fmix64(uint64_t k)
+{
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+}
+
+SLANG_FORCE_INLINE static uint64_t _mixK1(uint64_t k1)
+{
+    k1 *= kMurmurC1;
+    k1 = _rotl64(k1, 31);
+    k1 *= kMurmurC2;
+    return k1;
+}
+
+SLANG_FORCE_INLINE static uint64_t _mixK2(uint64_t k2)
+{
+    k2 *= kMurmurC2;
+    k2 = _rotl64(k2, 33);
+    k2 *= kMurmurC1;
+    return k2;
+}
+
+MurmurHash3::MurmurHash3()
+{
+    init();
+}
+
+void MurmurHash3::init()
+{
+    m_h1 = 0;
+    m_h2 = 0;
+    m_length = 0;
+    m_index = 0;
+}
+
+void MurmurHash3::processBlock(const uint8_t* ptr)
+{
+    uint64_t h1 = m_h1;
+    uint64_t h2 = m_h2;
+
+    h1 ^= _mixK1(_getBlock64(ptr));
+    h1 = _rotl64(h1, 27);
+    h1 += h2;
+    h1 = h1 * 5 + 0x52dce729;
+
+    h2 ^= _mixK2(_getBlock64(ptr + 8));
+    h2 = _rotl64(h2, 31);
+    h2 += h1;
+    h2 = h2 * 5 + 0x38495ab5;
+
+    m_h1 = h1;
+    m_h2 = h2;
+}
+
+void MurmurHash3::update(const void* data, SlangSizeT len)
+{
+    if (!data || len <= 0)
+    {
+        return;
+    }
+
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(data);
+    m_length += len;
+
+    // Complete a partially filled block.
+    if (m_index != 0)
+    {
+        const SlangSizeT count = Math::Min(len, SlangSizeT(sizeof(m_buf) - m_index));
+        ::memcpy(m_buf + m_index, ptr, count);
+        m_index += uint32_t(count);
+        ptr += count;
+        len -= count;
+        if (m_index < sizeof(m_buf))
+        {
+            return;
+        }
+        processBlock(m_buf);
+        m_index = 0;
+    }
+
+    // Process full blocks directly from the input.
+    while (len >= sizeof(m_buf))
+    {
+        processBlock(ptr);
+        ptr += sizeof(m_buf);
+        len -= sizeof(m_buf);
+    }
+
+    // Keep the remaining bytes for later.
+    if (len > 0)
+    {
+        ::memcpy(m_buf, ptr, len);
+        m_index = uint32_t(len);
+    }
+}
+
+MurmurHash3::Digest MurmurHash3::finalize()
+{
+    uint64_t h1 = m_h1;
+    uint64_t h2 = m_h2;
+
+    // Mix in the tail, which is less than a full block.
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    for (uint32_t i = m_index; i > 8; --i)
+    {
+        k2 = (k2 << 8) | m_buf[i - 1];
+    }
+    for (uint32_t i = Math::Min(m_index, 8u); i > 0; --i)
+    {
+        k1 = (k1 << 8) | m_buf[i - 1];
+    }
+    if (m_index > 8)
+    {
+        h2 ^= _mixK2(k2);
+    }
+    if (m_index > 0)
+    {
+        h1 ^= _mixK1(k1);
+    }
+
+    h1 ^= m_length;
+    h2 ^= m_length;
+
+    h1 += h2;
+    h2 += h1;
+
+    h1 = _fmix64(h1);
+    h2 = _fmix64(h2);
+
+    h1 += h2;
+    h2 += h1;
+
+    Digest digest;
+    uint8_t* data = reinterpret_cast<uint8_t*>(digest.data);
+    for (int i = 0; i < 8; i++)
+    {
+        data[i] = uint8_t(h1 >> (i * 8));
+        data[i + 8] = uint8_t(h2 >> (i * 8));
+    }
+
+    return digest;
+}
+
+/* static */ MurmurHash3::Digest MurmurHash3::compute(const void* data, SlangInt size)
+{
+    MurmurHash3 hash;
+    hash.update(data, size);
+    return hash.finalize();
+}
+
 } // namespace Slang
 
 
@@ -114,6 +114,38 @@ private:
     uint8_t m_buf[64];
 };
 
+/// 128-bit MurmurHash3 (the x64 variant) hash generator implementing
+/// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp
+///
+/// This is not a cryptographic hash, but it is an order of magnitude faster than SHA1. Digests
+/// match the reference implementation with a seed of 0 on little-endian targets.
+class MurmurHash3
+{
+public:
+    using Digest = HashDigest<16>;
+
+    MurmurHash3();
+
+    void init();
+    void update(const void* data, SlangSizeT size);
+    Digest finalize();
+
+    static Digest compute(const void* data, SlangInt size);
+
+private:
+    void processBlock(const uint8_t* ptr);
+
+    uint64_t m_h1, m_h2;
+    uint64_t m_length;
+    uint32_t m_index;
+    uint8_t m_buf[16];
+};
+
+/// The hash used for keys that are only compared within a process, or stored in caches that
+/// can be discarded. Such keys don't need a stable or cryptographically strong digest, so a
+/// fast hash is used. Digests that are part of a persisted format keep using SHA1.
+using CacheKeyHash = MurmurHash3;
+
 // Helper class for building hashes.
 template<typename Hash>
 struct DigestBuilder
@@ -0,0 +1,144 @@
+#include "slang-file-digest-cache.h"
+
+#include "../core/slang-string-util.h"
+
+namespace Slang
+{
+
+// Each line of the cache file holds one entry, as
+//
+//     <digest> <size> <modified-time> <file-id> <path>
+//
+// The path comes last, so that it can contain spaces.
+
+static bool _parseUInt64(const UnownedStringSlice& text, uint64_t& outValue)
+{
+    if (text.getLength() == 0)
+        return false;
+
+    uint64_t value = 0;
+    for (char c : text)
+    {
+        if (c < '0' || c > '9')
+            return false;
+        value = value * 10 + uint64_t(c - '0');
+    }
+    outValue = value;
+    return true;
+}
+
+/* static */ void FileDigestCache::_parse(const UnownedStringSlice& text, EntryMap& ioEntries)
+{
+    for (auto line : LineParser(text))
+    {
+        // Split off the fields that precede the path.
+        UnownedStringSlice fields[4];
+        UnownedStringSlice rest = line;
+        bool isValid = true;
+        for (auto& field : fields)
+        {
+            const Index spaceIndex = rest.indexOf(' ');
+            if (spaceIndex <= 0)
+            {
+                isValid = false;
+                break;
+            }
+            field = rest.head(spaceIndex);
+            rest = rest.tail(spaceIndex + 1);
+        }
+        if (!isValid || rest.getLength() == 0)
+            continue;
+
+        Entry entry;
+        if (!DigestUtil::stringToDigest(
+                fields[0].begin(),
+                fields[0].getLength(),
+                entry.digest.data,
+                sizeof(entry.digest.data)) ||
+            !_parseUInt64(fields[1], entry.stamp.size) ||
+            !_parseUInt64(fields[2], entry.stamp.modifiedTime) ||
+            !_parseUInt64(fields[3], entry.stamp.fileId))
+        {
+            continue;
+        }
+        ioEntries[rest] = entry;
+    }
+}
+
+/* static */ void FileDigestCache::_write(const EntryMap& entries, StringBuilder& out)
+{
+    for (const auto& [path, entry] : entries)
+    {
+        out << entry.digest.toString() << " ";
+        out.append(entry.stamp.size);
+        out << " ";
+        out.append(entry.stamp.modifiedTime);
+        out << " ";
+        out.append(entry.stamp.fileId);
+        out << " " << path << "\n";
+    }
+}
+
+SlangResult FileDigestCache::load()
+{
+    m_entries.clear();
+    if (!File::exists(m_fileName))
+        return SLANG_OK;
+
+    String text;
+    SLANG_RETURN_ON_FAIL(File::readAllText(m_fileName, text));
+    _parse(text.getUnownedSlice(), m_entries);
+    return SLANG_OK;
+}
+
+SlangResult FileDigestCache::save()
+{
+    if (m_addedEntries.getCount() == 0)
+        return SLANG_OK;
+
+    // Merge with what other processes may have written since the cache was loaded.
+    EntryMap entries;
+    String text;
+    if (File::exists(m_fileName) && SLANG_SUCCEEDED(File::readAllText(m_fileName, text)))
+        _parse(text.getUnownedSlice(), entries);
+    for (const auto& [path, entry] : m_addedEntries)
+        entries[path] = entry;
+
+    StringBuilder builder;
+    _write(entries, builder);
+    SLANG_RETURN_ON_FAIL(
+        File::writeAllBytesAtomically(m_fileName, builder.getBuffer(), builder.getLength()));
+
+    m_entries = _Move(entries);
+    m_addedEntries.clear();
+    return SLANG_OK;
+}
+
+bool FileDigestCache::tryGetDigest(
+    const String& path,
+    const FileStamp& stamp,
+    SHA1::Digest& outDigest) const
+{
+    auto entry = m_entries.tryGetValue(path);
+    if (!entry || !stamp.isValid() || entry->stamp != stamp)
+        return false;
+    outDigest = entry->digest;
+    return true;
+}
+
+void FileDigestCache::setDigest(
+    const String& path,
+    const FileStamp& stamp,
+    const SHA1::Digest& digest)
+{
+    if (!stamp.isValid() || File::isRecentlyModified(stamp))
+        return;
+
+    Entry entry;
+    entry.stamp = stamp;
+    entry.digest = digest;
+    m_entries[path] = entry;
+    m_addedEntries[path] = entry;
+}
+
+} // namespace Slang
@@ -0,0 +1,58 @@
+#pragma once
+#include "../core/slang-crypto.h"
+#include "../core/slang-dictionary.h"
+#include "../core/slang-io.h"
+#include "../core/slang-string.h"
+
+namespace Slang
+{
+
+/// A persistent map from file paths to the digests of the files' contents.
+///
+/// Each entry records the stamp of the file when its digest was computed, and is only used while
+/// the file still has that stamp, so stale entries are harmless. The map is held in a single text
+/// file that can be shared between processes. The file is read once, and additions are merged
+/// with its current contents and written atomically by `save`. Processes saving at the same time
+/// can lose each other's additions, but never corrupt the file.
+class FileDigestCache : public RefObject
+{
+public:
+    /// Read the entries held in the cache file. A missing file is treated as an empty cache.
+    SlangResult load();
+
+    /// Write entries added since the cache was loaded, merged with the current contents of the
+    /// cache file. Does nothing if no entries were added.
+    SlangResult save();
+
+    /// Get the digest recorded for `path`, if the recorded stamp matches `stamp`.
+    bool tryGetDigest(const String& path, const FileStamp& stamp, SHA1::Digest& outDigest) const;
+
+    /// Record the `digest` of the file at `path`, which has `stamp`. Stamps of files modified
+    /// too recently to be reliable are ignored.
+    void setDigest(const String& path, const FileStamp& stamp, const SHA1::Digest& digest);
+
+    const String& getFileName() const { return m_fileName; }
+
+    FileDigestCache(const String& fileName)
+        : m_fileName(fileName)
+    {
+    }
+
+protected:
+    struct Entry
+    {
+        FileStamp stamp;
+        SHA1::Digest digest;
+    };
+    typedef Dictionary<String, Entry> EntryMap;
+
+    /// Add the entries in `text` to `ioEntries`. Malformed lines are skipped.
+    static void _parse(const UnownedStringSlice& text, EntryMap& ioEntries);
+    static void _write(const EntryMap& entries, StringBuilder& out);
+
+    String m_fileName;
+    EntryMap m_entries;
+    EntryMap m_addedEntries;
+};
+
+} // namespace Slang
@@ -5,6 +5,8 @@
 #include "slang-char-util.h"
 #include "slang-com-helper.h"
 #include "slang-exception.h"
+#include "slang-platform.h"
+#include "slang-process.h"
 #include "slang-string-util.h"
 
 #ifndef __STDC__
@@ -37,6 +39,8 @@
 #include <mach-o/dyld.h>
 #endif
 
+#include <atomic>
+#include <chrono>
 #include <filesystem>
 #include <limits.h> /* PATH_MAX */
 #include <stdio.h>
@@ -66,12 +70,8 @@ namespace Slang
 
 
 #ifdef _WIN32
-/* static */ SlangResult File::generateTemporary(
-    const UnownedStringSlice& inPrefix,
-    Slang::String& outFileName)
+/* static */ SlangResult File::getTemporaryDirectory(String& outPath)
 {
-    // https://docs.microsoft.com/en-us/windows/win32/fileio/creating-and-using-a-temporary-file
-
     String tempPath;
     {
         int count = MAX_PATH + 1;
@@ -100,6 +100,19 @@ namespace Slang
         return SLANG_FAIL;
     }
 
+    outPath = tempPath;
+    return SLANG_OK;
+}
+
+/* static */ SlangResult File::generateTemporary(
+    const UnownedStringSlice& inPrefix,
+    Slang::String& outFileName)
+{
+    // https://docs.microsoft.com/en-us/windows/win32/fileio/creating-and-using-a-temporary-file
+
+    String tempPath;
+    SLANG_RETURN_ON_FAIL(getTemporaryDirectory(tempPath));
+
     const String prefix(inPrefix);
     String tempFileName;
 
@@ -125,6 +138,12 @@ namespace Slang
     return SLANG_OK;
 }
 #else
+/* static */ SlangResult File::getTemporaryDirectory(String& outPath)
+{
+    outPath = "/tmp";
+    return SLANG_OK;
+}
+
 /* static */ SlangResult File::generateTemporary(
     const UnownedStringSlice& inPrefix,
     Slang::String& outFileName)
@@ -156,6 +175,79 @@ namespace Slang
 }
 #endif
 
+/* static */ SlangResult File::getUserCacheDirectory(String& outPath)
+{
+    StringBuilder path;
+#if SLANG_WINDOWS_FAMILY
+    PlatformUtil::getEnvironmentVariable(toSlice("LOCALAPPDATA"), path);
+#elif SLANG_APPLE_FAMILY
+    if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(toSlice("HOME"), path)) &&
+        path.getLength())
+    {
+        path << "/Library/Caches";
+    }
+#else
+    if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(toSlice("XDG_CACHE_HOME"), path)) ||
+        path.getLength() == 0)
+    {
+        path.clear();
+        if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(toSlice("HOME"), path)) &&
+            path.getLength())
+        {
+            path << "/.cache";
+        }
+    }
+#endif
+
+    if (path.getLength() == 0)
+    {
+        return getTemporaryDirectory(outPath);
+    }
+
+    outPath = path.produceString();
+    return SLANG_OK;
+}
+
+/* static */ SlangResult File::writeAllBytesAtomically(
+    const String& fileName,
+    const void* data,
+    size_t size)
+{
+    // The temporary name must be unique across processes, and threads within a process.
+    static std::atomic<uint32_t> counter;
+
+    StringBuilder tempFileName;
+    tempFileName << fileName << "." << Process::getId() << "."
+                 << uint32_t(counter++) << ".tmp";
+
+    SLANG_RETURN_ON_FAIL(writeAllBytes(tempFileName, data, size));
+
+#ifdef _WIN32
+    const BOOL renamed = ::MoveFileExA(
+        tempFileName.getBuffer(),
+        fileName.getBuffer(),
+        MOVEFILE_REPLACE_EXISTING);
+    if (!renamed)
+#else
+    if (::rename(tempFileName.getBuffer(), fileName.getBuffer()) != 0)
+#endif
+    {
+        remove(tempFileName);
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+}
+
+/* static */ SlangResult File::touch(const String& fileName)
+{
+    std::error_code ec;
+    std::filesystem::last_write_time(
+        std::filesystem::path(fileName.getBuffer()),
+        std::filesystem::file_time_type::clock::now(),
+        ec);
+    return ec ? SLANG_FAIL : SLANG_OK;
+}
+
 /* static */ SlangResult File::makeExecutable(const String& fileName)
 {
 #ifdef _WIN32
@@ -194,6 +286,45 @@ bool File::exists(const String& fileName)
 #endif
 }
 
+/* static */ SlangResult File::getStamp(const String& fileName, FileStamp& outStamp)
+{
+    FileStamp stamp;
+#ifdef _WIN32
+    struct _stat64 statVar;
+    if (::_wstat64(((String)fileName).toWString(), &statVar) != 0)
+        return SLANG_E_NOT_FOUND;
+    // Windows doesn't provide a file identity through stat.
+    stamp.modifiedTime = uint64_t(statVar.st_mtime) * 1000000000;
+#else
+    struct stat statVar;
+    if (::stat(fileName.getBuffer(), &statVar) != 0)
+        return SLANG_E_NOT_FOUND;
+#if SLANG_APPLE_FAMILY
+    const auto& modifiedTime = statVar.st_mtimespec;
+#else
+    const auto& modifiedTime = statVar.st_mtim;
+#endif
+    stamp.modifiedTime =
+        uint64_t(modifiedTime.tv_sec) * 1000000000 + uint64_t(modifiedTime.tv_nsec);
+    stamp.fileId = uint64_t(statVar.st_ino);
+#endif
+    stamp.size = uint64_t(statVar.st_size);
+
+    outStamp = stamp;
+    return SLANG_OK;
+}
+
+/* static */ bool File::isRecentlyModified(const FileStamp& stamp)
+{
+    // Some file systems only record modification times to the nearest one or two seconds.
+    const uint64_t kMaxResolution = uint64_t(2) * 1000000000;
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    const auto nowNanoseconds =
+        uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+    return stamp.modifiedTime + kMaxResolution >= nowNanoseconds;
+}
+
 String Path::replaceExt(const String& path, const char* newExt)
 {
     StringBuilder sb(path.getLength() + 10);
@@ -583,6 +714,34 @@ bool Path::createDirectory(const String& path)
 #endif
 }
 
+/* static */ SlangResult Path::createPrivateDirectory(const String& path)
+{
+#if defined(_WIN32)
+    // Directories under the user's profile are only accessible to the user by default.
+    return createDirectoryRecursive(path) ? SLANG_OK : SLANG_FAIL;
+#else
+    if (!File::exists(path))
+    {
+        const String parentPath = getParentDirectory(path);
+        if (parentPath.getLength())
+        {
+            createDirectoryRecursive(parentPath);
+        }
+        // Another process may create it first, which is fine as long as the checks below pass.
+        ::mkdir(path.getBuffer(), 0700);
+    }
+
+    // Use lstat, so that a symbolic link to a directory owned by someone else isn't followed.
+    struct stat pathStat;
+    if (::lstat(path.getBuffer(), &pathStat) != 0 || !S_ISDIR(pathStat.st_mode) ||
+        pathStat.st_uid != ::geteuid() || (pathStat.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+    {
+        return SLANG_FAIL;
+    }
+    return SLANG_OK;
+#endif
+}
+
 bool Path::createDirectoryRecursive(const String& path)
 {
     String finalPath = Path::simplify(path);
@@ -9,11 +9,38 @@
 
 namespace Slang
 {
+/// Identifies the state of a file on disk, so that changes to the file can usually be detected
+/// without reading its contents.
+struct FileStamp
+{
+    uint64_t size = 0;
+    /// Nanoseconds since the Unix epoch. Only has a resolution of seconds on some platforms.
+    uint64_t modifiedTime = 0;
+    /// An identifier for the file in its file system (the inode), or 0 if not available.
+    uint64_t fileId = 0;
+
+    bool isValid() const { return modifiedTime != 0; }
+
+    bool operator==(const FileStamp& rhs) const
+    {
+        return size == rhs.size && modifiedTime == rhs.modifiedTime && fileId == rhs.fileId;
+    }
+    bool operator!=(const FileStamp& rhs) const { return !(*this == rhs); }
+};
+
 class File
 {
 public:
     static bool exists(const String& fileName);
 
+    /// Get the stamp of the file at `fileName`.
+    static SlangResult getStamp(const String& fileName, FileStamp& outStamp);
+
+    /// True if `stamp` was modified so recently that the file could be modified again without
+    /// its stamp changing, given the resolution of modification times. Such stamps should not
+    /// be used to decide a file is unchanged.
+    static bool isRecentlyModified(const FileStamp& stamp);
+
     static SlangResult readAllText(const String& fileName, String& outString);
 
     static SlangResult readAllBytes(const String& fileName, List<unsigned char>& out);
@@ -28,14 +55,31 @@ public:
 
     static SlangResult writeAllBytes(const String& fileName, const void* data, size_t size);
 
+    /// Write the bytes to a uniquely named temporary beside `fileName`, and then rename it into
+    /// place. Other processes reading `fileName` will either see it absent, or complete.
+    static SlangResult writeAllBytesAtomically(
+        const String& fileName,
+        const void* data,
+        size_t size);
+
     static SlangResult remove(const String& fileName);
 
     static SlangResult makeExecutable(const String& fileName);
 
+    /// Set the modification time of an existing file to now.
+    static SlangResult touch(const String& fileName);
+
     /// Creates a temporary file typically in some way based on the prefix
     /// The file will be *created* with the outFileName, on success.
     /// It's creation in necessary to lock that particular name.
     static SlangResult generateTemporary(const UnownedStringSlice& prefix, String& outFileName);
+
+    /// Get the directory temporary files are created in by `generateTemporary`
+    static SlangResult getTemporaryDirectory(String& outPath);
+
+    /// Get the directory for the users non-essential cached data (such as %LOCALAPPDATA% on
+    /// Windows or $XDG_CACHE_HOME on Linux). Falls back to the temporary directory.
+    static SlangResult getUserCacheDirectory(String& outPath);
 };
 
 class Path
@@ -159,6 +203,12 @@ public:
     static bool createDirectory(const String& path);
     static bool createDirectoryRecursive(const String& path);
 
+    /// Create the directory `path` if it doesn't exist, such that only the current user can
+    /// access it, creating its parents as needed. Fails if `path` isn't a directory owned by the
+    /// current user, or if other users can write to it, so that files found in it can be trusted
+    /// to have been written by the current user.
+    static SlangResult createPrivateDirectory(const String& path);
+
     /// Accept either style of delimiter
     SLANG_FORCE_INLINE static bool isDelimiter(char c) { return c == '/' || c == '\\'; }
 
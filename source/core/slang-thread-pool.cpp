@@ -0,0 +1,135 @@
+#include "slang-thread-pool.h"
+
+#include "slang-math.h"
+
+namespace Slang
+{
+
+ThreadPool::ThreadPool(Index threadCount)
+{
+    for (Index i = 0; i < threadCount; ++i)
+    {
+        m_threads.add(std::thread([this]() { _workerMain(); }));
+    }
+}
+
+ThreadPool::ThreadPool()
+    : ThreadPool(Math::Max(Index(std::thread::hardware_concurrency()) - 1, Index(0)))
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_jobAdded.notify_all();
+
+    for (auto& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+void ThreadPool::_runIterations(Job* job)
+{
+    while (!job->failed.load(std::memory_order_relaxed))
+    {
+        const Index i = job->next++;
+        if (i >= job->count)
+        {
+            break;
+        }
+
+        try
+        {
+            (*job->func)(i);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!job->failed.exchange(true))
+            {
+                job->exception = std::current_exception();
+            }
+        }
+    }
+}
+
+void ThreadPool::_removeJob(Job* job)
+{
+    const Index index = m_jobs.indexOf(job);
+    if (index >= 0)
+    {
+        m_jobs.removeAt(index);
+    }
+}
+
+void ThreadPool::_workerMain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_jobAdded.wait(lock, [&]() { return m_stop || m_jobs.getCount() > 0; });
+        if (m_stop)
+        {
+            return;
+        }
+
+        // Help with the most recent job first, as it may be nested in an earlier one.
+        Job* job = m_jobs.getLast();
+        job->workerCount++;
+
+        lock.unlock();
+        _runIterations(job);
+        lock.lock();
+
+        // There is nothing left to claim, so no other worker should pick it up.
+        _removeJob(job);
+        job->workerCount--;
+        m_workerDone.notify_all();
+    }
+}
+
+void ThreadPool::parallelFor(Index count, const std::function<void(Index)>& func)
+{
+    if (count <= 0)
+    {
+        return;
+    }
+    if (count == 1 || m_threads.getCount() == 0)
+    {
+        for (Index i = 0; i < count; ++i)
+        {
+            func(i);
+        }
+        return;
+    }
+
+    Job job;
+    job.func = &func;
+    job.count = count;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.add(&job);
+    }
+    m_jobAdded.notify_all();
+
+    _runIterations(&job);
+
+    {
+        // The job lives on this stack, so wait until no worker can be using it.
+        std::unique_lock<std::mutex> lock(m_mutex);
+        _removeJob(&job);
+        m_workerDone.wait(lock, [&]() { return job.workerCount == 0; });
+    }
+
+    if (job.exception)
+    {
+        std::rethrow_exception(job.exception);
+    }
+}
+
+} // namespace Slang
@@ -0,0 +1,72 @@
+#ifndef SLANG_CORE_THREAD_POOL_H
+#define SLANG_CORE_THREAD_POOL_H
+
+#include "slang-list.h"
+#include "slang-smart-pointer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace Slang
+{
+
+/// A fixed set of worker threads that run the iterations of `parallelFor` loops.
+///
+/// The thread calling `parallelFor` runs iterations too, and only returns once all of them
+/// are complete, so loops can be nested, and a pool without any threads runs everything on
+/// the calling thread. Loops from different threads can run at the same time, sharing the
+/// workers.
+class ThreadPool : public RefObject
+{
+public:
+    /// Call `func(i)` for each `i` in `[0, count)`, in no particular order.
+    ///
+    /// If any call throws, the remaining iterations are skipped, and the first exception is
+    /// rethrown on the calling thread once the calls that already started have finished.
+    void parallelFor(Index count, const std::function<void(Index)>& func);
+
+    /// The number of worker threads, not counting threads calling `parallelFor`.
+    Index getThreadCount() const { return m_threads.getCount(); }
+
+    /// Create a pool with `threadCount` worker threads.
+    explicit ThreadPool(Index threadCount);
+    /// Create a pool with a worker for each hardware thread but one, for the calling thread.
+    ThreadPool();
+    ~ThreadPool();
+
+protected:
+    struct Job
+    {
+        const std::function<void(Index)>* func = nullptr;
+        Index count = 0;
+        std::atomic<Index> next{0};
+        std::atomic<bool> failed{false};
+        std::exception_ptr exception;
+        /// The number of workers running iterations. Guarded by `m_mutex`.
+        Index workerCount = 0;
+    };
+
+    /// Run iterations of `job` until none are left.
+    void _runIterations(Job* job);
+    void _removeJob(Job* job);
+    void _workerMain();
+
+    List<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    /// Signalled when a job is added, or the pool is destroyed
+    std::condition_variable m_jobAdded;
+    /// Signalled when a worker stops running iterations of a job
+    std::condition_variable m_workerDone;
+    /// Jobs that may still have iterations to claim. Guarded by `m_mutex`.
+    List<Job*> m_jobs;
+    bool m_stop = false;
+};
+
+} // namespace Slang
+
+#endif
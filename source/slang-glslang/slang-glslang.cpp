@@ -6,6 +6,7 @@
 #include "glslang/Public/ShaderLang.h"
 #include "slang.h"
 #include "spirv-tools/libspirv.h"
+#include "spirv-tools/linker.hpp"
 #include "spirv-tools/optimizer.hpp"
 
 #ifdef _WIN32
@@ -213,6 +214,80 @@ extern "C"
     return true;
 }
 
+// Link the given SPIR-V modules into a single module, resolving imported
+// functions against the exports of the other modules.
+extern "C"
+#ifdef _MSC_VER
+    _declspec(dllexport)
+#else
+    __attribute__((__visibility__("default")))
+#endif
+        bool glslang_linkSPIRV(const glslang_LinkRequest* request)
+{
+    if (!request || request->moduleCount == 0 || !request->outputFunc)
+        return false;
+
+    spvtools::Context context(SPV_ENV_UNIVERSAL_1_5);
+    context.SetMessageConsumer(
+        [request](
+            spv_message_level_t level,
+            const char* source,
+            const spv_position_t& position,
+            const char* message)
+        {
+            SLANG_UNUSED(source);
+            if (!request->diagnosticFunc)
+                return;
+
+            std::stringstream stream;
+            switch (level)
+            {
+            case SPV_MSG_FATAL:
+            case SPV_MSG_INTERNAL_ERROR:
+            case SPV_MSG_ERROR:
+                stream << "error";
+                break;
+            case SPV_MSG_WARNING:
+                stream << "warning";
+                break;
+            default:
+                return;
+            }
+            stream << ": line " << position.index << ": " << message << "\n";
+
+            const std::string text = stream.str();
+            request->diagnosticFunc(text.data(), text.size(), request->diagnosticUserData);
+        });
+
+    std::vector<const uint32_t*> binaries(
+        request->modules,
+        request->modules + request->moduleCount);
+    std::vector<size_t> binarySizes(
+        request->moduleSizes,
+        request->moduleSizes + request->moduleCount);
+
+    spvtools::LinkerOptions options;
+    // We want a complete module, so every import must be resolved. Exports that
+    // are not referenced are fine, and are just carried along.
+    options.SetCreateLibrary(false);
+    options.SetAllowPartialLinkage(false);
+
+    std::vector<uint32_t> linked;
+    if (spvtools::Link(
+            context,
+            binaries.data(),
+            binarySizes.data(),
+            binaries.size(),
+            &linked,
+            options) != SPV_SUCCESS)
+    {
+        return false;
+    }
+
+    request->outputFunc(linked.data(), linked.size() * sizeof(uint32_t), request->outputUserData);
+    return true;
+}
+
 // Apply the SPIRV-Tools optimizer to generated SPIR-V based on the desired optimization level
 // TODO: add flag for optimizing SPIR-V size as well
 static void glslang_optimizeSPIRV(
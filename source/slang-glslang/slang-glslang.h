@@ -158,4 +158,24 @@ typedef int (*glslang_CompileFunc_1_2)(glslang_CompileRequest_1_2* request);
 typedef bool (*glslang_ValidateSPIRVFunc)(const uint32_t* contents, int contentsSize);
 typedef bool (*glslang_DisassembleSPIRVFunc)(const uint32_t* contents, int contentsSize);
 
+/// Describes a set of SPIR-V modules to be linked into a single module.
+///
+/// Imported symbols (decorated with `LinkageAttributes` of type `Import`) in any
+/// module are resolved against the exported symbols of the others, and the
+/// result is a complete (non-library) module.
+struct glslang_LinkRequest
+{
+    const uint32_t* const* modules; ///< The SPIR-V words of each module
+    const size_t* moduleSizes;      ///< The size of each module, in words
+    size_t moduleCount;
+
+    glslang_OutputFunc outputFunc; ///< Receives the linked SPIR-V
+    void* outputUserData;
+
+    glslang_OutputFunc diagnosticFunc; ///< Receives any linker diagnostics
+    void* diagnosticUserData;
+};
+
+typedef bool (*glslang_LinkSPIRVFunc)(const glslang_LinkRequest* request);
+
 #endif
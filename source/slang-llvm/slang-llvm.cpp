@@ -147,6 +147,18 @@ public:
         SLANG_UNUSED(contentsSize);
         return SLANG_FAIL;
     }
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL link(
+        const uint32_t* const* modules,
+        const size_t* moduleSizes,
+        size_t moduleCount,
+        IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        SLANG_UNUSED(modules);
+        SLANG_UNUSED(moduleSizes);
+        SLANG_UNUSED(moduleCount);
+        SLANG_UNUSED(outArtifact);
+        return SLANG_E_NOT_IMPLEMENTED;
+    }
 
     LLVMDownstreamCompiler()
         : m_desc(
@@ -234,6 +234,23 @@ static Slang::String CompilerOptionNameToString(const slang::CompilerOptionName
         CASE(VulkanBindShiftAll);
         CASE(GenerateWholeProgram);
         CASE(UseUpToDateBinaryModule);
+        CASE(DisablePrecompiledPrelude);
+        CASE(AutodiffCheckpointPolicy);
+        CASE(AutodiffCheckpointBudget);
+        CASE(InlineThreshold);
+        CASE(DynamicDispatchProfile);
+        CASE(UnrollSizeLimit);
+        CASE(PartialUnrollFactor);
+        CASE(FastSPIRVOptimization);
+        CASE(ParallelSPIRVFinalization);
+        CASE(ValidateModuleTimestamps);
+        CASE(ModuleDigestCache);
+        CASE(LazyFunctionBodyChecking);
+        CASE(DemandDrivenIRLowering);
+        CASE(EmitReflectionSnapshot);
+        CASE(EmitIRPassTelemetry);
+        CASE(ReflectionSnapshotArtifact);
+        CASE(IRPassTelemetryArtifact);
         CASE(CountOf);
     default:
         Slang::StringBuilder str;
@@ -1,5 +1,8 @@
 // slang-api.cpp
 
+#include "../core/slang-crypto.h"
+#include "../core/slang-file-system.h"
+#include "../core/slang-io.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-platform.h"
 #include "../core/slang-rtti-info.h"
@@ -24,43 +27,110 @@ SLANG_API SlangSession* spCreateSession(const char*)
     return globalSession.detach();
 }
 
-// Attempt to load a previously compiled builtin module from the same file system location as the
-// slang dll. Returns SLANG_OK when the cache is sucessfully loaded. Also returns the filename to
-// the builtin module cache and the timestamp of current slang dll.
-SlangResult tryLoadBuiltinModuleFromCache(
-    slang::IGlobalSession* globalSession,
+// The parts of the name of a builtin module cache file, each a (shortened) hash. The name is
+// `slang-<module>-module-<library>-<build>-<config>.bin`.
+struct BuiltinModuleCacheKey
+{
+    // The location of the slang library
+    Slang::String library;
+    // The build of slang at that location
+    Slang::String build;
+    // The options the global session is created with
+    Slang::String config;
+};
+
+static Slang::String _getCacheKeyPart(Slang::DigestBuilder<Slang::SHA1>& builder)
+{
+    // 64 bits is plenty to tell apart the handful of entries that are in the cache.
+    return Slang::String(builder.finalize().toString().getUnownedSlice().head(16));
+}
+
+static Slang::String _getBuiltinModuleCachePrefix(slang::BuiltinModuleName builtinModuleName)
+{
+    return Slang::String("slang-") + Slang::getBuiltinModuleNameStr(builtinModuleName) + "-module-";
+}
+
+// Calculate the path of the cache file for a compiled builtin module. The cache is in the users
+// cache directory (or the directory set by SLANG_CORE_MODULE_CACHE_PATH), and the file name is
+// made of hashes of everything that determines the compiled module - the build of slang and the
+// options the global session is created with. A rebuild or different options never see a stale
+// module.
+static SlangResult _calcBuiltinModuleCachePath(
+    const SlangGlobalSessionDesc* desc,
     slang::BuiltinModuleName builtinModuleName,
-    Slang::String& outCachePath,
-    uint64_t& outTimestamp)
-{
-    auto fileName =
-        Slang::SharedLibraryUtils::getSharedLibraryFileName((void*)slang_createGlobalSession);
-    uint64_t currentLibTimestamp =
-        Slang::SharedLibraryUtils::getSharedLibraryTimestamp((void*)slang_createGlobalSession);
-    auto dirName = Slang::Path::getParentDirectory(fileName);
-    auto cacheFileName = Slang::Path::combine(
-        dirName,
-        Slang::String("slang-") + Slang::getBuiltinModuleNameStr(builtinModuleName) +
-            "-module.bin");
-    outTimestamp = currentLibTimestamp;
-    outCachePath = cacheFileName;
-    if (currentLibTimestamp == 0)
+    BuiltinModuleCacheKey& outKey,
+    Slang::String& outCachePath)
+{
+    using namespace Slang;
+
+    // Identify the build by the tag, and the location and modification time of the slang library.
+    const uint64_t libTimestamp =
+        SharedLibraryUtils::getSharedLibraryTimestamp((void*)slang_createGlobalSession);
+    if (libTimestamp == 0)
     {
         return SLANG_FAIL;
     }
+
+    {
+        DigestBuilder<SHA1> builder;
+        builder.append(
+            SharedLibraryUtils::getSharedLibraryFileName((void*)slang_createGlobalSession));
+        outKey.library = _getCacheKeyPart(builder);
+    }
+    {
+        DigestBuilder<SHA1> builder;
+        builder.append(UnownedStringSlice(getBuildTagString()));
+        builder.append(libTimestamp);
+        outKey.build = _getCacheKeyPart(builder);
+    }
+    {
+        DigestBuilder<SHA1> builder;
+        builder.append(desc->apiVersion);
+        builder.append(desc->languageVersion);
+        outKey.config = _getCacheKeyPart(builder);
+    }
+
+    StringBuilder cacheDirectory;
+    if (SLANG_FAILED(PlatformUtil::getEnvironmentVariable(
+            toSlice("SLANG_CORE_MODULE_CACHE_PATH"),
+            cacheDirectory)) ||
+        cacheDirectory.getLength() == 0)
+    {
+        cacheDirectory.clear();
+
+        String userCacheDirectory;
+        SLANG_RETURN_ON_FAIL(File::getUserCacheDirectory(userCacheDirectory));
+        cacheDirectory << Path::combine(Path::combine(userCacheDirectory, "slang"), "core-module");
+    }
+
+    StringBuilder fileName;
+    fileName << _getBuiltinModuleCachePrefix(builtinModuleName) << outKey.library << "-"
+             << outKey.build << "-" << outKey.config << ".bin";
+
+    outCachePath = Path::combine(cacheDirectory.produceString(), fileName);
+    return SLANG_OK;
+}
+
+// Attempt to load a previously compiled builtin module from the cache. Returns SLANG_OK when the
+// cache is sucessfully loaded. Also returns the key and path of the builtin module cache file. The
+// path is empty if the module can't be cached.
+SlangResult tryLoadBuiltinModuleFromCache(
+    slang::IGlobalSession* globalSession,
+    const SlangGlobalSessionDesc* desc,
+    slang::BuiltinModuleName builtinModuleName,
+    BuiltinModuleCacheKey& outCacheKey,
+    Slang::String& outCachePath)
+{
+    SLANG_RETURN_ON_FAIL(
+        _calcBuiltinModuleCachePath(desc, builtinModuleName, outCacheKey, outCachePath));
+
     Slang::ScopedAllocation cacheData;
-    SLANG_RETURN_ON_FAIL(Slang::File::readAllBytes(cacheFileName, cacheData));
+    SLANG_RETURN_ON_FAIL(Slang::File::readAllBytes(outCachePath, cacheData));
 
-    // The first 8 bytes stores the timestamp of the slang dll that created this core module cache.
-    if (cacheData.getSizeInBytes() < sizeof(uint64_t))
-        return SLANG_FAIL;
-    auto cacheTimestamp = *(uint64_t*)(cacheData.getData());
-    if (cacheTimestamp != currentLibTimestamp)
-        return SLANG_FAIL;
     SLANG_RETURN_ON_FAIL(globalSession->loadBuiltinModule(
         builtinModuleName,
-        (uint8_t*)cacheData.getData() + sizeof(uint64_t),
-        cacheData.getSizeInBytes() - sizeof(uint64_t)));
+        cacheData.getData(),
+        cacheData.getSizeInBytes()));
     return SLANG_OK;
 }
 
@@ -93,24 +163,65 @@ SlangResult tryLoadBuiltinModuleFromDLL(
 SlangResult trySaveBuiltinModuleToCache(
     slang::IGlobalSession* globalSession,
     slang::BuiltinModuleName builtinModuleName,
-    const Slang::String& cacheFilename,
-    uint64_t dllTimestamp)
+    const BuiltinModuleCacheKey& cacheKey,
+    const Slang::String& cachePath)
 {
-    if (dllTimestamp != 0 && cacheFilename.getLength() != 0)
+    using namespace Slang;
+
+    if (cachePath.getLength() == 0)
+    {
+        return SLANG_OK;
+    }
+
+    ComPtr<ISlangBlob> moduleBlob;
+    SLANG_RETURN_ON_FAIL(globalSession->saveBuiltinModule(
+        builtinModuleName,
+        SLANG_ARCHIVE_TYPE_RIFF_LZ4,
+        moduleBlob.writeRef()));
+
+    const String cacheDirectory = Path::getParentDirectory(cachePath);
+    Path::createDirectoryRecursive(cacheDirectory);
+
+    // Other processes may be starting up concurrently, so the file is written atomically. If
+    // several write it, the contents are the same whoever wins.
+    SLANG_RETURN_ON_FAIL(File::writeAllBytesAtomically(
+        cachePath,
+        moduleBlob->getBufferPointer(),
+        moduleBlob->getBufferSize()));
+
+    // Remove modules cached by earlier builds of this library, otherwise every rebuild of slang
+    // would leave another one behind. Entries for other libraries (such as other installs or
+    // build directories sharing the cache) and for other options of this build are kept.
+    struct Context
+    {
+        String directory;
+        String libraryPrefix;
+        String buildPrefix;
+        List<String> removePaths;
+    };
+    Context context;
+    context.directory = cacheDirectory;
+    context.libraryPrefix =
+        _getBuiltinModuleCachePrefix(builtinModuleName) + cacheKey.library + "-";
+    context.buildPrefix = context.libraryPrefix + cacheKey.build + "-";
+
+    auto fileSystem = OSFileSystem::getMutableSingleton();
+    fileSystem->enumeratePathContents(
+        cacheDirectory.getBuffer(),
+        [](SlangPathType pathType, const char* fileName, void* userData)
+        {
+            auto context = (Context*)userData;
+            const UnownedStringSlice name(fileName);
+            if (pathType == SLANG_PATH_TYPE_FILE && name.startsWith(context->libraryPrefix) &&
+                !name.startsWith(context->buildPrefix) && name.endsWith(toSlice(".bin")))
+            {
+                context->removePaths.add(Path::combine(context->directory, name));
+            }
+        },
+        &context);
+    for (const auto& path : context.removePaths)
     {
-        Slang::ComPtr<ISlangBlob> coreModuleBlobPtr;
-        SLANG_RETURN_ON_FAIL(globalSession->saveBuiltinModule(
-            builtinModuleName,
-            SLANG_ARCHIVE_TYPE_RIFF_LZ4,
-            coreModuleBlobPtr.writeRef()));
-
-        Slang::FileStream fileStream;
-        SLANG_RETURN_ON_FAIL(fileStream.init(cacheFilename, Slang::FileMode::Create));
-
-        SLANG_RETURN_ON_FAIL(fileStream.write(&dllTimestamp, sizeof(dllTimestamp)));
-        SLANG_RETURN_ON_FAIL(fileStream.write(
-            coreModuleBlobPtr->getBufferPointer(),
-            coreModuleBlobPtr->getBufferSize()))
+        File::remove(path);
     }
 
     return SLANG_OK;
@@ -149,17 +260,18 @@ SLANG_API SlangResult slang_createGlobalSession2(
     }
     else
     {
-        Slang::String cacheFilename;
-        uint64_t dllTimestamp = 0;
+        BuiltinModuleCacheKey cacheKey;
+        Slang::String cachePath;
 #define SLANG_PROFILE_CORE_MODULE_COMPILE 0
 #if SLANG_PROFILE_CORE_MODULE_COMPILE
         auto startTime = std::chrono::high_resolution_clock::now();
 #else
         if (tryLoadBuiltinModuleFromCache(
                 globalSession,
+                desc,
                 slang::BuiltinModuleName::Core,
-                cacheFilename,
-                dllTimestamp) != SLANG_OK)
+                cacheKey,
+                cachePath) != SLANG_OK)
 #endif
         {
             // Compile std lib from embeded source.
@@ -173,24 +285,25 @@ SLANG_API SlangResult slang_createGlobalSession2(
             trySaveBuiltinModuleToCache(
                 globalSession,
                 slang::BuiltinModuleName::Core,
-                cacheFilename,
-                dllTimestamp);
+                cacheKey,
+                cachePath);
         }
     }
 
     if (desc->enableGLSL)
     {
-        Slang::String cacheFilename;
-        uint64_t dllTimestamp = 0;
+        BuiltinModuleCacheKey cacheKey;
+        Slang::String cachePath;
         if (SLANG_SUCCEEDED(
                 tryLoadBuiltinModuleFromDLL(globalSession, slang::BuiltinModuleName::GLSL)))
         {
         }
         else if (SLANG_SUCCEEDED(tryLoadBuiltinModuleFromCache(
                      globalSession,
+                     desc,
                      slang::BuiltinModuleName::GLSL,
-                     cacheFilename,
-                     dllTimestamp)))
+                     cacheKey,
+                     cachePath)))
         {
         }
         else
@@ -202,8 +315,8 @@ SLANG_API SlangResult slang_createGlobalSession2(
             trySaveBuiltinModuleToCache(
                 globalSession,
                 slang::BuiltinModuleName::GLSL,
-                cacheFilename,
-                dllTimestamp);
+                cacheKey,
+                cachePath);
         }
     }
 
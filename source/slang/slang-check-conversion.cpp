@@ -1789,8 +1789,17 @@ bool SemanticsVisitor::canCoerce(
                 *outCost = cost;
             return cost != kConversionCost_Impossible;
         }
-        else
-            shouldAddToCache = true;
+
+        // Another linkage may already have worked out the conversion.
+        auto sharedCache = getShared()->getSharedTypeCheckingCache();
+        if (sharedCache && sharedCache->tryGetConversionCost(cacheKey, cost))
+        {
+            typeCheckingCache->conversionCostCache[cacheKey] = cost;
+            if (outCost)
+                *outCost = cost;
+            return cost != kConversionCost_Impossible;
+        }
+        shouldAddToCache = true;
     }
 
     // If there was no suitable entry in the cache,
@@ -1812,6 +1821,8 @@ bool SemanticsVisitor::canCoerce(
         if (!rs)
             cost = kConversionCost_Impossible;
         typeCheckingCache->conversionCostCache[cacheKey] = cost;
+        if (auto sharedCache = getShared()->getSharedTypeCheckingCache())
+            sharedCache->addConversionCost(cacheKey, cost);
     }
 
     return rs;
@@ -1298,14 +1298,39 @@ void SemanticsVisitor::ensureDecl(Decl* decl, DeclCheckState state, SemanticsCon
     decl->checkState.setIsBeingChecked(false);
 }
 
+/// Can checking the body of `decl` be left until the body is needed?
+///
+/// Entry points are always checked, because they are the roots that reachable
+/// code is found from.
+///
+static bool _canDeferFunctionBodyCheck(Decl* decl)
+{
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    return funcDecl && funcDecl->body && !funcDecl->hasModifier<EntryPointAttribute>();
+}
+
 /// Recursively ensure the tree of declarations under `decl` is in `state`.
 ///
 /// This function does *not* handle declarations nested in function bodies
 /// because those cannot be meaningfully checked outside of the context
 /// of their surrounding statement(s).
 ///
-void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
+void SemanticsVisitor::ensureAllDeclsRec(
+    Decl* decl,
+    DeclCheckState state,
+    bool deferFunctionBodies)
 {
+    // A deferred function is only checked up to the state before its body is checked.
+    // Its body is checked by capability inference when checked code references it,
+    // or by `ensureFunctionBodyChecked` when it is lowered to IR.
+    //
+    if (deferFunctionBodies && state > DeclCheckState::AttributesChecked &&
+        _canDeferFunctionBodyCheck(decl))
+    {
+        ensureDecl(decl, DeclCheckState::AttributesChecked);
+        return;
+    }
+
     // Ensure `decl` itself first.
     ensureDecl(decl, state);
 
@@ -1331,7 +1356,7 @@ void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
             if (as<ScopeDecl>(childDecl))
                 continue;
 
-            ensureAllDeclsRec(childDecl, state);
+            ensureAllDeclsRec(childDecl, state, deferFunctionBodies);
         }
     }
 
@@ -1342,10 +1367,41 @@ void SemanticsVisitor::ensureAllDeclsRec(Decl* decl, DeclCheckState state)
     //
     if (auto genericDecl = as<GenericDecl>(decl))
     {
-        ensureAllDeclsRec(genericDecl->inner, state);
+        ensureAllDeclsRec(genericDecl->inner, state, deferFunctionBodies);
     }
 }
 
+bool ensureFunctionBodyChecked(Linkage* linkage, FunctionDeclBase* decl, DiagnosticSink* sink)
+{
+    if (decl->isChecked(DeclCheckState::DefinitionChecked) || decl->checkState.isBeingChecked())
+        return true;
+
+    auto module = getModule(decl);
+    if (!module || !module->hasDeferredFunctionBodies())
+        return true;
+
+    // The bodies are checked with the context the module was checked with, so it is
+    // only created here if the module's checking didn't leave one.
+    auto sharedSemanticsContext = module->getSemanticsForDeferredFunctionBodies();
+    if (!sharedSemanticsContext)
+    {
+        sharedSemanticsContext = new SharedSemanticsContext(linkage, module, nullptr);
+        module->setSemanticsForDeferredFunctionBodies(sharedSemanticsContext);
+    }
+
+    // Diagnostics go to whoever needs the body, restoring the previous sink
+    // once done, as checking a body can lead to checking another.
+    auto prevSink = sharedSemanticsContext->m_sink;
+    sharedSemanticsContext->m_sink = sink;
+
+    const auto errorCountBefore = sink->getErrorCount();
+    SemanticsVisitor visitor(sharedSemanticsContext);
+    visitor.ensureDecl(decl, DeclCheckState::CapabilityChecked);
+
+    sharedSemanticsContext->m_sink = prevSink;
+    return sink->getErrorCount() == errorCountBefore;
+}
+
 bool isUnsizedArrayType(Type* type)
 {
     // Not an array?
@@ -3293,6 +3349,14 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         moduleDecl->defaultVisibility = DeclVisibility::Public;
     }
 
+    // Read the sources of everything this module imports up front, so that
+    // the loads triggered below find them already in the source manager.
+    //
+    if (auto linkage = getLinkage())
+    {
+        linkage->prefetchImportedModuleSources(moduleDecl);
+    }
+
     // We need/want to visit any `import` declarations before
     // anything else, to make sure that scoping works.
     //
@@ -3408,6 +3472,15 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
             break;
     }
 
+    // The bodies of functions in an imported module can be left until the
+    // functions are used, if the user asked for that.
+    //
+    const bool deferFunctionBodies =
+        moduleDecl->module && moduleDecl->module->isLoadedByImport() &&
+        getOptionSet().getBoolOption(CompilerOptionName::LazyFunctionBodyChecking);
+    if (deferFunctionBodies)
+        moduleDecl->module->setHasDeferredFunctionBodies(true);
+
     // With extensions taken care of, we can now check the remaining decls.
     for (auto s : states)
     {
@@ -3425,11 +3498,11 @@ void SemanticsDeclVisitorBase::checkModule(ModuleDecl* moduleDecl)
         // to the subset of declarations coming from a given source
         // file.
         //
-        ensureAllDeclsRec(moduleDecl, s);
+        ensureAllDeclsRec(moduleDecl, s, deferFunctionBodies);
     }
 
     // Once we have completed the above loop, all declarations not
-    // nested in function bodies should be in `DeclState::Checked`.
+    // nested in function bodies (or deferred) should be in `DeclState::Checked`.
     // Furthermore, because a fully checked function will have checked
     // its body, this also means that all function bodies and the
     // declarations they contain should be fully checked.
@@ -10897,6 +10970,13 @@ void SharedSemanticsContext::registerCandidateExtension(
     //
     _getCandidateExtensionList(typeDecl, m_mapTypeDeclToCandidateExtensions).add(extDecl);
 
+    // Results shared between linkages assume core module types are only extended by the core
+    // module, so they can no longer be used.
+    if (_isExtensionOfCoreModuleType(typeDecl, extDecl))
+    {
+        m_canChangeCoreModuleResults = true;
+    }
+
     // Remove the cached inheritanceInfo about typeDecl, if `extDecl` inherits new types.
     bool invalidateSubtypes = false;
     if (as<InterfaceDecl>(typeDecl))
@@ -11020,6 +11100,119 @@ void SharedSemanticsContext::_addCandidateExtensionsFromModule(ModuleDecl* modul
     }
 }
 
+bool SharedSemanticsContext::_isCoreModule(ModuleDecl* moduleDecl)
+{
+    for (auto module : getSession()->coreModules)
+    {
+        if (module->getModuleDecl() == moduleDecl)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SharedSemanticsContext::_isExtensionOfCoreModuleType(
+    AggTypeDecl* typeDecl,
+    ExtensionDecl* extDecl)
+{
+    auto typeModuleDecl = getModuleDecl(typeDecl);
+    return typeModuleDecl != getModuleDecl(extDecl) && _isCoreModule(typeModuleDecl);
+}
+
+/// True if `containerDecl`, or a file, namespace or extension within it, declares an operator
+/// overload
+static bool _declaresOperatorOverloads(ContainerDecl* containerDecl)
+{
+    for (auto member : containerDecl->members)
+    {
+        if (as<FileDecl>(member) || as<NamespaceDecl>(member) || as<ExtensionDecl>(member))
+        {
+            if (_declaresOperatorOverloads(as<ContainerDecl>(member)))
+            {
+                return true;
+            }
+            continue;
+        }
+
+        Decl* innerDecl = member;
+        if (auto genericDecl = as<GenericDecl>(member))
+        {
+            innerDecl = genericDecl->inner;
+        }
+
+        // Operator overloads are named after the operator token (eg `+`), which
+        // can't be the name of any other function.
+        auto name = innerDecl ? innerDecl->getName() : nullptr;
+        if (name && as<FuncDecl>(innerDecl))
+        {
+            const auto text = getText(name);
+            if (text.getLength() && !CharUtil::isAlphaOrDigit(text[0]) && text[0] != '_')
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool SharedSemanticsContext::_canModuleChangeCoreModuleResults(ModuleDecl* moduleDecl)
+{
+    if (!moduleDecl || _isCoreModule(moduleDecl))
+    {
+        return false;
+    }
+    for (auto& [entryKey, entryValue] : moduleDecl->mapTypeToCandidateExtensions)
+    {
+        for (auto extDecl : entryValue->candidateExtensions)
+        {
+            if (_isExtensionOfCoreModuleType(entryKey, extDecl))
+            {
+                return true;
+            }
+        }
+    }
+    return _declaresOperatorOverloads(moduleDecl);
+}
+
+SharedTypeCheckingCache* SharedSemanticsContext::getSharedTypeCheckingCache()
+{
+    // Check any modules that have become visible since we last looked. Which modules are visible
+    // follows the same logic as `getCandidateExtensionsForTypeDecl`.
+    if (!m_canChangeCoreModuleResults)
+    {
+        if (m_module)
+        {
+            if (!m_checkedPrimaryModule)
+            {
+                m_checkedPrimaryModule = true;
+                m_canChangeCoreModuleResults =
+                    _canModuleChangeCoreModuleResults(m_module->getModuleDecl());
+            }
+            for (; m_checkedVisibleModuleCount < importedModulesList.getCount() &&
+                   !m_canChangeCoreModuleResults;
+                 ++m_checkedVisibleModuleCount)
+            {
+                m_canChangeCoreModuleResults = _canModuleChangeCoreModuleResults(
+                    importedModulesList[m_checkedVisibleModuleCount]);
+            }
+        }
+        else
+        {
+            const auto& loadedModules = m_linkage->loadedModulesList;
+            for (; m_checkedVisibleModuleCount < loadedModules.getCount() &&
+                   !m_canChangeCoreModuleResults;
+                 ++m_checkedVisibleModuleCount)
+            {
+                m_canChangeCoreModuleResults = _canModuleChangeCoreModuleResults(
+                    loadedModules[m_checkedVisibleModuleCount]->getModuleDecl());
+            }
+        }
+    }
+
+    return m_canChangeCoreModuleResults ? nullptr : getSession()->getSharedTypeCheckingCache();
+}
+
 /// Get a reference to the associated decl list for `decl` in the given dictionary
 ///
 /// Note: this function creates an empty list of candidates for the given type if
@@ -9,6 +9,8 @@
 #include "slang-compiler.h"
 #include "slang-visitor.h"
 
+#include <mutex>
+
 namespace Slang
 {
 template<typename P, typename... Args>
@@ -614,6 +616,87 @@ struct ImplicitCastMethodKey
     }
 };
 
+/// Type checking results that only involve core module types, shared by all the linkages of a
+/// session, so that every linkage doesn't have to derive the same facts again.
+///
+/// It is consulted when the caches of a `Linkage` or `SharedSemanticsContext` miss, as long as no
+/// module visible to the checking extends a core module type (which could change the results).
+/// A result is only added if every AST node it refers to is owned by the global AST builder, so
+/// an entry can never refer to a linkage that has been destroyed. Checking the core module
+/// itself adds results, so a session whose core module is compiled starts with a populated cache.
+///
+/// Unlike other type checking state, this is accessed from multiple threads.
+class SharedTypeCheckingCache : public RefObject
+{
+public:
+    struct Stats
+    {
+        /// Number of lookups that found a result
+        Count hitCount = 0;
+        /// Number of lookups that didn't
+        Count missCount = 0;
+        /// Number of results held
+        Count entryCount = 0;
+    };
+
+    bool tryGetConversionCost(const BasicTypeKeyPair& key, ConversionCost& outCost);
+    void addConversionCost(const BasicTypeKeyPair& key, ConversionCost cost);
+
+    bool tryGetOperatorOverload(
+        const OperatorOverloadCacheKey& key,
+        OverloadCandidate& outCandidate);
+    void addOperatorOverload(const OperatorOverloadCacheKey& key, const OverloadCandidate& candidate);
+
+    bool tryGetImplicitCastMethod(const ImplicitCastMethodKey& key, ImplicitCastMethod& outMethod);
+    void addImplicitCastMethod(const ImplicitCastMethodKey& key, const ImplicitCastMethod& method);
+
+    bool tryGetSubtypeWitness(Type* sub, Type* sup, SubtypeWitness*& outWitness);
+    /// Only successful subtype tests are shared.
+    void addSubtypeWitness(Type* sub, Type* sup, SubtypeWitness* witness);
+
+    Stats getStats();
+    void resetStats();
+
+    SharedTypeCheckingCache(ASTBuilder* globalASTBuilder)
+        : m_globalASTBuilder(globalASTBuilder)
+    {
+    }
+
+protected:
+    struct TypePair
+    {
+        Type* sub;
+        Type* sup;
+        HashCode getHashCode() const
+        {
+            return combineHash(Slang::getHashCode(sub), Slang::getHashCode(sup));
+        }
+        bool operator==(const TypePair& other) const
+        {
+            return sub == other.sub && sup == other.sup;
+        }
+    };
+
+    /// True if `val` is owned by the global AST builder (or is null)
+    bool _isShareable(Val* val);
+    bool _isShareable(const OverloadCandidate& candidate);
+
+    template<typename K, typename V>
+    bool _tryGet(const Dictionary<K, V>& dict, const K& key, V& outValue);
+    template<typename K, typename V>
+    void _add(Dictionary<K, V>& dict, const K& key, const V& value);
+
+    ASTBuilder* m_globalASTBuilder;
+
+    std::mutex m_mutex;
+    Stats m_stats;
+
+    Dictionary<BasicTypeKeyPair, ConversionCost> m_conversionCosts;
+    Dictionary<OperatorOverloadCacheKey, OverloadCandidate> m_operatorOverloads;
+    Dictionary<ImplicitCastMethodKey, ImplicitCastMethod> m_implicitCastMethods;
+    Dictionary<TypePair, SubtypeWitness*> m_subtypeWitnesses;
+};
+
 /// Used to track offsets for atomic counter storage qualifiers.
 struct GLSLBindingOffsetTracker
 {
@@ -693,6 +776,11 @@ public:
     /// Register a candidate extension `extDecl` for `typeDecl` encountered during checking.
     void registerCandidateExtension(AggTypeDecl* typeDecl, ExtensionDecl* extDecl);
 
+    /// Get the session's cache of type checking results that can be shared between linkages.
+    /// Returns nullptr if results can't be shared from this context, because a module visible
+    /// to it extends a core module type.
+    SharedTypeCheckingCache* getSharedTypeCheckingCache();
+
     void registerAssociatedDecl(Decl* original, DeclAssociationKind assoc, Decl* declaration);
 
     List<RefPtr<DeclAssociation>> const& getAssociatedDeclsForDecl(Decl* decl);
@@ -744,20 +832,41 @@ public:
     bool tryGetSubtypeWitnessFromCache(Type* sub, Type* sup, SubtypeWitness*& outWitness)
     {
         auto pair = TypePair{sub, sup};
-        return m_mapTypePairToSubtypeWitness.tryGetValue(pair, outWitness);
+        if (m_mapTypePairToSubtypeWitness.tryGetValue(pair, outWitness))
+            return true;
+        auto sharedCache = getSharedTypeCheckingCache();
+        if (sharedCache && sharedCache->tryGetSubtypeWitness(sub, sup, outWitness))
+        {
+            m_mapTypePairToSubtypeWitness[pair] = outWitness;
+            return true;
+        }
+        return false;
     }
     void cacheSubtypeWitness(Type* sub, Type* sup, SubtypeWitness*& outWitness)
     {
         auto pair = TypePair{sub, sup};
         m_mapTypePairToSubtypeWitness[pair] = outWitness;
+        if (auto sharedCache = getSharedTypeCheckingCache())
+            sharedCache->addSubtypeWitness(sub, sup, outWitness);
     }
     ImplicitCastMethod* tryGetImplicitCastMethod(ImplicitCastMethodKey key)
     {
-        return m_mapTypePairToImplicitCastMethod.tryGetValue(key);
+        if (auto found = m_mapTypePairToImplicitCastMethod.tryGetValue(key))
+            return found;
+        ImplicitCastMethod method;
+        auto sharedCache = getSharedTypeCheckingCache();
+        if (sharedCache && sharedCache->tryGetImplicitCastMethod(key, method))
+        {
+            m_mapTypePairToImplicitCastMethod[key] = method;
+            return m_mapTypePairToImplicitCastMethod.tryGetValue(key);
+        }
+        return nullptr;
     }
     void cacheImplicitCastMethod(ImplicitCastMethodKey key, ImplicitCastMethod candidate)
     {
         m_mapTypePairToImplicitCastMethod[key] = candidate;
+        if (auto sharedCache = getSharedTypeCheckingCache())
+            sharedCache->addImplicitCastMethod(key, candidate);
     }
 
     bool* isCStyleType(Type* type) { return m_isCStyleTypeCache.tryGetValue(type); }
@@ -781,6 +890,22 @@ private:
     /// Add candidate extensions declared in `moduleDecl` to `m_mapTypeDeclToCandidateExtensions`
     void _addCandidateExtensionsFromModule(ModuleDecl* moduleDecl);
 
+    /// True if `moduleDecl` is one of the core modules
+    bool _isCoreModule(ModuleDecl* moduleDecl);
+    /// True if `extDecl` extends `typeDecl`, a type declared in a core module, from another module
+    bool _isExtensionOfCoreModuleType(AggTypeDecl* typeDecl, ExtensionDecl* extDecl);
+    /// True if `moduleDecl` extends core module types, or declares operator overloads, either of
+    /// which can change the results of checking that only involves core module types.
+    bool _canModuleChangeCoreModuleResults(ModuleDecl* moduleDecl);
+
+    /// Set once a module visible to this context is found that can change the results of checking
+    /// core module types, at which point the shared type checking cache can't be used.
+    bool m_canChangeCoreModuleResults = false;
+    /// True once `m_module` has been checked with `_canModuleChangeCoreModuleResults`
+    bool m_checkedPrimaryModule = false;
+    /// The number of visible modules that have been checked with `_canModuleChangeCoreModuleResults`
+    Index m_checkedVisibleModuleCount = 0;
+
     /// Mapping from a decl to additional declarations of the same decl.
     /// The additional declarations provide a location to hold extra decorations.
     OrderedDictionary<Decl*, RefPtr<DeclAssociationList>> m_mapDeclToAssociatedDecls;
@@ -1399,7 +1524,9 @@ public:
         ensureDecl(declRef->getDecl(), state);
     }
 
-    void ensureAllDeclsRec(Decl* decl, DeclCheckState state);
+    /// Recursively ensure the tree of declarations under `decl` is in `state`. If
+    /// `deferFunctionBodies` is set, function bodies are left to be checked on demand.
+    void ensureAllDeclsRec(Decl* decl, DeclCheckState state, bool deferFunctionBodies = false);
 
     /// Helper routine allowing `ensureDecl` to be used on a `DeclBase`
     ///
@@ -2510,11 +2510,18 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
         if (key.fromOperatorExpr(opExpr))
         {
             OverloadCandidate candidate;
+            auto sharedCache = getShared()->getSharedTypeCheckingCache();
             if (typeCheckingCache->resolvedOperatorOverloadCache.tryGetValue(key, candidate))
             {
                 context.bestCandidateStorage = candidate;
                 context.bestCandidate = &context.bestCandidateStorage;
             }
+            else if (sharedCache && sharedCache->tryGetOperatorOverload(key, candidate))
+            {
+                typeCheckingCache->resolvedOperatorOverloadCache[key] = candidate;
+                context.bestCandidateStorage = candidate;
+                context.bestCandidate = &context.bestCandidateStorage;
+            }
             else
             {
                 shouldAddToCache = true;
@@ -2722,7 +2729,11 @@ Expr* SemanticsVisitor::ResolveInvoke(InvokeExpr* expr)
         // We will report errors for this one candidate, then, to give
         // the user the most help we can.
         if (shouldAddToCache)
+        {
             typeCheckingCache->resolvedOperatorOverloadCache[key] = *context.bestCandidate;
+            if (auto sharedCache = getShared()->getSharedTypeCheckingCache())
+                sharedCache->addOperatorOverload(key, *context.bestCandidate);
+        }
 
         // Now that we have resolved the overload candidate, we need to undo an `openExistential`
         // operation that was applied to `out` arguments.
@@ -5,6 +5,7 @@
 // checking that don't cleanly land in one of the more
 // specialized `slang-check-*` files.
 
+#include "../compiler-core/slang-downstream-compiler-cache.h"
 #include "../core/slang-type-text-util.h"
 #include "slang-check-impl.h"
 
@@ -165,6 +166,16 @@ IDownstreamCompiler* Session::getOrLoadDownstreamCompiler(
             DownstreamCompilerUtil::MatchType::Newest,
             desc);
     }
+
+    // Put the cache in front of the compiler, if caching is enabled
+    if (compiler && m_downstreamCompilerCache)
+    {
+        ComPtr<IDownstreamCompiler> cachingCompiler(
+            new CachingDownstreamCompiler(compiler, m_downstreamCompilerCache));
+        m_downstreamCompilers[int(type)] = cachingCompiler;
+        return cachingCompiler;
+    }
+
     m_downstreamCompilers[int(type)] = compiler;
     return compiler;
 }
@@ -175,14 +186,15 @@ void checkTranslationUnit(
 {
     SLANG_AST_BUILDER_RAII(translationUnit->compileRequest->getLinkage()->getASTBuilder());
 
-    SharedSemanticsContext sharedSemanticsContext(
+    auto module = translationUnit->getModule();
+    RefPtr<SharedSemanticsContext> sharedSemanticsContext = new SharedSemanticsContext(
         translationUnit->compileRequest->getLinkage(),
-        translationUnit->getModule(),
+        module,
         translationUnit->compileRequest->getSink(),
         &loadedModules,
         translationUnit);
 
-    SemanticsDeclVisitorBase visitor((SemanticsContext(&sharedSemanticsContext)));
+    SemanticsDeclVisitorBase visitor((SemanticsContext(sharedSemanticsContext)));
 
     // Apply the visitor to do the main semantic
     // checking that is required on all declarations
@@ -190,7 +202,19 @@ void checkTranslationUnit(
 
     visitor.checkModule(translationUnit->getModuleDecl());
 
-    translationUnit->getModule()->_collectShaderParams();
+    // Deferred function bodies are checked with the same context, so that what it
+    // has learned about the module isn't worked out again for each body. The state
+    // that only lives as long as the front-end request is dropped.
+    //
+    if (module->hasDeferredFunctionBodies())
+    {
+        sharedSemanticsContext->m_sink = nullptr;
+        sharedSemanticsContext->m_environmentModules = nullptr;
+        sharedSemanticsContext->m_translationUnitRequest = nullptr;
+        module->setSemanticsForDeferredFunctionBodies(sharedSemanticsContext);
+    }
+
+    module->_collectShaderParams();
 }
 
 void SemanticsVisitor::dispatchStmt(Stmt* stmt, SemanticsContext const& context)
@@ -234,4 +258,124 @@ ASTBuilder* semanticsVisitorGetASTBuilder(SemanticsVisitor* sv)
     return sv->getASTBuilder();
 }
 
+bool SharedTypeCheckingCache::_isShareable(Val* val)
+{
+    if (!val)
+        return true;
+    // Vals are deduplicated, so a val owned by the global AST builder is the one found in its
+    // cache. Anything else was created by (and will be destroyed with) some linkage.
+    auto found = m_globalASTBuilder->m_cachedNodes.tryGetValue(ValKey(val));
+    return found && *found == val;
+}
+
+bool SharedTypeCheckingCache::_isShareable(const OverloadCandidate& candidate)
+{
+    // Candidates that hold an expression or breadcrumbs refer to the syntax being checked.
+    if (candidate.status != OverloadCandidate::Status::Applicable || candidate.exprVal ||
+        candidate.item.breadcrumbs)
+        return false;
+    return _isShareable(candidate.item.declRef.declRefBase) &&
+           _isShareable(candidate.funcType) && _isShareable(candidate.resultType) &&
+           _isShareable(candidate.subst.declRef);
+}
+
+template<typename K, typename V>
+bool SharedTypeCheckingCache::_tryGet(const Dictionary<K, V>& dict, const K& key, V& outValue)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (auto found = dict.tryGetValue(key))
+    {
+        m_stats.hitCount++;
+        outValue = *found;
+        return true;
+    }
+    m_stats.missCount++;
+    return false;
+}
+
+template<typename K, typename V>
+void SharedTypeCheckingCache::_add(Dictionary<K, V>& dict, const K& key, const V& value)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (dict.addIfNotExists(key, value))
+        m_stats.entryCount++;
+}
+
+bool SharedTypeCheckingCache::tryGetConversionCost(
+    const BasicTypeKeyPair& key,
+    ConversionCost& outCost)
+{
+    return _tryGet(m_conversionCosts, key, outCost);
+}
+
+void SharedTypeCheckingCache::addConversionCost(const BasicTypeKeyPair& key, ConversionCost cost)
+{
+    // Basic type keys don't refer to any AST nodes, so can always be shared.
+    _add(m_conversionCosts, key, cost);
+}
+
+bool SharedTypeCheckingCache::tryGetOperatorOverload(
+    const OperatorOverloadCacheKey& key,
+    OverloadCandidate& outCandidate)
+{
+    return _tryGet(m_operatorOverloads, key, outCandidate);
+}
+
+void SharedTypeCheckingCache::addOperatorOverload(
+    const OperatorOverloadCacheKey& key,
+    const OverloadCandidate& candidate)
+{
+    if (_isShareable(candidate))
+        _add(m_operatorOverloads, key, candidate);
+}
+
+bool SharedTypeCheckingCache::tryGetImplicitCastMethod(
+    const ImplicitCastMethodKey& key,
+    ImplicitCastMethod& outMethod)
+{
+    return _tryGet(m_implicitCastMethods, key, outMethod);
+}
+
+void SharedTypeCheckingCache::addImplicitCastMethod(
+    const ImplicitCastMethodKey& key,
+    const ImplicitCastMethod& method)
+{
+    // The key must be shareable too, otherwise it could alias types created
+    // later at the same address.
+    if (!_isShareable(key.fromType) || !_isShareable(key.toType))
+        return;
+    if (method.conversionFuncOverloadCandidate.status != OverloadCandidate::Status::Unchecked &&
+        !_isShareable(method.conversionFuncOverloadCandidate))
+        return;
+    _add(m_implicitCastMethods, key, method);
+}
+
+bool SharedTypeCheckingCache::tryGetSubtypeWitness(
+    Type* sub,
+    Type* sup,
+    SubtypeWitness*& outWitness)
+{
+    return _tryGet(m_subtypeWitnesses, TypePair{sub, sup}, outWitness);
+}
+
+void SharedTypeCheckingCache::addSubtypeWitness(Type* sub, Type* sup, SubtypeWitness* witness)
+{
+    if (!witness || !_isShareable(sub) || !_isShareable(sup) || !_isShareable(witness))
+        return;
+    _add(m_subtypeWitnesses, TypePair{sub, sup}, witness);
+}
+
+SharedTypeCheckingCache::Stats SharedTypeCheckingCache::getStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void SharedTypeCheckingCache::resetStats()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stats.hitCount = 0;
+    m_stats.missCount = 0;
+}
+
 } // namespace Slang
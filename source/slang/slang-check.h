@@ -23,6 +23,11 @@ bool isFromCoreModule(Decl* decl);
 
 void registerBuiltinDecls(Session* session, Decl* decl);
 
+/// Check the body of `decl` if that hasn't happened yet, which is possible when
+/// `CompilerOptionName::LazyFunctionBodyChecking` is used. Returns false if checking
+/// the body reported errors.
+bool ensureFunctionBodyChecked(Linkage* linkage, FunctionDeclBase* decl, DiagnosticSink* sink);
+
 Type* unwrapArrayType(Type* type);
 Type* unwrapModifiedType(Type* type);
 
@@ -35,6 +35,20 @@ void CompilerOptionSet::load(uint32_t count, slang::CompilerOptionEntry* entries
                 set(CompilerOptionName::EmitSpirvMethod, SLANG_EMIT_SPIRV_VIA_GLSL);
             }
         }
+        // The IR compression type can be given by name (as on the command line), since
+        // the enum values aren't part of the public API.
+        else if (
+            entries[i].name == slang::CompilerOptionName::IrCompression &&
+            value.kind == CompilerOptionValueKind::String)
+        {
+            SerialCompressionType compressionType;
+            if (SLANG_SUCCEEDED(SerialParseUtil::parseCompressionType(
+                    value.stringValue.getUnownedSlice(),
+                    compressionType)))
+            {
+                set(CompilerOptionName::IrCompression, compressionType);
+            }
+        }
     }
 }
 
@@ -129,6 +143,12 @@ void CompilerOptionSet::writeCommandLineArgs(Session* globalSession, StringBuild
                 sb << " -O" << v.intValue;
             }
             break;
+        case CompilerOptionName::DynamicDispatchProfile: // stringValue: type name; intValue: count
+            for (auto v : option.value)
+            {
+                sb << " -dispatch-profile-entry \"" << v.stringValue << "\" " << v.intValue;
+            }
+            break;
         case CompilerOptionName::DownstreamArgs:
             for (auto v : option.value)
             {
@@ -166,15 +186,26 @@ void CompilerOptionSet::buildHash(DigestBuilder<SHA1>& builder)
 {
     for (auto& kv : options)
     {
+        // Options that only affect how precompiled modules are validated don't change the
+        // output, and must not make a module look out of date.
+        switch (kv.key)
+        {
+        case CompilerOptionName::ValidateModuleTimestamps:
+        case CompilerOptionName::ModuleDigestCache:
+            continue;
+        default:
+            break;
+        }
+
         builder.append(kv.key);
         builder.append(kv.value.getCount());
         for (auto& v : kv.value)
         {
-            if (v.kind == CompilerOptionValueKind::Int)
-            {
-                builder.append(v.intValue);
-            }
-            else
+            // Some string valued options also hold ints (such as the count of a dispatch
+            // profile entry), so the ints are always part of the hash.
+            builder.append(v.intValue);
+            builder.append(v.intValue2);
+            if (v.kind == CompilerOptionValueKind::String)
             {
                 builder.append(v.stringValue);
                 builder.append(v.stringValue2);
@@ -197,6 +228,7 @@ bool CompilerOptionSet::allowDuplicate(CompilerOptionName name)
     case CompilerOptionName::DownstreamArgs:
     case CompilerOptionName::VulkanBindShift:
     case CompilerOptionName::VulkanBindShiftAll:
+    case CompilerOptionName::DynamicDispatchProfile:
         return true;
     }
     return false;
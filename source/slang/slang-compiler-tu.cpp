@@ -89,6 +89,12 @@ static bool attemptPrecompiledExport(IRInst* inst)
  * The original module IR functions matching those are then marked with
  * "AvailableInDownstreamIRDecoration" to indicate to future
  * module users which functions are present in the precompiled blob.
+ *
+ * When a program using the module is compiled, those functions are reduced
+ * to declarations right after IR linking, so only the entry point specific
+ * code is optimized and emitted. The precompiled blob is then linked in by
+ * the downstream compiler: DXC for DXIL, and the SPIR-V linker for SPIR-V
+ * (see `emitSPIRVForEntryPointsDirectly`).
  */
 SLANG_NO_THROW SlangResult SLANG_MCALL
 Module::precompileForTarget(SlangCompileTarget target, slang::IBlob** outDiagnostics)
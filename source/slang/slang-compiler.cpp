@@ -1420,6 +1420,31 @@ SlangResult CodeGenContext::emitWithDownstreamForEntryPoints(ComPtr<IArtifact>&
     // Set the source type
     options.sourceLanguage = SlangSourceLanguage(sourceLanguage);
 
+    // Generated C++ starts with the prelude, which is the same for every compilation. A
+    // downstream compiler that supports it can precompile the prelude once and reuse it.
+    String precompiledHeaderDirectory;
+    if (sourceLanguage == SourceLanguage::CPP &&
+        !getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::DisablePrecompiledPrelude))
+    {
+        // The compiler trusts whatever it finds in the directory, so it must be one that only
+        // the current user can write to.
+        String userCacheDirectory;
+        if (SLANG_SUCCEEDED(File::getUserCacheDirectory(userCacheDirectory)))
+        {
+            precompiledHeaderDirectory =
+                Path::combine(Path::combine(userCacheDirectory, "slang"), "pch");
+        }
+        if (precompiledHeaderDirectory.getLength() &&
+            SLANG_SUCCEEDED(Path::createPrivateDirectory(precompiledHeaderDirectory)))
+        {
+            const String& prelude = getSession()->getPreludeForLanguage(SourceLanguage::CPP);
+            options.precompiledHeaderText = SliceUtil::asTerminatedCharSlice(prelude);
+            options.precompiledHeaderDirectory =
+                SliceUtil::asTerminatedCharSlice(precompiledHeaderDirectory);
+        }
+    }
+
     switch (target)
     {
     case CodeGenTarget::ShaderHostCallable:
@@ -2642,11 +2667,27 @@ bool CodeGenContext::shouldSkipSPIRVValidation()
         CompilerOptionName::SkipSPIRVValidation);
 }
 
+bool CodeGenContext::shouldUseFastSPIRVOptimization()
+{
+    // The fast path is only used at the default optimization level, spirv-opt
+    // doesn't run at all for `-O0`, and `-O2` and above keep using it.
+    auto& optionSet = getTargetProgram()->getOptionSet();
+    return optionSet.getBoolOption(CompilerOptionName::FastSPIRVOptimization) &&
+           optionSet.getEnumOption<OptimizationLevel>(CompilerOptionName::Optimization) ==
+               OptimizationLevel::Default;
+}
+
 bool CodeGenContext::shouldDumpIR()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(CompilerOptionName::DumpIr);
 }
 
+bool CodeGenContext::shouldRecordIRPassTelemetry()
+{
+    return getTargetProgram()->getOptionSet().getBoolOption(
+        CompilerOptionName::IRPassTelemetryArtifact);
+}
+
 bool CodeGenContext::shouldReportCheckpointIntermediates()
 {
     return getTargetProgram()->getOptionSet().getBoolOption(
@@ -2681,10 +2722,21 @@ bool CodeGenContext::isSpecializationDisabled()
         CompilerOptionName::DisableSpecialization);
 }
 
+// Use the linkage's IR compression if one was set, otherwise the default.
+static void _applyIrCompression(Linkage* linkage, SerialContainerUtil::WriteOptions& ioOptions)
+{
+    if (linkage->m_optionSet.hasOption(CompilerOptionName::IrCompression))
+    {
+        ioOptions.compressionType = linkage->m_optionSet.getEnumOption<SerialCompressionType>(
+            CompilerOptionName::IrCompression);
+    }
+}
+
 SLANG_NO_THROW SlangResult SLANG_MCALL Module::serialize(ISlangBlob** outSerializedBlob)
 {
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
+    _applyIrCompression(getLinkage(), writeOptions);
     OwnedMemoryStream memoryStream(FileAccess::Write);
     SLANG_RETURN_ON_FAIL(SerialContainerUtil::write(this, writeOptions, &memoryStream));
     *outSerializedBlob = RawBlob::create(
@@ -2698,6 +2750,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL Module::writeToFile(char const* fileName)
 {
     SerialContainerUtil::WriteOptions writeOptions;
     writeOptions.sourceManager = getLinkage()->getSourceManager();
+    _applyIrCompression(getLinkage(), writeOptions);
     FileStream fileStream;
     SLANG_RETURN_ON_FAIL(fileStream.init(fileName, FileMode::Create));
     return SerialContainerUtil::write(this, writeOptions, &fileStream);
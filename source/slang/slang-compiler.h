@@ -12,9 +12,12 @@
 #include "../core/slang-basic.h"
 #include "../core/slang-command-options.h"
 #include "../core/slang-crypto.h"
+#include "../core/slang-file-digest-cache.h"
 #include "../core/slang-file-system.h"
+#include "../core/slang-persistent-cache.h"
 #include "../core/slang-shared-library.h"
 #include "../core/slang-std-writers.h"
+#include "../core/slang-thread-pool.h"
 #include "slang-capability.h"
 #include "slang-com-ptr.h"
 #include "slang-compiler-options.h"
@@ -1629,6 +1632,7 @@ public:
 
     /// Create a module (initially empty).
     Module(Linkage* linkage, ASTBuilder* astBuilder = nullptr);
+    ~Module();
 
     /// Get the AST for the module (if it has been parsed)
     ModuleDecl* getModuleDecl() { return m_moduleDecl; }
@@ -1664,6 +1668,26 @@ public:
 
     void setPathInfo(PathInfo pathInfo) { m_pathInfo = pathInfo; }
 
+    /// Was the module loaded because another module imports it?
+    bool isLoadedByImport() { return m_isLoadedByImport; }
+    void setIsLoadedByImport(bool value) { m_isLoadedByImport = value; }
+
+    /// Were the function bodies of the module left to be checked on demand?
+    bool hasDeferredFunctionBodies() { return m_hasDeferredFunctionBodies; }
+    void setHasDeferredFunctionBodies(bool value) { m_hasDeferredFunctionBodies = value; }
+
+    /// The semantic checking state used to check the deferred function bodies of the module.
+    SharedSemanticsContext* getSemanticsForDeferredFunctionBodies();
+    void setSemanticsForDeferredFunctionBodies(SharedSemanticsContext* context);
+
+    /// Was the body of `decl` lowered into the IR of this module?
+    ///
+    /// Functions with deferred bodies are only lowered into the IR of the module if
+    /// it references them, and otherwise into the IR of each module using them.
+    ///
+    bool isFunctionBodyLowered(Decl* decl) { return m_functionsWithLoweredBody.contains(decl); }
+    void addFunctionWithLoweredBody(Decl* decl) { m_functionsWithLoweredBody.add(decl); }
+
     /// Set the IR for this module.
     ///
     /// This should only be called once, during creation of the module.
@@ -1792,6 +1816,18 @@ private:
     // A digest that uniquely identifies the contents of the module.
     SHA1::Digest m_digest;
 
+    // True if the module was loaded because another module imports it.
+    bool m_isLoadedByImport = false;
+
+    // True if checking of function bodies was deferred, see `LazyFunctionBodyChecking`.
+    bool m_hasDeferredFunctionBodies = false;
+
+    // The semantic checking state kept to check deferred function bodies with.
+    RefPtr<SharedSemanticsContext> m_semanticsForDeferredFunctionBodies;
+
+    // Functions with deferred bodies whose bodies are in `m_irModule`.
+    HashSet<Decl*> m_functionsWithLoweredBody;
+
     // List of modules this module depends on
     ModuleDependencyList m_moduleDependencyList;
 
@@ -1929,6 +1965,14 @@ enum class FloatingPointMode : SlangFloatingPointModeIntegral
     Precise = SLANG_FLOATING_POINT_MODE_PRECISE,
 };
 
+/// How reverse-mode automatic differentiation decides whether the primal values used to
+/// compute derivatives are stored in the checkpoint context, or recomputed.
+enum class AutodiffCheckpointPolicy
+{
+    Default,   ///< Fixed rules for each kind of instruction
+    CostModel, ///< Trade the memory used against recompute cost, within a memory budget
+};
+
 enum class WriterChannel : SlangWriterChannelIntegral
 {
     Diagnostic = SLANG_WRITER_CHANNEL_DIAGNOSTIC,
@@ -2052,6 +2096,7 @@ SourceLanguage getDefaultSourceLanguageForDownstreamCompiler(PassThroughMode com
 const char* getBuildTagString();
 
 struct TypeCheckingCache;
+class SharedTypeCheckingCache;
 
 struct ContainerTypeKey
 {
@@ -2248,9 +2293,20 @@ public:
     /// or a wrapped impl that makes fileSystem operate as fileSystemExt
     ComPtr<ISlangFileSystemExt> m_fileSystemExt;
 
+    /// Set by `getModuleDigestCache`
+    RefPtr<FileDigestCache> m_moduleDigestCache;
+
     /// Get the currenly set file system
     ISlangFileSystemExt* getFileSystemExt() { return m_fileSystemExt; }
 
+    /// True if files are loaded directly from the OS file system, so that paths found for them
+    /// can be used with OS file functions.
+    bool isUsingOSFileSystem();
+
+    /// Get the cache of source file digests set with `ModuleDigestCache`, loading it on first
+    /// use. Returns nullptr if no cache is set.
+    FileDigestCache* getModuleDigestCache();
+
     /// Load a file into memory using the configured file system.
     ///
     /// @param path The path to attempt to load from
@@ -2311,6 +2367,17 @@ public:
         DiagnosticSink* sink,
         const LoadedModuleDictionary* loadedModules = nullptr);
 
+    /// Read the sources of the modules `moduleDecl` imports, directly and transitively, before
+    /// they are needed.
+    ///
+    /// The import graph is discovered with a light-weight scan of each file. The files are read
+    /// through the linkage's file system, and the files of each level of the graph are scanned
+    /// concurrently. The results are registered with the source manager so the parsing and
+    /// checking of those modules, which stays sequential, finds them already loaded. Nothing is
+    /// diagnosed here; a module that can't be found or read is reported as usual when its
+    /// `import` is checked.
+    void prefetchImportedModuleSources(ModuleDecl* moduleDecl);
+
     void prepareDeserializedModule(
         SerialContainerDataModule& moduleEntry,
         const PathInfo& pathInfo,
@@ -2365,6 +2432,10 @@ public:
     // Modules that have been read in with the -r option
     List<ComPtr<IArtifact>> m_libModules;
 
+    // The number of `import` declarations currently being resolved. Modules loaded
+    // while this is non-zero are dependencies of another module.
+    Index m_importDeclDepth = 0;
+
     void _stopRetainingParentSession() { m_retainedSession = nullptr; }
 
     // Get shared semantics information for reflection purposes.
@@ -2485,6 +2556,10 @@ public:
     // If true will serialize and de-serialize with debug information
     bool verifyDebugSerialization = false;
 
+    // If true then generateIR only lowers the functions of a translation unit that are
+    // reachable from its entry points, because nothing else will use the IR.
+    bool lowerReachableDeclsOnly = false;
+
     CompilerOptionSet optionSet;
 
     List<RefPtr<FrontEndEntryPointRequest>> m_entryPointReqs;
@@ -2859,6 +2934,10 @@ public:
     bool shouldDumpIR();
     bool shouldReportCheckpointIntermediates();
 
+    /// True if `linkAndOptimizeIR` should record the time taken by its passes, and the
+    /// size of the IR after each of them.
+    bool shouldRecordIRPassTelemetry();
+
     bool shouldTrackLiveness();
 
     bool shouldDumpIntermediates();
@@ -2870,6 +2949,9 @@ public:
 
     bool shouldSkipSPIRVValidation();
 
+    /// True if SPIR-V should be cleaned up in-process instead of being passed to spirv-opt.
+    bool shouldUseFastSPIRVOptimization();
+
     SlangResult requireTranslationUnitSourceFiles();
 
     //
@@ -3199,6 +3281,11 @@ public:
     /// the container contents to the file
     SlangResult maybeWriteContainer(const String& fileName);
 
+    /// Can the front end lower only the code reachable from the entry points to IR? This is
+    /// the case if the user asked for it, and the IR of the modules isn't output or
+    /// precompiled.
+    bool _canLowerReachableDeclsOnly();
+
     Linkage* getLinkage() { return m_linkage; }
 
     int addEntryPoint(
@@ -3582,6 +3669,7 @@ public:
     ComPtr<IDownstreamCompiler> m_downstreamCompilers[int(
         PassThroughMode::CountOf)]; ///< A downstream compiler for a pass through
     DownstreamCompilerLocatorFunc m_downstreamCompilerLocators[int(PassThroughMode::CountOf)];
+    RefPtr<PersistentCache> m_downstreamCompilerCache; ///< If set, caches downstream compilations
     Name* m_completionTokenName = nullptr; ///< The name of a completion request token.
 
     /// For parsing command line options
@@ -3589,6 +3677,13 @@ public:
 
     int m_typeDictionarySize = 0;
 
+    /// Type checking results shared by all the linkages of the session
+    SharedTypeCheckingCache* getSharedTypeCheckingCache() { return m_sharedTypeCheckingCache; }
+    RefPtr<SharedTypeCheckingCache> m_sharedTypeCheckingCache;
+
+    /// Worker threads shared by all the compilations of the session. Created on first use.
+    ThreadPool* getThreadPool();
+
 private:
     struct BuiltinModuleInfo
     {
@@ -3611,6 +3706,9 @@ private:
     /// Linkage used for all built-in (core module) code.
     RefPtr<Linkage> m_builtinLinkage;
 
+    std::mutex m_threadPoolMutex;
+    RefPtr<ThreadPool> m_threadPool;
+
     String
         m_downstreamCompilerPaths[int(PassThroughMode::CountOf)]; ///< Paths for each pass through
     String m_languagePreludes[int(SourceLanguage::CountOf)]; ///< Prelude for each source language
@@ -310,6 +310,11 @@ DIAGNOSTIC(
     "downstream compiler '$0' doesn't support whole program compilation")
 DIAGNOSTIC(102, Note, downstreamCompileTime, "downstream compile time: $0s")
 DIAGNOSTIC(103, Note, performanceBenchmarkResult, "compiler performance benchmark:\n$0")
+DIAGNOSTIC(
+    104,
+    Error,
+    invalidDispatchProfileLine,
+    "invalid dispatch profile line '$0', expecting '<type-name> <count>'")
 DIAGNOSTIC(99999, Note, noteFailedToLoadDynamicLibrary, "failed to load dynamic library '$0'")
 
 //
@@ -2117,6 +2122,13 @@ DIAGNOSTIC(
     cannotUnrollLoop,
     "loop does not terminate within the limited number of iterations, unrolling is aborted.")
 
+DIAGNOSTIC(
+    40021,
+    Warning,
+    loopUnrollSizeLimitExceeded,
+    "unrolling the loop exceeds the limit of $0 instructions, the remaining iterations are not "
+    "unrolled. Use '-unroll-size-limit' to raise the limit.")
+
 DIAGNOSTIC(
     40030,
     Fatal,
@@ -2576,6 +2588,11 @@ DIAGNOSTIC(
     outputSpvIsEmpty,
     "output SPIR-V contains no exported symbols. Please make sure to specify at least one "
     "entrypoint.")
+DIAGNOSTIC(
+    57005,
+    Error,
+    spirvLinkFailed,
+    "failed to link the program against precompiled SPIR-V modules.")
 
 // GLSL Compatibility
 DIAGNOSTIC(
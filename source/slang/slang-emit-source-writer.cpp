@@ -25,6 +25,35 @@ SourceWriter::SourceWriter(
     m_sourceManager = sourceManager;
 }
 
+String SourceWriter::getContent()
+{
+    if (m_chunks.getCount() == 0)
+    {
+        return m_builder.produceString();
+    }
+
+    Index length = m_builder.getLength();
+    for (const auto& chunk : m_chunks)
+    {
+        length += chunk.getLength();
+    }
+
+    StringBuilder content;
+    content.ensureCapacity(length);
+    for (const auto& chunk : m_chunks)
+    {
+        content.append(chunk);
+    }
+    content.append(m_builder);
+    return content.produceString();
+}
+
+void SourceWriter::clearContent()
+{
+    m_chunks.clear();
+    m_builder.clear();
+}
+
 String SourceWriter::getContentAndClear()
 {
     String content(getContent());
@@ -32,11 +61,44 @@ String SourceWriter::getContentAndClear()
     return content;
 }
 
+void SourceWriter::appendContentAndClear(List<String>& ioSegments)
+{
+    for (auto& chunk : m_chunks)
+    {
+        ioSegments.add(_Move(chunk));
+    }
+    if (m_builder.getLength())
+    {
+        ioSegments.add(m_builder.produceString());
+    }
+    clearContent();
+}
+
+void SourceWriter::_flushChunk()
+{
+    // The source map locations are calculated from the text of the current chunk, so any
+    // text that hasn't been taken into account yet has to be before it's flushed.
+    if (m_sourceMap)
+    {
+        Index lineIndex, columnIndex;
+        _calcLocation(lineIndex, columnIndex);
+    }
+
+    m_chunks.add(m_builder.produceString());
+    m_builder.clear();
+    m_currentOutputOffset = 0;
+}
+
 void SourceWriter::emitRawTextSpan(char const* textBegin, char const* textEnd)
 {
     // TODO(tfoley): Need to make "corelib" not use `int` for pointer-sized things...
     auto len = textEnd - textBegin;
     m_builder.append(textBegin, len);
+
+    if (m_builder.getLength() >= kChunkSize)
+    {
+        _flushChunk();
+    }
 }
 
 void SourceWriter::emitRawText(char const* text)
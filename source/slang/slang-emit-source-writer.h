@@ -64,11 +64,14 @@ public:
     void advanceToSourceLocationIfValid(const SourceLoc& sourceLocation);
 
     /// Get the content as a string
-    String getContent() { return m_builder.produceString(); }
+    String getContent();
     /// Clear the content
-    void clearContent() { m_builder.clear(); }
+    void clearContent();
     /// Get the content as a string and clear the internal representation
     String getContentAndClear();
+    /// Move the content, as the chunks it is held in, onto the end of `ioSegments` and clear
+    /// the internal representation. Unlike `getContent`, doesn't join the chunks together.
+    void appendContentAndClear(List<String>& ioSegments);
 
     /// Get the line directive mode used
     LineDirectiveMode getLineDirectiveMode() const { return m_lineDirectiveMode; }
@@ -104,11 +107,16 @@ protected:
     /// Calculate the current location in the ouput
     void _calcLocation(Index& outLineIndex, Index& outColumnIndex);
 
-    // The string of code we've built so far.
-    // TODO(JS): We could store the text in chunks, and then only sew together into one buffer
-    // when we are done. Doing so would not require copies/reallocs until the full buffer has been
-    // produced. A downside to doing this is that it won't be so simple to debug by trying to
-    // look at the current contents of the buffer
+    /// Move the current chunk onto `m_chunks` and start a new one
+    void _flushChunk();
+
+    /// The size a chunk can grow to before it is flushed
+    static const Index kChunkSize = 256 * 1024;
+
+    // The code we've built so far is held in chunks, so that large outputs don't need to be
+    // reallocated and copied as they grow. The text of the current chunk is in `m_builder`,
+    // and is the only text that can be seen when debugging.
+    List<String> m_chunks;
     StringBuilder m_builder;
 
     // Current source position for tracking purposes...
@@ -120,6 +128,7 @@ protected:
     // Used to determine the current location in the output for outputting the source map
     // This is separate from m_loc, because m_loc doesn't appear to track the line/column directly
     // in the output stream - for example when #line emits a "raw" emit takes place.
+    // The offset is into the current chunk.
     Count m_currentOutputOffset = 0;
     Index m_currentLineIndex = 0;
     Index m_currentColumnIndex = 0;
@@ -1,6 +1,7 @@
 // slang-emit-spirv.cpp
 
 #include "../core/slang-memory-arena.h"
+#include "../core/slang-performance-profiler.h"
 #include "slang-compiler.h"
 #include "slang-emit-base.h"
 #include "slang-ir-call-graph.h"
@@ -291,6 +292,8 @@ void SpvInstParent::addInst(SpvInst* inst)
     SLANG_ASSERT(inst);
     SLANG_ASSERT(!inst->nextSibling);
 
+    inst->parent = this;
+
     if (m_firstChild == nullptr)
     {
         m_firstChild = m_lastChild = inst;
@@ -303,7 +306,6 @@ void SpvInstParent::addInst(SpvInst* inst)
     //
     m_lastChild->nextSibling = inst;
     inst->prevSibling = m_lastChild;
-    inst->parent = this;
     m_lastChild = inst;
 }
 
@@ -315,6 +317,50 @@ void SpvInstParent::dumpTo(List<SpvWord>& ioWords)
     }
 }
 
+// Functions are emitted into their own `SpvInst` trees, and after emission the work done
+// on one function (e.g., flattening it into words) doesn't touch any other function. When
+// a module has many functions, that work is spread over the session's thread pool.
+//
+// Emitting the function bodies is not parallelized. Emitting a body can create types,
+// constants, capabilities and debug instructions through the maps and sections shared by
+// the whole `SPIRVEmitContext`, and <id>s are allocated as instructions are created, so
+// bodies can't be emitted independently of each other (with pre-assigned <id> ranges)
+// until that shared state is split out of the context.
+
+/// The number of functions a module needs before work is split across threads.
+static const Index kMinFunctionCountForParallelWork = 16;
+
+/// Collect the functions in `section`, if there are enough of them to be worth splitting
+/// the work on them across threads.
+static bool _collectFunctionsForParallelWork(SpvInstParent* section, List<SpvInst*>& outFuncs)
+{
+    for (auto inst = section->m_firstChild; inst; inst = inst->nextSibling)
+        outFuncs.add(inst);
+    return outFuncs.getCount() >= kMinFunctionCountForParallelWork;
+}
+
+/// Flatten `section` into words like `dumpTo`, with the functions flattened on `threadPool`.
+static void _dumpFunctionsInParallel(
+    ThreadPool* threadPool,
+    SpvInstParent* section,
+    List<SpvWord>& ioWords)
+{
+    List<SpvInst*> funcs;
+    if (!_collectFunctionsForParallelWork(section, funcs))
+    {
+        section->dumpTo(ioWords);
+        return;
+    }
+
+    List<List<SpvWord>> funcWords;
+    funcWords.setCount(funcs.getCount());
+    threadPool->parallelFor(funcs.getCount(), [&](Index i) { funcs[i]->dumpTo(funcWords[i]); });
+
+    // Splice the functions back in order, so the output doesn't depend on scheduling.
+    for (auto& words : funcWords)
+        ioWords.addRange(words);
+}
+
 /// The context for inlining a SPV assembly snippet.
 struct SpvSnippetEmitContext
 {
@@ -555,12 +601,26 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
         // Once we are done emitting the header, we emit all
         // the instructions in our logical sections.
         //
+        auto threadPool = getFunctionThreadPool();
         for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
         {
-            m_sections[ii].dumpTo(m_words);
+            if (ii == int(SpvLogicalSectionID::FunctionDefinitions) && threadPool)
+                _dumpFunctionsInParallel(threadPool, &m_sections[ii], m_words);
+            else
+                m_sections[ii].dumpTo(m_words);
         }
     }
 
+    /// Get the thread pool to process emitted functions on, or nullptr to process them
+    /// on the calling thread.
+    ThreadPool* getFunctionThreadPool()
+    {
+        if (!m_targetProgram->getOptionSet().getBoolOption(
+                CompilerOptionName::ParallelSPIRVFinalization))
+            return nullptr;
+        return m_targetProgram->getTargetReq()->getLinkage()->getSessionImpl()->getThreadPool();
+    }
+
     // We will often need to refer to an instrcition by its
     // <id>, given only the Slang IR instruction that represents
     // it (e.g., when it is used as an operand of another
@@ -8175,6 +8235,399 @@ struct SPIRVEmitContext : public SourceEmitterBase, public SPIRVEmitSharedContex
     }
 };
 
+// A fast clean up of the SPIR-V module, done in place of running spirv-opt
+// when compile time matters more than the size of the output.
+//
+// The operands of a `SpvInst` are plain words, and we don't keep track of which
+// of them are <id>s. The passes here are written so that treating any operand word
+// that happens to equal an <id> as a reference to it is always safe: it can only keep
+// something alive, or keep a block from being merged.
+//
+struct SPIRVModuleCleanup
+{
+    SpvLogicalSection* m_sections;
+
+    /// Keep unused global variables, because the user asked to preserve parameters.
+    bool m_preserveGlobalVariables = false;
+
+    /// If set, process the functions of the module on this pool's threads.
+    ThreadPool* m_threadPool = nullptr;
+
+    SpvLogicalSection* getSection(SpvLogicalSectionID id) { return &m_sections[int(id)]; }
+
+    // Dead global elimination.
+
+    Dictionary<SpvWord, SpvInst*> m_globalDefs;
+    HashSet<SpvWord> m_liveIds;
+    List<SpvInst*> m_workList;
+
+    void markLive(SpvWord id)
+    {
+        SpvInst* def = nullptr;
+        if (m_globalDefs.tryGetValue(id, def) && m_liveIds.add(id))
+            m_workList.add(def);
+    }
+
+    /// Mark everything `inst` (or any of its children) may refer to as live.
+    void markOperandsLive(SpvInst* inst)
+    {
+        for (uint32_t i = 0; i < inst->operandWordsCount; i++)
+            markLive(inst->operandWords[i]);
+        for (auto child = inst->m_firstChild; child; child = child->nextSibling)
+            markOperandsLive(child);
+    }
+
+    static bool isDefinitionSection(SpvLogicalSectionID id)
+    {
+        switch (id)
+        {
+        case SpvLogicalSectionID::ConstantsAndTypes:
+        case SpvLogicalSectionID::GlobalVariables:
+        case SpvLogicalSectionID::FunctionDeclarations:
+        case SpvLogicalSectionID::FunctionDefinitions:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /// Is `inst` a global definition that must be kept even if nothing refers to it?
+    bool isRootDefinition(SpvLogicalSectionID sectionID, SpvInst* inst)
+    {
+        if (inst->id == 0)
+            return true;
+        switch (inst->opcode)
+        {
+        case SpvOpExtInst:
+        case SpvOpTypeForwardPointer:
+        case SpvOpSpecConstantTrue:
+        case SpvOpSpecConstantFalse:
+        case SpvOpSpecConstant:
+        case SpvOpSpecConstantComposite:
+        case SpvOpSpecConstantOp:
+            return true;
+        default:
+            return sectionID == SpvLogicalSectionID::GlobalVariables && m_preserveGlobalVariables;
+        }
+    }
+
+    /// Returns true if `inst` is a name or decoration, and sets `outTarget` to the <id> it
+    /// applies to.
+    static bool getNameOrDecorationTarget(SpvInst* inst, SpvWord& outTarget)
+    {
+        switch (inst->opcode)
+        {
+        case SpvOpName:
+        case SpvOpMemberName:
+        case SpvOpDecorate:
+        case SpvOpDecorateId:
+        case SpvOpDecorateString:
+        case SpvOpMemberDecorate:
+        case SpvOpMemberDecorateString:
+            if (inst->operandWordsCount == 0)
+                return false;
+            outTarget = inst->operandWords[0];
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool isDeadGlobal(SpvWord id)
+    {
+        return m_globalDefs.containsKey(id) && !m_liveIds.contains(id);
+    }
+
+    void removeDeadGlobals()
+    {
+        List<SpvInst*> roots;
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        {
+            auto sectionID = SpvLogicalSectionID(ii);
+            for (auto inst = m_sections[ii].m_firstChild; inst; inst = inst->nextSibling)
+            {
+                if (sectionID == SpvLogicalSectionID::Annotations ||
+                    sectionID == SpvLogicalSectionID::DebugNames)
+                {
+                    // Names and decorations don't keep their target alive, except for linkage
+                    // attributes, which make the target visible outside of the module.
+                    SpvWord target = 0;
+                    if (!getNameOrDecorationTarget(inst, target))
+                        roots.add(inst);
+                    else if (
+                        inst->opcode == SpvOpDecorate && inst->operandWordsCount >= 2 &&
+                        inst->operandWords[1] == SpvDecorationLinkageAttributes)
+                        roots.add(inst);
+                }
+                else if (!isDefinitionSection(sectionID) || isRootDefinition(sectionID, inst))
+                {
+                    roots.add(inst);
+                }
+                else
+                {
+                    m_globalDefs[inst->id] = inst;
+                }
+            }
+        }
+        if (m_globalDefs.getCount() == 0)
+            return;
+
+        for (auto root : roots)
+        {
+            SpvWord target = 0;
+            if (getNameOrDecorationTarget(root, target))
+                markLive(target);
+            markOperandsLive(root);
+        }
+
+        // The decorations of live instructions can refer to other instructions
+        // (e.g., through `OpDecorateId`), so we iterate until nothing changes.
+        for (;;)
+        {
+            while (m_workList.getCount())
+            {
+                auto inst = m_workList.getLast();
+                m_workList.removeLast();
+                markOperandsLive(inst);
+            }
+
+            const auto liveCount = m_liveIds.getCount();
+            for (auto inst = getSection(SpvLogicalSectionID::Annotations)->m_firstChild; inst;
+                 inst = inst->nextSibling)
+            {
+                SpvWord target = 0;
+                if (inst->opcode == SpvOpDecorateId && getNameOrDecorationTarget(inst, target) &&
+                    !isDeadGlobal(target))
+                    markOperandsLive(inst);
+            }
+            if (m_workList.getCount() == 0 && m_liveIds.getCount() == liveCount)
+                break;
+        }
+
+        for (int ii = 0; ii < int(SpvLogicalSectionID::Count); ++ii)
+        {
+            for (auto inst = m_sections[ii].m_firstChild; inst;)
+            {
+                auto next = inst->nextSibling;
+                SpvWord target = 0;
+                SpvInst* def = nullptr;
+                if (m_globalDefs.tryGetValue(inst->id, def) && def == inst)
+                {
+                    if (!m_liveIds.contains(inst->id))
+                        inst->removeFromParent();
+                }
+                else if (getNameOrDecorationTarget(inst, target) && isDeadGlobal(target))
+                {
+                    inst->removeFromParent();
+                }
+                inst = next;
+            }
+        }
+    }
+
+    // Redundant decoration removal.
+
+    void removeDuplicateInsts(SpvLogicalSection* section)
+    {
+        HashSet<SPIRVEmitContext::SpvTypeInstKey> seen;
+        for (auto inst = section->m_firstChild; inst;)
+        {
+            auto next = inst->nextSibling;
+            SPIRVEmitContext::SpvTypeInstKey key;
+            key.words.add(inst->opcode);
+            key.words.addRange(inst->operandWords, inst->operandWordsCount);
+            if (!seen.add(key))
+                inst->removeFromParent();
+            inst = next;
+        }
+    }
+
+    // Block merging.
+
+    /// <id>s that names or decorations refer to, which we won't try to get rid of.
+    HashSet<SpvWord> m_annotatedIds;
+
+    template<typename F>
+    static void forEachOperandWord(SpvInst* inst, const F& f)
+    {
+        for (uint32_t i = 0; i < inst->operandWordsCount; i++)
+        {
+            // Skip the result <id> of the instruction itself, which is one of the first two
+            // operands when present.
+            if (i < 2 && inst->id != 0 && inst->operandWords[i] == inst->id)
+                continue;
+            f(inst->operandWords[i]);
+        }
+        for (auto child = inst->m_firstChild; child; child = child->nextSibling)
+            forEachOperandWord(child, f);
+    }
+
+    /// Merge each block that is only ever branched to unconditionally from a single
+    /// predecessor into that predecessor.
+    void mergeBlocks(SpvInst* func)
+    {
+        Dictionary<SpvWord, SpvInst*> blocks;
+        HashSet<SpvWord> pinnedBlocks;
+        SpvInst* entryBlock = nullptr;
+        for (auto child = func->m_firstChild; child; child = child->nextSibling)
+        {
+            if (child->opcode != SpvOpLabel)
+                continue;
+            if (!entryBlock)
+                entryBlock = child;
+            blocks[child->id] = child;
+        }
+        if (blocks.getCount() < 2)
+            return;
+
+        // The merge blocks and continue targets of structured control flow
+        // must stay blocks of their own.
+        Dictionary<SpvWord, Index> refCounts;
+        Dictionary<SpvWord, Index> phiParentRefCounts;
+        forEachOperandWord(
+            func,
+            [&](SpvWord& word)
+            {
+                if (blocks.containsKey(word))
+                    refCounts[word] = refCounts.getOrAddValue(word, 0) + 1;
+            });
+        for (auto block = func->m_firstChild; block; block = block->nextSibling)
+        {
+            for (auto inst = block->m_firstChild; inst; inst = inst->nextSibling)
+            {
+                if (inst->opcode == SpvOpSelectionMerge && inst->operandWordsCount >= 1)
+                {
+                    pinnedBlocks.add(inst->operandWords[0]);
+                }
+                else if (inst->opcode == SpvOpLoopMerge && inst->operandWordsCount >= 2)
+                {
+                    pinnedBlocks.add(inst->operandWords[0]);
+                    pinnedBlocks.add(inst->operandWords[1]);
+                }
+                else if (inst->opcode == SpvOpPhi)
+                {
+                    for (uint32_t i = 3; i < inst->operandWordsCount; i += 2)
+                    {
+                        auto parent = inst->operandWords[i];
+                        phiParentRefCounts[parent] =
+                            phiParentRefCounts.getOrAddValue(parent, 0) + 1;
+                    }
+                }
+            }
+        }
+
+        auto canMergeIntoPredecessor = [&](SpvInst* block)
+        {
+            if (block == entryBlock || pinnedBlocks.contains(block->id) ||
+                m_annotatedIds.contains(block->id))
+                return false;
+            for (auto inst = block->m_firstChild; inst; inst = inst->nextSibling)
+            {
+                if (inst->opcode == SpvOpPhi)
+                    return false;
+            }
+            // The only references to the block must be the branch into it,
+            // and the phis of its successors.
+            const auto refCount = refCounts.getOrAddValue(block->id, 0);
+            return refCount - phiParentRefCounts.getOrAddValue(block->id, 0) == 1;
+        };
+
+        for (auto block = func->m_firstChild; block; block = block->nextSibling)
+        {
+            if (block->opcode != SpvOpLabel)
+                continue;
+            for (;;)
+            {
+                auto terminator = block->m_lastChild;
+                if (!terminator || terminator->opcode != SpvOpBranch ||
+                    terminator->operandWordsCount != 1)
+                    break;
+                if (auto mergeInst = terminator->prevSibling)
+                {
+                    if (mergeInst->opcode == SpvOpSelectionMerge ||
+                        mergeInst->opcode == SpvOpLoopMerge)
+                        break;
+                }
+                SpvInst* successor = nullptr;
+                if (!blocks.tryGetValue(terminator->operandWords[0], successor) ||
+                    successor == block || !canMergeIntoPredecessor(successor))
+                    break;
+
+                // Phis that refer to the successor as a predecessor block now need to refer
+                // to the merged block.
+                if (phiParentRefCounts.getOrAddValue(successor->id, 0))
+                {
+                    for (auto b = func->m_firstChild; b; b = b->nextSibling)
+                    {
+                        for (auto inst = b->m_firstChild; inst; inst = inst->nextSibling)
+                        {
+                            if (inst->opcode != SpvOpPhi)
+                                continue;
+                            for (uint32_t i = 3; i < inst->operandWordsCount; i += 2)
+                            {
+                                if (inst->operandWords[i] == successor->id)
+                                    inst->operandWords[i] = block->id;
+                            }
+                        }
+                    }
+                    const auto movedRefs = phiParentRefCounts[successor->id];
+                    refCounts[block->id] = refCounts.getOrAddValue(block->id, 0) + movedRefs;
+                    phiParentRefCounts[block->id] =
+                        phiParentRefCounts.getOrAddValue(block->id, 0) + movedRefs;
+                }
+
+                terminator->removeFromParent();
+                while (auto inst = successor->m_firstChild)
+                {
+                    inst->removeFromParent();
+                    block->addInst(inst);
+                }
+                successor->removeFromParent();
+                blocks.remove(successor->id);
+            }
+        }
+    }
+
+    void run()
+    {
+        removeDeadGlobals();
+        removeDuplicateInsts(getSection(SpvLogicalSectionID::Annotations));
+        removeDuplicateInsts(getSection(SpvLogicalSectionID::DebugNames));
+
+        const SpvLogicalSectionID annotationSections[] = {
+            SpvLogicalSectionID::Annotations,
+            SpvLogicalSectionID::DebugNames};
+        for (auto sectionID : annotationSections)
+        {
+            for (auto inst = getSection(sectionID)->m_firstChild; inst; inst = inst->nextSibling)
+            {
+                for (uint32_t i = 0; i < inst->operandWordsCount; i++)
+                    m_annotatedIds.add(inst->operandWords[i]);
+            }
+        }
+        // Blocks are merged within a single function, so functions can be processed
+        // concurrently.
+        List<SpvInst*> funcs;
+        auto mergeBlocksInFunc = [&](Index i)
+        {
+            if (funcs[i]->opcode == SpvOpFunction)
+                mergeBlocks(funcs[i]);
+        };
+        if (_collectFunctionsForParallelWork(
+                getSection(SpvLogicalSectionID::FunctionDefinitions),
+                funcs) &&
+            m_threadPool)
+        {
+            m_threadPool->parallelFor(funcs.getCount(), mergeBlocksInFunc);
+        }
+        else
+        {
+            for (Index i = 0; i < funcs.getCount(); i++)
+                mergeBlocksInFunc(i);
+        }
+    }
+};
+
 SlangResult emitSPIRVFromIR(
     CodeGenContext* codeGenContext,
     IRModule* irModule,
@@ -8214,7 +8667,15 @@ SlangResult emitSPIRVFromIR(
     }
 #endif
 
-    removeAvailableInDownstreamModuleDecorations(CodeGenTarget::SPIRV, irModule);
+    // When precompiling a module, functions that are already available in the
+    // precompiled SPIR-V of the modules it depends on are imported rather than
+    // emitted again. For a complete program this has already been done during
+    // linking if (and only if) the precompiled SPIR-V is going to be linked in.
+    if (codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::EmbedDownstreamIR))
+    {
+        removeAvailableInDownstreamModuleDecorations(CodeGenTarget::SPIRV, irModule);
+    }
 
     auto shouldPreserveParams = codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
         CompilerOptionName::PreserveParameters);
@@ -8299,6 +8760,16 @@ SlangResult emitSPIRVFromIR(
 
     context.emitFrontMatter();
 
+    if (codeGenContext->shouldUseFastSPIRVOptimization())
+    {
+        SLANG_PROFILE_SECTION(cleanupSPIRV);
+        SPIRVModuleCleanup cleanup;
+        cleanup.m_sections = context.m_sections;
+        cleanup.m_preserveGlobalVariables = shouldPreserveParams;
+        cleanup.m_threadPool = context.getFunctionThreadPool();
+        cleanup.run();
+    }
+
     context.emitPhysicalLayout();
 
     spirvOut.addRange(
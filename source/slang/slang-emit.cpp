@@ -5,6 +5,7 @@
 #include "../compiler-core/slang-artifact-impl.h"
 #include "../compiler-core/slang-artifact-util.h"
 #include "../compiler-core/slang-name.h"
+#include "../compiler-core/slang-pretty-writer.h"
 #include "../core/slang-castable.h"
 #include "../core/slang-performance-profiler.h"
 #include "../core/slang-type-text-util.h"
@@ -79,6 +80,7 @@
 #include "slang-ir-metadata.h"
 #include "slang-ir-metal-legalize.h"
 #include "slang-ir-optix-entry-point-uniforms.h"
+#include "slang-ir-pass-telemetry.h"
 #include "slang-ir-pytorch-cpp-binding.h"
 #include "slang-ir-redundancy-removal.h"
 #include "slang-ir-resolve-texture-format.h"
@@ -215,6 +217,15 @@ static void dumpIRIfEnabled(
     }
 }
 
+static void recordIRPassTelemetry(
+    IRPassTelemetry* passTelemetry,
+    IRModule* irModule,
+    char const* label)
+{
+    if (passTelemetry)
+        passTelemetry->record(irModule, label);
+}
+
 static void reportCheckpointIntermediates(
     CodeGenContext* codeGenContext,
     DiagnosticSink* sink,
@@ -604,6 +615,13 @@ Result linkAndOptimizeIR(
     // Get the artifact desc for the target
     const auto artifactDesc = ArtifactDescUtil::makeDescForCompileTarget(asExternal(target));
 
+    // If requested, we record the time taken by each group of passes below, and
+    // the size of the IR after it.
+    //
+    RefPtr<IRPassTelemetry> passTelemetry;
+    if (codeGenContext->shouldRecordIRPassTelemetry())
+        passTelemetry = new IRPassTelemetry();
+
     // We start out by performing "linking" at the level of the IR.
     // This step will create a fresh IR module to be used for
     // code generation, and will copy in any IR definitions that
@@ -615,10 +633,12 @@ Result linkAndOptimizeIR(
     outLinkedIR = linkIR(codeGenContext);
     auto irModule = outLinkedIR.module;
     auto irEntryPoints = outLinkedIR.entryPoints;
+    outLinkedIR.passTelemetry = passTelemetry;
 
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "LINKED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "LINKED");
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -655,6 +675,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL CONSTANTS REPLACED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "GLOBAL CONSTANTS REPLACED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
 
@@ -670,6 +691,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS BOUND");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "EXISTENTIALS BOUND");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Now that we've linked the IR code, any layout/binding
@@ -694,6 +716,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "GLOBAL UNIFORMS COLLECTED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "GLOBAL UNIFORMS COLLECTED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Another transformation that needed to wait until we
@@ -746,6 +769,7 @@ Result linkAndOptimizeIR(
     case CodeGenTarget::CUDASource:
         break;
     }
+    recordIRPassTelemetry(passTelemetry, irModule, "ENTRY POINT UNIFORMS MOVED");
 
     if (requiredLoweringPassSet.optionalType)
         lowerOptionalType(irModule, sink);
@@ -782,6 +806,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "UNIONS DESUGARED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "UNIONS DESUGARED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Lower all the LValue implict casts (used for out/inout/ref scenarios)
@@ -799,6 +824,7 @@ Result linkAndOptimizeIR(
         targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
 
     simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
+    recordIRPassTelemetry(passTelemetry, irModule, "SIMPLIFIED");
 
     if (targetProgram->getOptionSet().getBoolOption(CompilerOptionName::ValidateUniformity))
     {
@@ -861,6 +887,7 @@ Result linkAndOptimizeIR(
     {
         bool changed = false;
         dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-SPECIALIZE");
+        recordIRPassTelemetry(passTelemetry, irModule, "BEFORE-SPECIALIZE");
         if (!codeGenContext->isSpecializationDisabled())
         {
             // Pre-autodiff, we will attempt to specialize as much as possible.
@@ -877,6 +904,7 @@ Result linkAndOptimizeIR(
         if (codeGenContext->getSink()->getErrorCount() != 0)
             return SLANG_FAIL;
         dumpIRIfEnabled(codeGenContext, irModule, "AFTER-SPECIALIZE");
+        recordIRPassTelemetry(passTelemetry, irModule, "AFTER-SPECIALIZE");
 
         if (changed)
         {
@@ -898,6 +926,7 @@ Result linkAndOptimizeIR(
                     return SLANG_FAIL;
             }
         }
+        recordIRPassTelemetry(passTelemetry, irModule, "LOOPS UNROLLED");
 
         // Few of our targets support higher order functions, and
         // we don't have the backend code to emit higher order functions for those
@@ -914,6 +943,7 @@ Result linkAndOptimizeIR(
             changed |= processAutodiffCalls(targetProgram, irModule, sink);
             disableIRValidationAtInsert();
             dumpIRIfEnabled(codeGenContext, irModule, "AFTER-AUTODIFF");
+            recordIRPassTelemetry(passTelemetry, irModule, "AFTER-AUTODIFF");
         }
 
         if (!changed)
@@ -930,6 +960,11 @@ Result linkAndOptimizeIR(
     finalizeAutoDiffPass(targetProgram, irModule);
     eliminateDeadCode(irModule, deadCodeEliminationOptions);
 
+    // Partially unroll small loops, if enabled. This is done after auto-diff so that
+    // the derivative loops are unrolled too.
+    if (!fastIRSimplificationOptions.minimalOptimization)
+        partiallyUnrollLoopsInModule(targetProgram, irModule);
+
     // After auto-diff, we can perform more aggressive specialization with dynamic-dispatch
     // lowering.
     //
@@ -941,6 +976,7 @@ Result linkAndOptimizeIR(
     }
 
     finalizeSpecialization(irModule);
+    recordIRPassTelemetry(passTelemetry, irModule, "SPECIALIZATION FINALIZED");
 
     requiredLoweringPassSet = {};
     calcRequiredLoweringPassSet(requiredLoweringPassSet, codeGenContext, irModule->getModuleInst());
@@ -998,6 +1034,7 @@ Result linkAndOptimizeIR(
         return SLANG_FAIL;
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
+    recordIRPassTelemetry(passTelemetry, irModule, "TYPES INLINED");
 
     inferAnyValueSizeWhereNecessary(targetProgram, irModule);
 
@@ -1027,11 +1064,13 @@ Result linkAndOptimizeIR(
     // generics / interface types to ordinary functions and types using
     // function pointers.
     dumpIRIfEnabled(codeGenContext, irModule, "BEFORE-LOWER-GENERICS");
+    recordIRPassTelemetry(passTelemetry, irModule, "BEFORE-LOWER-GENERICS");
     if (requiredLoweringPassSet.generics)
         lowerGenerics(targetProgram, irModule, sink);
     else
         cleanupGenerics(targetProgram, irModule, sink);
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER-LOWER-GENERICS");
+    recordIRPassTelemetry(passTelemetry, irModule, "AFTER-LOWER-GENERICS");
 
     // After dynamic dispatch logic is resolved into ordinary function calls,
     // we can now run our stage specialization logic.
@@ -1042,6 +1081,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "SPECIALIZED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "SPECIALIZED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     switch (target)
@@ -1057,6 +1097,17 @@ Result linkAndOptimizeIR(
     // Inline calls to any functions marked with [__unsafeInlineEarly] or [ForceInline].
     performForceInlining(irModule);
 
+    // Inline the remaining calls that the cost model considers cheap enough, if enabled.
+    // This runs before the simplification below, so that constant arguments of inlined
+    // calls get folded into the caller.
+    const int inlineThreshold =
+        targetProgram->getOptionSet().getIntOption(CompilerOptionName::InlineThreshold);
+    if (inlineThreshold > 0 && !fastIRSimplificationOptions.minimalOptimization)
+    {
+        performCostBasedInlining(irModule, inlineThreshold, deadCodeEliminationOptions);
+    }
+    recordIRPassTelemetry(passTelemetry, irModule, "INLINED");
+
     // Push `structuredBufferLoad` to the end of access chain to avoid loading unnecessary data.
     if (isKhronosTarget(targetRequest) || isMetalTarget(targetRequest) ||
         isWGPUTarget(targetRequest))
@@ -1074,6 +1125,7 @@ Result linkAndOptimizeIR(
     {
         simplifyIR(targetProgram, irModule, defaultIRSimplificationOptions, sink);
     }
+    recordIRPassTelemetry(passTelemetry, irModule, "SIMPLIFIED AFTER INLINING");
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -1145,6 +1197,7 @@ Result linkAndOptimizeIR(
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "EXISTENTIALS LEGALIZED");
 #endif
+        recordIRPassTelemetry(passTelemetry, irModule, "EXISTENTIALS LEGALIZED");
         validateIRModuleIfEnabled(codeGenContext, irModule);
 
         // Many of our target languages and/or downstream compilers
@@ -1164,6 +1217,7 @@ Result linkAndOptimizeIR(
 #if 0
         dumpIRIfEnabled(codeGenContext, irModule, "LEGALIZED");
 #endif
+        recordIRPassTelemetry(passTelemetry, irModule, "LEGALIZED");
         validateIRModuleIfEnabled(codeGenContext, irModule);
     }
     else
@@ -1191,6 +1245,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER SSA");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "AFTER SSA");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // After type legalization and subsequent SSA cleanup we expect
@@ -1216,6 +1271,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER RESOURCE SPECIALIZATION");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "AFTER RESOURCE SPECIALIZATION");
 
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
@@ -1357,6 +1413,7 @@ Result linkAndOptimizeIR(
             codeGenContext->getSink(),
             byteAddressBufferOptions);
     }
+    recordIRPassTelemetry(passTelemetry, irModule, "BYTE ADDRESS BUFFERS LEGALIZED");
 
     // For SPIR-V, this function is called elsewhere, so that it can happen after address space
     // specialization
@@ -1465,6 +1522,8 @@ Result linkAndOptimizeIR(
         break;
     }
 
+    recordIRPassTelemetry(passTelemetry, irModule, "TARGET LEGALIZED");
+
     if (!isSPIRV(targetRequest->getTarget()))
     {
         floatNonUniformResourceIndex(irModule, NonUniformResourceIndexFloatMode::Textual);
@@ -1571,6 +1630,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER STRIP WITNESS TABLES");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "AFTER STRIP WITNESS TABLES");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     // Make sure there are no matrices with 1 row/column, except for D3D targets where it's allowed.
@@ -1597,6 +1657,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "AFTER DCE");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "AFTER DCE");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     cleanUpVoidType(irModule);
@@ -1653,6 +1714,7 @@ Result linkAndOptimizeIR(
         simplificationOptions.cfgOptions.removeTrivialSingleIterationLoops = true;
         simplifyIR(targetProgram, irModule, simplificationOptions, sink);
     }
+    recordIRPassTelemetry(passTelemetry, irModule, "BEFORE PHI ELIMINATION");
 
     // As a late step, we need to take the SSA-form IR and move things *out*
     // of SSA form, by eliminating all "phi nodes" (block parameters) and
@@ -1702,6 +1764,7 @@ Result linkAndOptimizeIR(
 #endif
         }
     }
+    recordIRPassTelemetry(passTelemetry, irModule, "PHIS ELIMINATED");
 
     // TODO: We need to insert the logic that fixes variable scoping issues
     // here (rather than doing it very late in the emit process), because
@@ -1746,6 +1809,7 @@ Result linkAndOptimizeIR(
 #if 0
     dumpIRIfEnabled(codeGenContext, irModule, "OPTIMIZED");
 #endif
+    recordIRPassTelemetry(passTelemetry, irModule, "OPTIMIZED");
     validateIRModuleIfEnabled(codeGenContext, irModule);
 
     if ((target != CodeGenTarget::SPIRV) && (target != CodeGenTarget::SPIRVAssembly))
@@ -1774,10 +1838,42 @@ Result linkAndOptimizeIR(
 
     if (!targetProgram->getOptionSet().shouldPerformMinimumOptimizations())
         checkUnsupportedInst(codeGenContext->getTargetReq(), irModule, sink);
+    recordIRPassTelemetry(passTelemetry, irModule, "FINALIZED");
 
     return sink->getErrorCount() == 0 ? SLANG_OK : SLANG_FAIL;
 }
 
+/// If `linkAndOptimizeIR` recorded the telemetry of its passes, associate it with
+/// `artifact` as JSON.
+static void addIRPassTelemetry(
+    CodeGenContext* codeGenContext,
+    LinkedIR const& linkedIR,
+    IArtifact* artifact)
+{
+    auto passTelemetry = linkedIR.passTelemetry;
+    if (!passTelemetry)
+        return;
+
+    List<String> entryPointNames;
+    for (auto entryPointIndex : codeGenContext->getEntryPointIndices())
+    {
+        auto entryPoint = codeGenContext->getEntryPoint(entryPointIndex);
+        entryPointNames.add(getText(entryPoint->getName()));
+    }
+
+    PrettyWriter writer;
+    passTelemetry->writeJSON(
+        writer,
+        TypeTextUtil::getCompileTargetName(SlangCompileTarget(codeGenContext->getTargetFormat())),
+        entryPointNames);
+
+    auto telemetryArtifact = ArtifactUtil::createArtifact(
+        ArtifactDesc::make(ArtifactKind::Json, ArtifactPayload::IRPassTelemetry));
+    telemetryArtifact->addRepresentationUnknown(StringBlob::moveCreate(writer.getBuilder()));
+
+    artifact->addAssociated(telemetryArtifact);
+}
+
 SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outArtifact)
 {
     SLANG_PROFILE;
@@ -1940,8 +2036,10 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
         sourceEmitter->emitModule(irModule, sink);
     }
 
-    String code = sourceWriter.getContent();
-    sourceWriter.clearContent();
+    // The module's code is kept in the chunks it was written in, so that large outputs are
+    // never copied into a single string.
+    List<String> code;
+    sourceWriter.appendContentAndClear(code);
 
     // Now that we've emitted the code for all the declarations in the file,
     // it is time to stitch together the final output.
@@ -1997,19 +2095,25 @@ SlangResult CodeGenContext::emitEntryPointsSourceFromIR(ComPtr<IArtifact>& outAr
 
     // Get the content built so far from the front matter/prelude/preModule
     // By getting in this way, the content is no longer referenced by the sourceWriter.
-    String finalResult = sourceWriter.getContentAndClear();
+    List<String> segments;
+    sourceWriter.appendContentAndClear(segments);
 
     // Append the modules output code
-    finalResult.append(code);
+    for (auto& segment : code)
+    {
+        segments.add(_Move(segment));
+    }
 
-    finalResult.append(sourceWriter.getContentAndClear());
+    sourceWriter.appendContentAndClear(segments);
 
-    // Write out the result
+    // Write out the result. The segments are only joined if the contents are needed in one
+    // piece, for example by a downstream compiler that takes the source from memory.
 
     auto artifact = ArtifactUtil::createArtifactForCompileTarget(asExternal(target));
-    artifact->addRepresentationUnknown(StringBlob::moveCreate(finalResult));
+    artifact->addRepresentationUnknown(SegmentedBlob::moveCreate(segments));
 
     ArtifactUtil::addAssociated(artifact, metadata);
+    addIRPassTelemetry(this, linkedIR, artifact);
 
     if (sourceMap)
     {
@@ -2033,10 +2137,94 @@ SlangResult emitSPIRVFromIR(
     const List<IRFunc*>& irEntryPoints,
     List<uint8_t>& spirvOut);
 
+// Find the SPIR-V that was embedded into the modules of the program by
+// `Module::precompileForTarget`. Functions marked as available in that SPIR-V
+// don't need to be lowered again, and are instead linked in after emission.
+static void _collectPrecompiledSPIRV(
+    CodeGenContext* codeGenContext,
+    List<ComPtr<ISlangBlob>>& outBlobs)
+{
+    codeGenContext->getProgram()->enumerateIRModules(
+        [&](IRModule* irModule)
+        {
+            for (auto globalInst : irModule->getModuleInst()->getChildren())
+            {
+                if (auto inst = as<IREmbeddedDownstreamIR>(globalInst))
+                {
+                    if (inst->getTarget() == CodeGenTarget::SPIRV)
+                    {
+                        auto slice = inst->getBlob()->getStringSlice();
+                        outBlobs.add(RawBlob::create(slice.begin(), slice.getLength()));
+                    }
+                }
+            }
+        });
+}
+
+// Link the SPIR-V emitted for the program against the precompiled SPIR-V
+// of the modules it uses, replacing `ioSpirv` with the linked result.
+static SlangResult _linkWithPrecompiledSPIRV(
+    CodeGenContext* codeGenContext,
+    IDownstreamCompiler* compiler,
+    const List<ComPtr<ISlangBlob>>& precompiledBlobs,
+    List<uint8_t>& ioSpirv)
+{
+    List<const uint32_t*> modules;
+    List<size_t> moduleSizes;
+
+    modules.add((const uint32_t*)ioSpirv.getBuffer());
+    moduleSizes.add(size_t(ioSpirv.getCount()) / sizeof(uint32_t));
+    for (const auto& blob : precompiledBlobs)
+    {
+        modules.add((const uint32_t*)blob->getBufferPointer());
+        moduleSizes.add(blob->getBufferSize() / sizeof(uint32_t));
+    }
+
+    ComPtr<IArtifact> linkedArtifact;
+    SLANG_RETURN_ON_FAIL(compiler->link(
+        modules.getBuffer(),
+        moduleSizes.getBuffer(),
+        size_t(modules.getCount()),
+        linkedArtifact.writeRef()));
+
+    SLANG_RETURN_ON_FAIL(
+        passthroughDownstreamDiagnostics(codeGenContext->getSink(), compiler, linkedArtifact));
+
+    ComPtr<ISlangBlob> linkedBlob;
+    SLANG_RETURN_ON_FAIL(linkedArtifact->loadBlob(ArtifactKeep::No, linkedBlob.writeRef()));
+
+    ioSpirv.clear();
+    ioSpirv.addRange((const uint8_t*)linkedBlob->getBufferPointer(), linkedBlob->getBufferSize());
+    return SLANG_OK;
+}
+
 SlangResult emitSPIRVForEntryPointsDirectly(
     CodeGenContext* codeGenContext,
     ComPtr<IArtifact>& outArtifact)
 {
+    IDownstreamCompiler* compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
+        PassThroughMode::SpirvOpt,
+        codeGenContext->getSink());
+
+    // If the modules in the program carry precompiled SPIR-V, and we are able to
+    // link against it, the functions it provides are only declared in the IR we
+    // lower here. That way only the code specific to the entry points goes
+    // through the optimization passes, rather than the whole library.
+    //
+    // When we are ourselves precompiling a module (EmbedDownstreamIR), the
+    // functions have to be emitted in full.
+    List<ComPtr<ISlangBlob>> precompiledSPIRV;
+    if (compiler &&
+        !codeGenContext->getTargetProgram()->getOptionSet().getBoolOption(
+            CompilerOptionName::EmbedDownstreamIR))
+    {
+        _collectPrecompiledSPIRV(codeGenContext, precompiledSPIRV);
+    }
+    if (precompiledSPIRV.getCount())
+    {
+        codeGenContext->removeAvailableInDownstreamIR = true;
+    }
+
     // Outside because we want to keep IR in scope whilst we are processing emits
     LinkedIR linkedIR;
     LinkingAndOptimizationOptions linkingAndOptimizationOptions;
@@ -2049,6 +2237,18 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     List<uint8_t> spirv, outSpirv;
     emitSPIRVFromIR(codeGenContext, irModule, irEntryPoints, spirv);
 
+    if (precompiledSPIRV.getCount())
+    {
+        if (SLANG_FAILED(
+                _linkWithPrecompiledSPIRV(codeGenContext, compiler, precompiledSPIRV, spirv)))
+        {
+            codeGenContext->getSink()->diagnoseWithoutSourceView(
+                SourceLoc{},
+                Diagnostics::spirvLinkFailed);
+            return SLANG_FAIL;
+        }
+    }
+
 #if 0
     String optErr;
     if (SLANG_FAILED(optimizeSPIRV(spirv, optErr, outSpirv)))
@@ -2061,9 +2261,6 @@ SlangResult emitSPIRVForEntryPointsDirectly(
         ArtifactUtil::createArtifactForCompileTarget(asExternal(codeGenContext->getTargetFormat()));
     artifact->addRepresentationUnknown(ListBlob::moveCreate(spirv));
 
-    IDownstreamCompiler* compiler = codeGenContext->getSession()->getOrLoadDownstreamCompiler(
-        PassThroughMode::SpirvOpt,
-        codeGenContext->getSink());
     if (compiler)
     {
 #if 0
@@ -2091,6 +2288,16 @@ SlangResult emitSPIRVForEntryPointsDirectly(
             }
         }
 
+        // The SPIR-V has already been cleaned up by our own (much faster) pass,
+        // so there is nothing left for spirv-opt to do.
+        if (codeGenContext->shouldUseFastSPIRVOptimization())
+        {
+            ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
+            addIRPassTelemetry(codeGenContext, linkedIR, artifact);
+            outArtifact.swap(artifact);
+            return SLANG_OK;
+        }
+
         ComPtr<IArtifact> optimizedArtifact;
         DownstreamCompileOptions downstreamOptions;
         downstreamOptions.sourceArtifacts = makeSlice(artifact.readRef(), 1);
@@ -2118,9 +2325,12 @@ SlangResult emitSPIRVForEntryPointsDirectly(
             break;
         }
         auto downstreamStartTime = std::chrono::high_resolution_clock::now();
-        if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
         {
-            artifact = _Move(optimizedArtifact);
+            SLANG_PROFILE_SECTION(optimizeSPIRV);
+            if (SLANG_SUCCEEDED(compiler->compile(downstreamOptions, optimizedArtifact.writeRef())))
+            {
+                artifact = _Move(optimizedArtifact);
+            }
         }
         auto downstreamElapsedTime =
             (std::chrono::high_resolution_clock::now() - downstreamStartTime).count() * 0.000000001;
@@ -2131,6 +2341,7 @@ SlangResult emitSPIRVForEntryPointsDirectly(
     }
 
     ArtifactUtil::addAssociated(artifact, linkedIR.metadata);
+    addIRPassTelemetry(codeGenContext, linkedIR, artifact);
 
     outArtifact.swap(artifact);
 
@@ -4,6 +4,7 @@
 #include "slang-ast-support-types.h"
 #include "slang-ir-autodiff-region.h"
 #include "slang-ir-insts.h"
+#include "slang-ir-layout.h"
 #include "slang-ir-simplify-cfg.h"
 #include "slang-ir-util.h"
 #include "slang-ir.h"
@@ -2119,7 +2120,9 @@ void buildIndexedBlocks(
 // For each primal inst that is used in reverse blocks, decide if we should recompute or store
 // its value, then make them accessible in reverse blocks based the decision.
 //
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram)
 {
     sortBlocksInFunc(func);
 
@@ -2141,7 +2144,22 @@ RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func)
     // If we decide to recompute the inst, emit the recompute inst in the corresponding recompute
     // block.
     //
-    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    RefPtr<AutodiffCheckpointPolicyBase> chkPolicy;
+    if (targetProgram && targetProgram->getOptionSet().getEnumOption<AutodiffCheckpointPolicy>(
+                             CompilerOptionName::AutodiffCheckpointPolicy) ==
+                             AutodiffCheckpointPolicy::CostModel)
+    {
+        auto& optionSet = targetProgram->getOptionSet();
+        chkPolicy = new CostModelCheckpointPolicy(
+            func->getModule(),
+            optionSet,
+            indexedBlockInfo,
+            optionSet.getIntOption(CompilerOptionName::AutodiffCheckpointBudget));
+    }
+    else
+    {
+        chkPolicy = new DefaultCheckpointPolicy(func->getModule());
+    }
     chkPolicy->preparePolicy(func);
     auto primalsInfo = chkPolicy->processFunc(func, recomputeBlockMap, cloneCtx, indexedBlockInfo);
 
@@ -2440,4 +2458,244 @@ HoistResult DefaultCheckpointPolicy::classify(UseOrPseudoUse use)
     }
 }
 
+// Number of iterations assumed for a loop without a `[MaxIters]` bound
+static const Count kAssumedLoopIterationCount = 16;
+
+// Number of instructions assumed to be executed by a call to a function without a body
+static const Count kAssumedIntrinsicCallCost = 4;
+
+// Upper bound on the costs and sizes we estimate, so that products can't overflow
+static const Count kMaxEstimate = Count(1) << 40;
+
+Count CostModelCheckpointPolicy::getStorageSize(IRType* type)
+{
+    IRSizeAndAlignment sizeAndAlignment;
+    if (SLANG_FAILED(getNaturalSizeAndAlignment(optionSet, type, &sizeAndAlignment)))
+        return -1;
+    return Count(sizeAndAlignment.getStride());
+}
+
+Count CostModelCheckpointPolicy::getIterationCount(IRBlock* block)
+{
+    Count iterationCount = 1;
+    if (auto indexInfos = blockIndexInfo.tryGetValue(block))
+    {
+        for (auto& indexInfo : *indexInfos)
+        {
+            const Count loopIterationCount =
+                indexInfo.status == IndexTrackingInfo::CountStatus::Static && indexInfo.maxIters > 0
+                    ? indexInfo.maxIters
+                    : kAssumedLoopIterationCount;
+            iterationCount = Math::Min(iterationCount * loopIterationCount, kMaxEstimate);
+        }
+    }
+    return iterationCount;
+}
+
+// Returns true if `func` may write to memory other than its own local variables and
+// parameters, either directly or through a call.
+//
+static bool mayWriteNonLocalMemory(IRGlobalValueWithCode* func)
+{
+    for (auto block : func->getBlocks())
+    {
+        for (auto inst : block->getChildren())
+        {
+            switch (inst->getOp())
+            {
+            case kIROp_Store:
+            case kIROp_SwizzledStore:
+            case kIROp_Call:
+            case kIROp_Param:
+            case kIROp_ifElse:
+            case kIROp_unconditionalBranch:
+            case kIROp_Switch:
+            case kIROp_Return:
+            case kIROp_loop:
+            case kIROp_Unreachable:
+                break;
+            default:
+                if (inst->mightHaveSideEffects())
+                    return true;
+                continue;
+            }
+
+            // A call to a function with side effects may write anywhere. The derivatives
+            // of a function without side effects only write through their parameters.
+            //
+            if (auto call = as<IRCall>(inst))
+            {
+                auto callee = getResolvedInstForDecorations(call->getCallee(), true);
+                if (doesCalleeHaveSideEffect(callee))
+                    return true;
+            }
+
+            // Writes through (or passing on) an address that isn't local.
+            for (UInt i = 0; i < inst->getOperandCount(); i++)
+            {
+                if (isGlobalOrUnknownMutableAddress(func, inst->getOperand(i)))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool CostModelCheckpointPolicy::tryMakeCandidate(IRCall* call, Candidate& outCandidate)
+{
+    // Respect any explicit request to checkpoint the callee.
+    auto callee = call->getCallee();
+    if (getCheckpointPreference(callee) == CheckpointPreference::PreferCheckpoint)
+        return false;
+
+    // Calling again must produce the same values, so the callee can't write mutable global
+    // memory, and can only write to local variables passed to it. It may read global memory,
+    // which is why `preparePolicy` only gets here when nothing in the function writes any.
+    //
+    if (doesCalleeHaveSideEffect(getResolvedInstForDecorations(callee, true)))
+        return false;
+
+    auto block = as<IRBlock>(call->getParent());
+    if (!block)
+        return false;
+
+    Count storageSize = 0;
+    if (!as<IRVoidType>(call->getDataType()))
+    {
+        storageSize = getStorageSize(call->getDataType());
+        if (storageSize < 0)
+            return false;
+    }
+
+    // Only calls whose results are needed by the derivative computation contribute to the
+    // checkpoint context.
+    //
+    auto isUsedByDiffBlock = [](IRInst* inst)
+    {
+        for (auto use = inst->firstUse; use; use = use->nextUse)
+        {
+            if (auto useBlock = getBlock(use->getUser()))
+            {
+                if (isDifferentialBlock(useBlock))
+                    return true;
+            }
+        }
+        return false;
+    };
+    bool isUsed = isUsedByDiffBlock(call);
+
+    for (UInt i = 0; i < call->getArgCount(); i++)
+    {
+        auto arg = call->getArg(i);
+        if (isValueType(arg->getDataType()))
+            continue;
+
+        auto var = as<IRVar>(arg);
+        if (!var || getParentFunc(var) != getParentFunc(call))
+            return false;
+
+        // The call must be the only thing that writes the variable, so that its value when
+        // the call is recomputed is the value the call left. Anything other than loading it
+        // might write to it.
+        //
+        for (auto use = var->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (user == call)
+                continue;
+            if (as<IRLoad>(user) && use == user->getOperands())
+                continue;
+            return false;
+        }
+
+        auto varSize = getStorageSize(as<IRPtrTypeBase>(var->getDataType())->getValueType());
+        if (varSize < 0)
+            return false;
+        storageSize += varSize;
+        isUsed = isUsed || isUsedByDiffBlock(var);
+    }
+
+    if (!isUsed || storageSize == 0)
+        return false;
+
+    // Estimate the cost of a call by the size of the callee.
+    Count calleeCost = 0;
+    if (auto calleeFunc = as<IRGlobalValueWithCode>(getResolvedInstForDecorations(callee, true)))
+        calleeCost = getInstCountInBlocks(calleeFunc);
+    if (calleeCost == 0)
+        calleeCost = kAssumedIntrinsicCallCost;
+
+    const Count iterationCount = getIterationCount(block);
+    outCandidate.call = call;
+    outCandidate.storageSize = Math::Min(storageSize * iterationCount, kMaxEstimate);
+    outCandidate.recomputeCost =
+        Math::Min((Math::Min(calleeCost, kMaxEstimate) + 1) * iterationCount, kMaxEstimate);
+    return true;
+}
+
+void CostModelCheckpointPolicy::preparePolicy(IRGlobalValueWithCode* func)
+{
+    // The candidates may read global memory, so recomputing them later is only safe if
+    // nothing in between can change it.
+    //
+    if (mayWriteNonLocalMemory(func))
+        return;
+
+    // Find the primal calls that the default policy would store, but that
+    // could be recomputed instead.
+    //
+    List<Candidate> candidates;
+    Count storedSize = 0;
+    for (auto block : func->getBlocks())
+    {
+        if (isDifferentialBlock(block))
+            continue;
+
+        for (auto inst : block->getChildren())
+        {
+            auto call = as<IRCall>(inst);
+            if (!call || !shouldStoreInst(call))
+                continue;
+
+            Candidate candidate;
+            if (tryMakeCandidate(call, candidate))
+            {
+                candidates.add(candidate);
+                storedSize += candidate.storageSize;
+            }
+        }
+    }
+
+    // Recompute the candidates that save the most memory per unit of recompute
+    // cost first, until what is left to store fits within the budget.
+    //
+    candidates.stableSort(
+        [](const Candidate& a, const Candidate& b)
+        {
+            return double(a.recomputeCost) * double(b.storageSize) <
+                   double(b.recomputeCost) * double(a.storageSize);
+        });
+
+    for (auto& candidate : candidates)
+    {
+        if (storedSize <= memoryBudget)
+            break;
+
+        instsToRecompute.add(candidate.call);
+        for (UInt i = 0; i < candidate.call->getArgCount(); i++)
+        {
+            if (auto var = as<IRVar>(candidate.call->getArg(i)))
+                instsToRecompute.add(var);
+        }
+        storedSize -= candidate.storageSize;
+    }
+}
+
+HoistResult CostModelCheckpointPolicy::classify(UseOrPseudoUse use)
+{
+    if (instsToRecompute.contains(use.usedVal))
+        return HoistResult::recompute(use.usedVal);
+    return DefaultCheckpointPolicy::classify(use);
+}
+
 }; // namespace Slang
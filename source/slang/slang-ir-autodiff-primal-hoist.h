@@ -337,9 +337,62 @@ public:
     virtual void preparePolicy(IRGlobalValueWithCode* func);
     virtual HoistResult classify(UseOrPseudoUse use);
 
-private:
+protected:
     bool canRecompute(UseOrPseudoUse use);
 };
 
-RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(IRGlobalValueWithCode* func);
+// A policy that weighs the memory needed to store a primal value against the cost of
+// recomputing it. Calls that the default policy would store, but that are safe to
+// recompute, are recomputed (cheapest per byte first) until the estimated size of the
+// remaining ones fits within a memory budget. Values inside loops are weighted by the
+// number of iterations they need to be stored for.
+//
+class CostModelCheckpointPolicy : public DefaultCheckpointPolicy
+{
+public:
+    CostModelCheckpointPolicy(
+        IRModule* module,
+        CompilerOptionSet& optionSet,
+        Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo,
+        Count memoryBudget)
+        : DefaultCheckpointPolicy(module)
+        , optionSet(optionSet)
+        , blockIndexInfo(blockIndexInfo)
+        , memoryBudget(memoryBudget)
+    {
+    }
+
+    virtual void preparePolicy(IRGlobalValueWithCode* func) override;
+    virtual HoistResult classify(UseOrPseudoUse use) override;
+
+private:
+    struct Candidate
+    {
+        IRCall* call = nullptr;
+        // Estimated bytes needed to store the call's result and outputs, across all iterations.
+        Count storageSize = 0;
+        // Estimated number of instructions executed to recompute the call, across all iterations.
+        Count recomputeCost = 0;
+    };
+
+    // Returns true if `call` can be recomputed instead of stored, and fills in its costs.
+    bool tryMakeCandidate(IRCall* call, Candidate& outCandidate);
+
+    // Returns the natural size of `type`, or -1 if it has none.
+    Count getStorageSize(IRType* type);
+
+    // Returns the number of times values computed in `block` need to be stored.
+    Count getIterationCount(IRBlock* block);
+
+    CompilerOptionSet& optionSet;
+    Dictionary<IRBlock*, List<IndexTrackingInfo>>& blockIndexInfo;
+    Count memoryBudget;
+
+    // Calls (and the variables they write) that should be recomputed rather than stored.
+    HashSet<IRInst*> instsToRecompute;
+};
+
+RefPtr<HoistedPrimalsInfo> applyCheckpointPolicy(
+    IRGlobalValueWithCode* func,
+    TargetProgram* targetProgram);
 }; // namespace Slang
@@ -116,4 +116,93 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     return referencingEntryPoints;
 }
 
+void findRecursiveFunctions(IRModule* module, HashSet<IRFunc*>& outRecursiveFuncs)
+{
+    // Collect all function definitions, including the ones nested in generics,
+    // along with the functions they call directly.
+    List<IRFunc*> funcs;
+    Dictionary<IRFunc*, List<IRFunc*>> callees;
+    for (auto globalInst : module->getGlobalInsts())
+    {
+        auto func = as<IRFunc>(globalInst);
+        if (auto generic = as<IRGeneric>(globalInst))
+            func = as<IRFunc>(findGenericReturnVal(generic));
+        if (!func)
+            continue;
+        funcs.add(func);
+        auto& funcCallees = callees[func];
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getChildren())
+            {
+                auto call = as<IRCall>(inst);
+                if (!call)
+                    continue;
+                if (auto callee = as<IRFunc>(getResolvedInstForDecorations(call->getCallee())))
+                    funcCallees.add(callee);
+            }
+        }
+    }
+
+    // Tarjan's algorithm: every strongly connected component with more than one
+    // member, or with a single member that calls itself, is a set of recursive functions.
+    struct NodeInfo
+    {
+        Index index;
+        Index lowLink;
+        bool onStack;
+    };
+    Dictionary<IRFunc*, NodeInfo> nodeInfos;
+    List<IRFunc*> stack;
+    Index nextIndex = 0;
+
+    auto visit = [&](auto& self, IRFunc* func) -> void
+    {
+        nodeInfos[func] = NodeInfo{nextIndex, nextIndex, true};
+        nextIndex++;
+        stack.add(func);
+
+        bool callsSelf = false;
+        if (auto funcCallees = callees.tryGetValue(func))
+        {
+            for (auto callee : *funcCallees)
+            {
+                if (callee == func)
+                    callsSelf = true;
+                if (!nodeInfos.containsKey(callee))
+                {
+                    self(self, callee);
+                    nodeInfos[func].lowLink =
+                        Math::Min(nodeInfos[func].lowLink, nodeInfos[callee].lowLink);
+                }
+                else if (nodeInfos[callee].onStack)
+                {
+                    nodeInfos[func].lowLink =
+                        Math::Min(nodeInfos[func].lowLink, nodeInfos[callee].index);
+                }
+            }
+        }
+
+        if (nodeInfos[func].lowLink != nodeInfos[func].index)
+            return;
+
+        // `func` is the root of a component, pop it off the stack.
+        Index componentStart = stack.indexOf(func);
+        bool isRecursive = callsSelf || componentStart != stack.getCount() - 1;
+        for (Index i = componentStart; i < stack.getCount(); i++)
+        {
+            nodeInfos[stack[i]].onStack = false;
+            if (isRecursive)
+                outRecursiveFuncs.add(stack[i]);
+        }
+        stack.setCount(componentStart);
+    };
+
+    for (auto func : funcs)
+    {
+        if (!nodeInfos.containsKey(func))
+            visit(visit, func);
+    }
+}
+
 } // namespace Slang
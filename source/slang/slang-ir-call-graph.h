@@ -12,4 +12,8 @@ HashSet<IRFunc*>* getReferencingEntryPoints(
     Dictionary<IRInst*, HashSet<IRFunc*>>& m_referencingEntryPoints,
     IRInst* inst);
 
+/// Find every function that can (directly or indirectly) call itself through direct calls,
+/// i.e. every function that is part of a cycle in the module's call graph.
+void findRecursiveFunctions(IRModule* module, HashSet<IRFunc*>& outRecursiveFuncs);
+
 } // namespace Slang
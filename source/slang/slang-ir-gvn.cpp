@@ -0,0 +1,264 @@
+// slang-ir-gvn.cpp
+#include "slang-ir-gvn.h"
+
+#include "../core/slang-short-list.h"
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+// The value computed by a movable instruction is fully determined by its opcode,
+// its type, and its operands, so two instructions with equal keys compute the same value.
+struct ValueKey
+{
+    IROp op = kIROp_Nop;
+    IRInst* type = nullptr;
+    ShortList<IRInst*, 4> operands;
+
+    HashCode getHashCode() const
+    {
+        HashCode hash = combineHash(Slang::getHashCode(int(op)), Slang::getHashCode(type));
+        for (auto operand : operands)
+            hash = combineHash(hash, Slang::getHashCode(operand));
+        return hash;
+    }
+
+    bool operator==(const ValueKey& other) const
+    {
+        if (op != other.op || type != other.type ||
+            operands.getCount() != other.operands.getCount())
+            return false;
+        for (Index i = 0; i < operands.getCount(); i++)
+        {
+            if (operands[i] != other.operands[i])
+                return false;
+        }
+        return true;
+    }
+};
+
+static bool isCommutativeOp(IROp op)
+{
+    switch (op)
+    {
+    case kIROp_Add:
+    case kIROp_Mul:
+    case kIROp_BitAnd:
+    case kIROp_BitOr:
+    case kIROp_BitXor:
+    case kIROp_And:
+    case kIROp_Or:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct GlobalValueNumberingContext
+{
+    IRGlobalValueWithCode* func;
+    RefPtr<IRDominatorTree> dom;
+
+    // The values available in the dominator tree scope being visited, and the keys
+    // that were added to it, in order, so they can be removed when leaving a scope.
+    Dictionary<ValueKey, IRInst*> availableValues;
+    List<ValueKey> addedKeys;
+
+    static ValueKey getKey(IRInst* inst)
+    {
+        ValueKey key;
+        key.op = inst->getOp();
+        key.type = inst->getFullType();
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+            key.operands.add(inst->getOperand(i));
+        return key;
+    }
+
+    /// Returns the key of the value `inst` would compute with its two operands swapped,
+    /// or false if there is no such equivalent operation.
+    static bool getSwappedKey(IRInst* inst, ValueKey& outKey)
+    {
+        if (inst->getOperandCount() != 2)
+            return false;
+
+        IROp swappedOp = kIROp_Nop;
+        if (isCommutativeOp(inst->getOp()))
+            swappedOp = inst->getOp();
+        else
+            swappedOp = getSwapSideComparisonOp(inst->getOp());
+        if (swappedOp == kIROp_Nop)
+            return false;
+
+        outKey.op = swappedOp;
+        outKey.type = inst->getFullType();
+        outKey.operands.add(inst->getOperand(1));
+        outKey.operands.add(inst->getOperand(0));
+        return true;
+    }
+
+    IRInst* findAvailableValue(IRInst* inst, ValueKey const& key)
+    {
+        if (auto value = availableValues.tryGetValue(key))
+            return *value;
+        ValueKey swappedKey;
+        if (getSwappedKey(inst, swappedKey))
+        {
+            if (auto value = availableValues.tryGetValue(swappedKey))
+                return *value;
+        }
+        return nullptr;
+    }
+
+    /// Two parameters of the same block are congruent if every predecessor passes them the
+    /// same value, or if a predecessor passes each of them its own current value (as a loop
+    /// back edge does for a value that doesn't change in the loop).
+    static bool areParamsCongruent(
+        IRParam* param,
+        ShortList<IRInst*> const& args,
+        IRParam* otherParam,
+        ShortList<IRInst*> const& otherArgs)
+    {
+        if (param->getFullType() != otherParam->getFullType())
+            return false;
+        if (args.getCount() != otherArgs.getCount())
+            return false;
+        for (Index i = 0; i < args.getCount(); i++)
+        {
+            if (args[i] == otherArgs[i])
+                continue;
+            if (args[i] == param && otherArgs[i] == otherParam)
+                continue;
+            return false;
+        }
+        return true;
+    }
+
+    bool mergeCongruentParams(IRBlock* block)
+    {
+        if (block == func->getFirstBlock() || !block->getFirstParam())
+            return false;
+        for (auto pred : block->getPredecessors())
+        {
+            if (!as<IRUnconditionalBranch>(pred->getTerminator()))
+                return false;
+        }
+
+        bool changed = false;
+        for (bool merged = true; merged;)
+        {
+            merged = false;
+
+            List<IRParam*> params;
+            List<ShortList<IRInst*>> paramArgs;
+            for (auto param : block->getParams())
+            {
+                params.add(param);
+                paramArgs.add(getPhiArgs(param));
+            }
+
+            for (Index i = 0; i < params.getCount() && !merged; i++)
+            {
+                for (Index j = i + 1; j < params.getCount(); j++)
+                {
+                    if (!areParamsCongruent(params[i], paramArgs[i], params[j], paramArgs[j]))
+                        continue;
+
+                    params[j]->replaceUsesWith(params[i]);
+                    removePhiArgs(params[j]);
+                    params[j]->removeAndDeallocate();
+                    merged = true;
+                    changed = true;
+                    break;
+                }
+            }
+        }
+        return changed;
+    }
+
+    bool numberValuesInBlock(IRBlock* block)
+    {
+        bool changed = mergeCongruentParams(block);
+
+        for (auto inst = block->getFirstOrdinaryInst(); inst;)
+        {
+            auto next = inst->getNextInst();
+            if (isMovableInst(inst))
+            {
+                auto key = getKey(inst);
+                if (auto value = findAvailableValue(inst, key))
+                {
+                    inst->replaceUsesWith(value);
+                    inst->removeAndDeallocate();
+                    changed = true;
+                }
+                else
+                {
+                    availableValues[key] = inst;
+                    addedKeys.add(key);
+                }
+            }
+            inst = next;
+        }
+        return changed;
+    }
+
+    bool run()
+    {
+        auto root = func->getFirstBlock();
+        if (!root)
+            return false;
+        dom = computeDominatorTree(func);
+
+        // Walk the dominator tree in pre-order, so that a value is available in all
+        // the blocks its definition dominates. An explicit stack is used since the
+        // tree can be very deep in large functions.
+        struct StackEntry
+        {
+            IRBlock* block;
+            Index scopeStart;
+            bool visited;
+        };
+        List<StackEntry> stack;
+        stack.add(StackEntry{root, 0, false});
+
+        bool changed = false;
+        while (stack.getCount())
+        {
+            auto& entry = stack.getLast();
+            if (entry.visited)
+            {
+                for (Index i = entry.scopeStart; i < addedKeys.getCount(); i++)
+                    availableValues.remove(addedKeys[i]);
+                addedKeys.setCount(entry.scopeStart);
+                stack.removeLast();
+                continue;
+            }
+
+            auto block = entry.block;
+            entry.visited = true;
+            entry.scopeStart = addedKeys.getCount();
+            changed |= numberValuesInBlock(block);
+
+            for (auto child : dom->getImmediatelyDominatedBlocks(block))
+                stack.add(StackEntry{child, 0, false});
+        }
+        return changed;
+    }
+};
+
+} // namespace
+
+bool applyGlobalValueNumbering(IRGlobalValueWithCode* func)
+{
+    GlobalValueNumberingContext context;
+    context.func = func;
+    return context.run();
+}
+
+} // namespace Slang
@@ -0,0 +1,17 @@
+// slang-ir-gvn.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+
+/// Replace instructions that compute a value already available in a dominating block.
+///
+/// This subsumes the dominator-scoped deduplication done by `removeRedundancyInFunc`, and
+/// additionally recognizes commutative and mirrored comparison operations with swapped operands
+/// (`a + b` and `b + a`, `a < b` and `b > a`), as well as block parameters (phis) that always
+/// receive the same value from every predecessor.
+///
+/// Returns true if any change was made.
+bool applyGlobalValueNumbering(IRGlobalValueWithCode* func);
+} // namespace Slang
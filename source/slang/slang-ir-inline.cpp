@@ -16,7 +16,9 @@
 // on user-supplied hints, or on optimization criteria like performance and
 // code size.
 
+#include "slang-ir-call-graph.h"
 #include "slang-ir-clone.h"
+#include "slang-ir-dce.h"
 #include "slang-ir-insts.h"
 #include "slang-ir.h"
 
@@ -1045,6 +1047,198 @@ void performIntrinsicFunctionInlining(IRModule* module)
     }
 }
 
+/// An inlining pass that inlines any call site whose estimated cost is below a threshold.
+///
+/// The cost of a call site is the size of the callee's body, less the benefits we expect
+/// from inlining it at that particular site: removing the call overhead, folding
+/// constant arguments (in particular when they decide a branch in the callee), and
+/// letting resource-typed parameters resolve to the concrete resource.
+struct CostBasedInliningPass : InliningPassBase
+{
+    typedef InliningPassBase Super;
+
+    // Weights of the cost model, in units of "one instruction".
+    static const Count kConstantArgBonus = 2;
+    static const Count kConstantBranchArgBonus = 10;
+    static const Count kResourceParamBonus = 5;
+
+    // A callee with a single call site can be removed after inlining, so its
+    // code size doesn't grow and it is allowed a larger budget.
+    static const Count kSingleCallSiteThresholdScale = 8;
+
+    Count m_threshold = 0;
+    IRDeadCodeEliminationOptions m_deadCodeEliminationOptions;
+
+    HashSet<IRFunc*> m_recursiveFuncs;
+    Dictionary<IRFunc*, Count> m_funcSizes;
+
+    CostBasedInliningPass(
+        IRModule* module,
+        Count threshold,
+        IRDeadCodeEliminationOptions const& deadCodeEliminationOptions)
+        : Super(module)
+        , m_threshold(threshold)
+        , m_deadCodeEliminationOptions(deadCodeEliminationOptions)
+    {
+        findRecursiveFunctions(module, m_recursiveFuncs);
+    }
+
+    /// Returns the number of instructions in `func`, or -1 if `func` contains
+    /// something that must never be duplicated into another function.
+    Count getFuncSize(IRFunc* func)
+    {
+        if (auto size = m_funcSizes.tryGetValue(func))
+            return *size;
+
+        Count size = 0;
+        for (auto block : func->getBlocks())
+        {
+            for (auto inst : block->getOrdinaryInsts())
+            {
+                if (as<IRSPIRVAsm>(inst))
+                {
+                    size = -1;
+                    break;
+                }
+                size++;
+            }
+            if (size < 0)
+                break;
+        }
+        m_funcSizes[func] = size;
+        return size;
+    }
+
+    /// Returns true if `value` decides a branch, either directly or through a comparison.
+    static bool isUsedAsBranchCondition(IRInst* value)
+    {
+        for (auto use = value->firstUse; use; use = use->nextUse)
+        {
+            auto user = use->getUser();
+            if (auto condBranch = as<IRConditionalBranch>(user))
+            {
+                if (condBranch->getCondition() == value)
+                    return true;
+                continue;
+            }
+            if (auto switchInst = as<IRSwitch>(user))
+            {
+                if (switchInst->getCondition() == value)
+                    return true;
+                continue;
+            }
+            switch (user->getOp())
+            {
+            case kIROp_Less:
+            case kIROp_Leq:
+            case kIROp_Greater:
+            case kIROp_Geq:
+            case kIROp_Eql:
+            case kIROp_Neq:
+            case kIROp_And:
+            case kIROp_Or:
+            case kIROp_Not:
+                if (isUsedAsBranchCondition(user))
+                    return true;
+                break;
+            default:
+                break;
+            }
+        }
+        return false;
+    }
+
+    Count getCallSiteBonus(CallSiteInfo const& info)
+    {
+        auto call = info.call;
+
+        // The call itself and the copies of its arguments go away.
+        Count bonus = 1 + Count(call->getArgCount());
+
+        UInt argIndex = 0;
+        for (auto param : info.callee->getParams())
+        {
+            if (argIndex >= call->getArgCount())
+                break;
+            auto arg = call->getArg(argIndex++);
+
+            if (as<IRConstant>(arg))
+            {
+                bonus += kConstantArgBonus;
+                if (isUsedAsBranchCondition(param))
+                    bonus += kConstantBranchArgBonus;
+            }
+            if (isResourceType(param->getDataType()))
+                bonus += kResourceParamBonus;
+        }
+        return bonus;
+    }
+
+    /// Returns true if `callSite` is the only reference to its callee, and the callee
+    /// will be removed once the call has been inlined.
+    bool isOnlyCallSite(CallSiteInfo const& info)
+    {
+        IRInst* callee = info.specialize ? (IRInst*)info.generic : info.callee;
+        if (!callee->hasUses() || callee->firstUse->nextUse)
+            return false;
+        if (info.specialize && (!info.specialize->hasUses() || info.specialize->firstUse->nextUse))
+            return false;
+        return !shouldInstBeLiveIfParentIsLive(callee, m_deadCodeEliminationOptions);
+    }
+
+    bool shouldInline(CallSiteInfo const& info)
+    {
+        auto callee = info.callee;
+        if (m_recursiveFuncs.contains(callee))
+            return false;
+
+        // Calls that have been explicitly opted out of inlining, entry points and functions
+        // that map to a target intrinsic are left for the dedicated passes to handle.
+        for (auto decor : callee->getDecorations())
+        {
+            switch (decor->getOp())
+            {
+            case kIROp_NoInlineDecoration:
+            case kIROp_EntryPointDecoration:
+            case kIROp_TargetIntrinsicDecoration:
+            case kIROp_IntrinsicOpDecoration:
+                return false;
+            default:
+                break;
+            }
+        }
+        if (!isDefinition(callee))
+            return false;
+
+        Count size = getFuncSize(callee);
+        if (size < 0)
+            return false;
+
+        Count threshold = m_threshold;
+        if (isOnlyCallSite(info))
+            threshold *= kSingleCallSiteThresholdScale;
+
+        if (size - getCallSiteBonus(info) > threshold)
+            return false;
+
+        // The caller is about to grow, so its size must be recomputed.
+        if (auto caller = getParentFunc(info.call))
+            m_funcSizes.remove(caller);
+        return true;
+    }
+};
+
+bool performCostBasedInlining(
+    IRModule* module,
+    Count threshold,
+    IRDeadCodeEliminationOptions const& deadCodeEliminationOptions)
+{
+    SLANG_PROFILE;
+
+    CostBasedInliningPass pass(module, threshold, deadCodeEliminationOptions);
+    return pass.considerAllCallSites();
+}
+
 struct CustomInliningPass : InliningPassBase
 {
     typedef InliningPassBase Super;
@@ -12,6 +12,7 @@ struct IRGlobalValueWithCode;
 class DiagnosticSink;
 class TargetProgram;
 struct IRInst;
+struct IRDeadCodeEliminationOptions;
 
 /// Any call to a function that takes or returns a string/RefType parameter is inlined
 Result performTypeInlining(IRModule* module, DiagnosticSink* sink);
@@ -38,6 +39,15 @@ void performGLSLResourceReturnFunctionInlining(TargetProgram* targetProgram, IRM
 /// Inline simple intrinsic functions whose definition is a single asm block.
 void performIntrinsicFunctionInlining(IRModule* module);
 
+/// Inline call sites whose estimated cost, after subtracting the benefits that inlining enables at
+/// that call site, is no more than `threshold`. Recursive functions are never inlined.
+/// `deadCodeEliminationOptions` is used to tell whether a callee can be removed once its only
+/// call site has been inlined.
+bool performCostBasedInlining(
+    IRModule* module,
+    Count threshold,
+    IRDeadCodeEliminationOptions const& deadCodeEliminationOptions);
+
 /// Inline a specific call.
 bool inlineCall(IRCall* call);
 } // namespace Slang
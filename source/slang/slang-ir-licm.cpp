@@ -0,0 +1,204 @@
+// slang-ir-licm.cpp
+#include "slang-ir-licm.h"
+
+#include "slang-ir-dominators.h"
+#include "slang-ir-insts.h"
+#include "slang-ir-util.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+namespace
+{ // anonymous
+
+struct LoopInvariantCodeMotionContext
+{
+    IRGlobalValueWithCode* func;
+    RefPtr<IRDominatorTree> dom;
+
+    // The loop currently being processed.
+    IRLoop* loop = nullptr;
+    HashSet<IRBlock*> loopBlocks;
+    List<IRBlock*> loopBlocksInOrder;
+    List<IRBlock*> exitingBlocks;
+
+    /// Collect the blocks of `loop`: the blocks dominated by the loop header that are
+    /// not past the break block, in dominator tree pre-order.
+    void collectLoopBlocks()
+    {
+        loopBlocks.clear();
+        loopBlocksInOrder.clear();
+        exitingBlocks.clear();
+
+        auto breakBlock = loop->getBreakBlock();
+        List<IRBlock*> workList;
+        workList.add(loop->getTargetBlock());
+        while (workList.getCount())
+        {
+            auto block = workList.getLast();
+            workList.removeLast();
+            if (block == breakBlock)
+                continue;
+            loopBlocks.add(block);
+            loopBlocksInOrder.add(block);
+            for (auto child : dom->getImmediatelyDominatedBlocks(block))
+                workList.add(child);
+        }
+
+        for (auto block : loopBlocksInOrder)
+        {
+            bool isExiting = !as<IRUnconditionalBranch>(block->getTerminator()) &&
+                             !as<IRConditionalBranch>(block->getTerminator()) &&
+                             !as<IRSwitch>(block->getTerminator());
+            for (auto succ : block->getSuccessors())
+            {
+                if (!loopBlocks.contains(succ))
+                    isExiting = true;
+            }
+            if (isExiting)
+                exitingBlocks.add(block);
+        }
+    }
+
+    bool isDefinedInLoop(IRInst* inst)
+    {
+        if (!inst)
+            return false;
+        auto block = as<IRBlock>(inst->getParent());
+        return block && loopBlocks.contains(block);
+    }
+
+    bool areOperandsLoopInvariant(IRInst* inst)
+    {
+        if (isDefinedInLoop(inst->getFullType()))
+            return false;
+        for (UInt i = 0; i < inst->getOperandCount(); i++)
+        {
+            if (isDefinedInLoop(inst->getOperand(i)))
+                return false;
+        }
+        return true;
+    }
+
+    /// Is `block` executed whenever the loop is entered and left?
+    bool isExecutedOnEveryIteration(IRBlock* block)
+    {
+        // Nothing can be said about a loop that never exits.
+        if (exitingBlocks.getCount() == 0)
+            return false;
+        for (auto exitingBlock : exitingBlocks)
+        {
+            if (!dom->dominates(block, exitingBlock))
+                return false;
+        }
+        return true;
+    }
+
+    bool isLoopInvariantLoad(IRLoad* load)
+    {
+        auto addr = load->getPtr();
+
+        // Only loads of read-only memory, or of local variables, are considered: the
+        // contents of other global memory may be changed by other threads.
+        if (isGlobalOrUnknownMutableAddress(func, addr) &&
+            !isChildInstOf(getRootAddr(addr), func))
+            return false;
+
+        for (auto block : loopBlocksInOrder)
+        {
+            for (auto inst : block->getChildren())
+            {
+                if (canInstHaveSideEffectAtAddress(func, inst, addr))
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    bool shouldHoist(IRInst* inst)
+    {
+        if (!areOperandsLoopInvariant(inst))
+            return false;
+
+        switch (inst->getOp())
+        {
+        case kIROp_IRem:
+        case kIROp_Call:
+            // These may trap or be costly, so don't execute them when the original
+            // code might not have.
+            return isMovableInst(inst) &&
+                   isExecutedOnEveryIteration(as<IRBlock>(inst->getParent()));
+        case kIROp_Load:
+            if (isMovableInst(inst))
+                return true;
+            return isExecutedOnEveryIteration(as<IRBlock>(inst->getParent())) &&
+                   isLoopInvariantLoad(as<IRLoad>(inst));
+        default:
+            return isMovableInst(inst);
+        }
+    }
+
+    bool processLoop(IRLoop* inLoop)
+    {
+        loop = inLoop;
+        collectLoopBlocks();
+
+        // Instructions are visited in dominator order, so the loop invariant operands
+        // of an instruction have already been hoisted when it is considered.
+        bool changed = false;
+        for (auto block : loopBlocksInOrder)
+        {
+            for (auto inst = block->getFirstOrdinaryInst(); inst;)
+            {
+                auto next = inst->getNextInst();
+                if (shouldHoist(inst))
+                {
+                    inst->insertBefore(loop);
+                    changed = true;
+                }
+                inst = next;
+            }
+        }
+        return changed;
+    }
+
+    bool run()
+    {
+        auto root = func->getFirstBlock();
+        if (!root)
+            return false;
+        dom = computeDominatorTree(func);
+
+        // Visit loops outer to inner, so that an instruction is hoisted out of as many
+        // loops as possible.
+        List<IRLoop*> loops;
+        List<IRBlock*> workList;
+        workList.add(root);
+        while (workList.getCount())
+        {
+            auto block = workList.getLast();
+            workList.removeLast();
+            if (auto loopInst = as<IRLoop>(block->getTerminator()))
+                loops.add(loopInst);
+            for (auto child : dom->getImmediatelyDominatedBlocks(block))
+                workList.add(child);
+        }
+
+        bool changed = false;
+        for (auto loopInst : loops)
+            changed |= processLoop(loopInst);
+        return changed;
+    }
+};
+
+} // namespace
+
+bool applyLoopInvariantCodeMotion(IRGlobalValueWithCode* func)
+{
+    LoopInvariantCodeMotionContext context;
+    context.func = func;
+    return context.run();
+}
+
+} // namespace Slang
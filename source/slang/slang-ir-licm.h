@@ -0,0 +1,17 @@
+// slang-ir-licm.h
+#pragma once
+
+namespace Slang
+{
+struct IRGlobalValueWithCode;
+
+/// Move instructions whose value does not change between loop iterations to the block
+/// preceding the loop, hoisting out of as many nested loops as possible.
+///
+/// Side-effect free instructions are always considered for hoisting. Loads are hoisted when
+/// nothing in the loop may write to the loaded address, and when the load is executed on
+/// every iteration, so that hoisting never introduces a load that would not have happened.
+///
+/// Returns true if any change was made.
+bool applyLoopInvariantCodeMotion(IRGlobalValueWithCode* func);
+} // namespace Slang
@@ -3,6 +3,7 @@
 
 #include "../compiler-core/slang-artifact-associated.h"
 #include "slang-compiler.h"
+#include "slang-ir-pass-telemetry.h"
 
 namespace Slang
 {
@@ -14,6 +15,8 @@ struct LinkedIR
     IRVarLayout* globalScopeVarLayout;
     List<IRFunc*> entryPoints;
     ComPtr<IArtifactPostEmitMetadata> metadata;
+    /// Set if `linkAndOptimizeIR` was asked to record the telemetry of its passes
+    RefPtr<IRPassTelemetry> passTelemetry;
 };
 
 
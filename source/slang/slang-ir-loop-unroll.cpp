@@ -1,6 +1,7 @@
 #include "slang-ir-loop-unroll.h"
 
 #include "../core/slang-performance-profiler.h"
+#include "slang-compiler.h"
 #include "slang-ir-clone.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-dominators.h"
@@ -66,6 +67,177 @@ static int _getLoopMaxIterationsToUnroll(IRLoop* loopInst)
     return maxIterations;
 }
 
+// The default limit on the number of instructions a single loop can be unrolled into.
+static constexpr Count kDefaultUnrollSizeLimit = 65536;
+
+static Count _getUnrollSizeLimit(TargetProgram* targetProgram)
+{
+    if (targetProgram)
+    {
+        auto limit =
+            targetProgram->getOptionSet().getIntOption(CompilerOptionName::UnrollSizeLimit);
+        if (limit > 0)
+            return limit;
+    }
+    return kDefaultUnrollSizeLimit;
+}
+
+// Returns the number of iterations the loop runs for, if that is known from a simple induction
+// variable, or -1 otherwise.
+// The loop must exit only through the conditional branch at the end of its target block, which
+// compares a target block param against a constant. The param must start as a constant, and be
+// stepped by a constant on every back edge.
+static IRIntegerValue _getLoopKnownIterationCount(
+    IRLoop* loopInst,
+    List<IRBlock*> const& blocks,
+    IRIntegerValue maxIterationsToCount)
+{
+    auto targetBlock = loopInst->getTargetBlock();
+    auto breakBlock = loopInst->getBreakBlock();
+    auto condBranch = as<IRIfElse>(targetBlock->getTerminator());
+    if (!condBranch)
+        return -1;
+
+    HashSet<IRBlock*> blockSet;
+    for (auto block : blocks)
+        blockSet.add(block);
+
+    // Find out which side of the branch stays in the loop.
+    bool continueWhenTrue;
+    if (condBranch->getFalseBlock() == breakBlock && blockSet.contains(condBranch->getTrueBlock()))
+        continueWhenTrue = true;
+    else if (
+        condBranch->getTrueBlock() == breakBlock && blockSet.contains(condBranch->getFalseBlock()))
+        continueWhenTrue = false;
+    else
+        return -1;
+
+    // Any other way out of the loop (a `break`, `return` or a jump to an outer loop) means the
+    // condition only gives an upper bound.
+    for (auto block : blocks)
+    {
+        if (block == targetBlock)
+            continue;
+        for (auto succ : block->getSuccessors())
+        {
+            if (!blockSet.contains(succ))
+                return -1;
+        }
+        auto terminator = block->getTerminator();
+        if (!terminator || (!as<IRUnconditionalBranch>(terminator) &&
+                            !as<IRConditionalBranch>(terminator) && !as<IRSwitch>(terminator) &&
+                            !as<IRUnreachable>(terminator)))
+            return -1;
+    }
+
+    auto cond = condBranch->getCondition();
+    switch (cond->getOp())
+    {
+    case kIROp_Less:
+    case kIROp_Leq:
+    case kIROp_Greater:
+    case kIROp_Geq:
+    case kIROp_Neq:
+        break;
+    default:
+        return -1;
+    }
+    auto param = as<IRParam>(cond->getOperand(0));
+    auto bound = as<IRIntLit>(cond->getOperand(1));
+    if (!param || !bound || param->getParent() != targetBlock)
+        return -1;
+
+    UInt paramIndex = 0;
+    for (auto p : targetBlock->getParams())
+    {
+        if (p == param)
+            break;
+        paramIndex++;
+    }
+    auto initialValue = as<IRIntLit>(loopInst->getArg(paramIndex));
+    if (!initialValue)
+        return -1;
+
+    // Every back edge must step the param by the same constant.
+    IRIntegerValue step = 0;
+    for (auto use = targetBlock->firstUse; use; use = use->nextUse)
+    {
+        auto user = use->getUser();
+        if (user == loopInst)
+            continue;
+        auto branch = as<IRUnconditionalBranch>(user);
+        if (!branch || branch->getTargetBlock() != targetBlock ||
+            !blockSet.contains(as<IRBlock>(branch->getParent())) ||
+            paramIndex >= branch->getArgCount())
+            return -1;
+        auto update = branch->getArg(paramIndex);
+        if ((update->getOp() != kIROp_Add && update->getOp() != kIROp_Sub) ||
+            update->getOperand(0) != param)
+            return -1;
+        auto stepLit = as<IRIntLit>(update->getOperand(1));
+        if (!stepLit)
+            return -1;
+        auto updateStep =
+            update->getOp() == kIROp_Add ? stepLit->getValue() : -stepLit->getValue();
+        if (updateStep == 0 || (step != 0 && updateStep != step))
+            return -1;
+        step = updateStep;
+    }
+    if (step == 0)
+        return -1;
+
+    // Run the induction variable forward to count the iterations. We only need to count up to
+    // `maxIterationsToCount` to know the answer is too large.
+    IRIntegerValue value = initialValue->getValue();
+    IRIntegerValue iterationCount = 0;
+    for (; iterationCount <= maxIterationsToCount; iterationCount++)
+    {
+        bool condValue = false;
+        switch (cond->getOp())
+        {
+        case kIROp_Less:
+            condValue = value < bound->getValue();
+            break;
+        case kIROp_Leq:
+            condValue = value <= bound->getValue();
+            break;
+        case kIROp_Greater:
+            condValue = value > bound->getValue();
+            break;
+        case kIROp_Geq:
+            condValue = value >= bound->getValue();
+            break;
+        case kIROp_Neq:
+            condValue = value != bound->getValue();
+            break;
+        }
+        if (condValue != continueWhenTrue)
+            return iterationCount;
+        value += step;
+    }
+    return iterationCount;
+}
+
+// Returns true if any value defined in `blocks` is used outside of them.
+static bool _hasUsesOutsideBlocks(List<IRBlock*> const& blocks)
+{
+    HashSet<IRBlock*> blockSet;
+    for (auto block : blocks)
+        blockSet.add(block);
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                if (!blockSet.contains(as<IRBlock>(use->getUser()->getParent())))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
 static void _foldAndSimplifyLoopIteration(
     TargetProgram* targetProgram,
     IRBuilder& builder,
@@ -146,11 +318,25 @@ static void _foldAndSimplifyLoopIteration(
     }
 }
 
+enum class UnrollResult
+{
+    /// The loop has been unrolled, or didn't need to be.
+    Unrolled,
+
+    /// The loop didn't terminate within the iteration limit.
+    NotTerminated,
+
+    /// Unrolling the loop would produce too much code, so it is left as (or
+    /// the remaining iterations are left in) a loop.
+    ExceededSizeLimit,
+};
+
 // Unroll loop up to a predefined maximum number of iterations.
-// Returns true if we can statically determine that the loop terminated within the iteration limit.
+// Succeeds if we can statically determine that the loop terminated within the iteration limit,
+// and the unrolled code stays within the size limit.
 // This operation assumes the loop does not have `continue` jumps, i.e. continueBlock ==
 // targetBlock.
-static bool _unrollLoop(
+static UnrollResult _unrollLoop(
     TargetProgram* targetProgram,
     IRModule* module,
     IRLoop* loopInst,
@@ -162,17 +348,38 @@ static bool _unrollLoop(
         subBuilder.setInsertBefore(loopInst);
         subBuilder.emitBranch(loopInst->getBreakBlock());
         loopInst->removeAndDeallocate();
-        return true;
+        return UnrollResult::Unrolled;
     }
 
     auto maxIterations = _getLoopMaxIterationsToUnroll(loopInst);
     if (maxIterations < 0)
-        return true;
+        return UnrollResult::Unrolled;
+
+    // Refuse up front to unroll a loop that is known to run for more iterations than
+    // can fit in the size limit, rather than spending time to find out.
+    const Count sizeLimit = _getUnrollSizeLimit(targetProgram);
+    // Loops whose trip count isn't known are left to the size check made as each iteration is
+    // peeled off below.
+    const Count bodyInstCount = getInstCountInBlocks(blocks);
+    const auto knownIterationCount = _getLoopKnownIterationCount(
+        loopInst,
+        blocks,
+        sizeLimit / Math::Max(bodyInstCount, Count(1)) + 1);
+    if (knownIterationCount > 0 && knownIterationCount * bodyInstCount > sizeLimit)
+    {
+        // Leave the loop as is, and make sure we don't try again.
+        loopInst->findDecoration<IRForceUnrollDecoration>()->removeAndDeallocate();
+        return UnrollResult::ExceededSizeLimit;
+    }
 
     // We assume all `continue`s are eliminated and turned into multi-level breaks
     // before this operation.
     SLANG_RELEASE_ASSERT(loopInst->getContinueBlock() == loopInst->getTargetBlock());
 
+    // If values computed in the loop are used after it, the remaining iterations must be
+    // unrolled so that those uses can be redirected to the last iteration, whatever the size.
+    const bool canStopEarly = !_hasUsesOutsideBlocks(blocks);
+
     // Insert an outer breakable region so we have a break label to use as the target for
     // any `break` jumps in the unrolled loop.
     // Transform CFG from [..., loopInst] -> [loopTarget] ->... [originalLoopBreakBlock]
@@ -235,8 +442,19 @@ static bool _unrollLoop(
     }
 
     bool loopTerminated = false;
+    Count unrolledSize = 0;
     for (int attempedIterations = 0; attempedIterations < maxIterations; attempedIterations++)
     {
+        // Stop peeling iterations once the unrolled code gets too large. What has been peeled
+        // so far is still a valid program, with the remaining iterations left in the loop.
+        if (canStopEarly && unrolledSize > sizeLimit)
+        {
+            // As above, the remaining loop must not be unrolled again.
+            if (auto forceUnrollDecor = loopInst->findDecoration<IRForceUnrollDecoration>())
+                forceUnrollDecor->removeAndDeallocate();
+            return UnrollResult::ExceededSizeLimit;
+        }
+
         // Our task is to peel off the first iteration and put it in front of the
         // loop.
         // We will create a breakable region (via single iteration loop), and clone the loop body
@@ -301,6 +519,7 @@ static bool _unrollLoop(
                 loopInst->getContinueBlock(),
                 newParams.getCount(),
                 newParams.getBuffer()));
+            loopInst->transferDecorationsTo(newLoopInst);
             loopInst->removeAndDeallocate();
 
             // Update `loopInst` to represent the remaining loop iterations that are yet to be
@@ -356,6 +575,7 @@ static bool _unrollLoop(
             clonedBlocks,
             firstIterationBreakBlock,
             unreachableBlock);
+        unrolledSize += getInstCountInBlocks(clonedBlocks);
 
         // Now we have peeled off one iteration from the loop, we check if there are any
         // branches into next iteration, if not, the loop terminates and we are done.
@@ -423,7 +643,7 @@ static bool _unrollLoop(
         }
     }
 
-    return loopTerminated;
+    return loopTerminated ? UnrollResult::Unrolled : UnrollResult::NotTerminated;
 }
 
 // Visits all loop insts in a func, inner loop first.
@@ -471,11 +691,21 @@ bool unrollLoopsInFunc(
 
         auto blocks = collectBlocksInRegion(func, loop);
         auto loopLoc = loop->sourceLoc;
-        if (!_unrollLoop(targetProgram, module, loop, blocks))
+        switch (_unrollLoop(targetProgram, module, loop, blocks))
         {
+        case UnrollResult::Unrolled:
+            break;
+        case UnrollResult::NotTerminated:
             if (sink)
                 sink->diagnose(loopLoc, Diagnostics::cannotUnrollLoop);
             return false;
+        case UnrollResult::ExceededSizeLimit:
+            if (sink)
+                sink->diagnose(
+                    loopLoc,
+                    Diagnostics::loopUnrollSizeLimitExceeded,
+                    (int)_getUnrollSizeLimit(targetProgram));
+            break;
         }
 
         // Make sure we simplify things as much as possible before
@@ -505,6 +735,315 @@ bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink
     return true;
 }
 
+// Partially unroll `loopInst` by `factor`.
+// The loop body is replaced with `factor` copies of itself that run one after another, each
+// copy wrapped in a breakable region. A back edge in a copy becomes a break out of its region,
+// which then runs the next copy, and the last copy jumps back to the loop header. The exit
+// checks are kept in every copy, so the trip count doesn't need to be known, or be a multiple
+// of `factor`.
+// This operation assumes the loop does not have `continue` jumps, and that no value defined in
+// the loop is used outside of it.
+static void _partiallyUnrollLoop(
+    IRModule* module,
+    IRLoop* loopInst,
+    List<IRBlock*> const& blocks,
+    Count factor)
+{
+    SLANG_RELEASE_ASSERT(loopInst->getContinueBlock() == loopInst->getTargetBlock());
+
+    IRBuilder builder(module);
+    IRBuilderSourceLocRAII sourceLocationScope(&builder, loopInst->sourceLoc);
+
+    auto loopTargetBlock = loopInst->getTargetBlock();
+
+    // Create the new loop header, with the same phi params as the original one.
+    auto loopHeader = builder.createBlock();
+    loopHeader->insertBefore(loopTargetBlock);
+    builder.setInsertInto(loopHeader);
+    List<IRInst*> iterationParams;
+    {
+        IRCloneEnv paramCloneEnv;
+        for (auto param : loopTargetBlock->getParams())
+            iterationParams.add(cloneInst(&paramCloneEnv, &builder, param));
+    }
+
+    // Replace the loop inst with one that targets the new header.
+    {
+        builder.setInsertBefore(loopInst);
+        List<IRInst*> args;
+        for (UInt i = 0; i < loopInst->getArgCount(); i++)
+            args.add(loopInst->getArg(i));
+        auto newLoopInst = builder.emitLoop(
+            loopHeader,
+            loopInst->getBreakBlock(),
+            loopHeader,
+            args.getCount(),
+            args.getBuffer());
+        loopInst->transferDecorationsTo(newLoopInst);
+        loopInst->removeAndDeallocate();
+    }
+
+    IRBlock* iterationBlock = loopHeader;
+    for (Count i = 0; i < factor; i++)
+    {
+        auto regionHeader = builder.createBlock();
+        regionHeader->insertBefore(loopTargetBlock);
+        auto regionBreakBlock = builder.createBlock();
+        regionBreakBlock->insertBefore(loopTargetBlock);
+
+        // Enter the breakable region at the end of the previous iteration.
+        builder.setInsertInto(iterationBlock);
+        builder.emitLoop(regionHeader, regionBreakBlock, regionHeader);
+
+        // The back edges of this iteration jump into the region break block, which takes
+        // over the phi params of the loop target block.
+        IRCloneEnv cloneEnv;
+        UInt paramIndex = 0;
+        for (auto param : loopTargetBlock->getParams())
+            cloneEnv.mapOldValToNew[param] = iterationParams[paramIndex++];
+        cloneEnv.mapOldValToNew[loopTargetBlock] = regionBreakBlock;
+
+        builder.setInsertInto(regionBreakBlock);
+        iterationParams.clear();
+        {
+            IRCloneEnv paramCloneEnv;
+            for (auto param : loopTargetBlock->getParams())
+                iterationParams.add(cloneInst(&paramCloneEnv, &builder, param));
+        }
+
+        List<IRBlock*> clonedBlocks;
+        for (auto b : blocks)
+        {
+            auto clonedBlock = builder.createBlock();
+            clonedBlock->insertBefore(regionBreakBlock);
+            cloneEnv.mapOldValToNew.addIfNotExists(b, clonedBlock);
+            clonedBlocks.add(clonedBlock);
+        }
+        for (Index j = 0; j < blocks.getCount(); j++)
+        {
+            builder.setInsertInto(clonedBlocks[j]);
+            for (auto inst : blocks[j]->getChildren())
+                cloneInst(&cloneEnv, &builder, inst);
+        }
+
+        builder.setInsertInto(regionHeader);
+        builder.emitBranch(clonedBlocks[0]);
+
+        iterationBlock = regionBreakBlock;
+    }
+
+    // Jump back to the loop header after the last iteration.
+    builder.setInsertInto(iterationBlock);
+    builder.emitBranch(loopHeader, iterationParams.getCount(), iterationParams.getBuffer());
+
+    for (auto block : blocks)
+        block->removeAndDeallocate();
+}
+
+// Make the values defined in the loop that are used after it flow into the loop's break block
+// as phi params, so that the uses outside the loop no longer refer to the loop body.
+// Exits through an `ifElse` get a new block in the loop to pass the values from, which is added
+// to `blocks`. Returns false without changing anything if the loop has other kinds of exits.
+static bool _routeLoopResultsThroughBreakBlock(
+    IRModule* module,
+    IRLoop* loopInst,
+    List<IRBlock*>& blocks)
+{
+    auto breakBlock = loopInst->getBreakBlock();
+    HashSet<IRBlock*> blockSet;
+    for (auto block : blocks)
+        blockSet.add(block);
+
+    List<IRInst*> loopResults;
+    for (auto block : blocks)
+    {
+        for (auto inst : block->getChildren())
+        {
+            for (auto use = inst->firstUse; use; use = use->nextUse)
+            {
+                if (!blockSet.contains(as<IRBlock>(use->getUser()->getParent())))
+                {
+                    loopResults.add(inst);
+                    break;
+                }
+            }
+        }
+    }
+    if (loopResults.getCount() == 0)
+        return true;
+
+    // All exits must go to the break block, with a branch we know how to add arguments to.
+    List<IRInst*> exits;
+    for (auto block : blocks)
+    {
+        auto terminator = block->getTerminator();
+        bool isExit = false;
+        for (auto succ : block->getSuccessors())
+        {
+            if (blockSet.contains(succ))
+                continue;
+            if (succ != breakBlock)
+                return false;
+            isExit = true;
+        }
+        if (!isExit)
+            continue;
+        if (auto ifElse = as<IRIfElse>(terminator))
+        {
+            if (ifElse->getAfterBlock() == breakBlock)
+                return false;
+        }
+        else if (terminator->getOp() != kIROp_unconditionalBranch)
+        {
+            return false;
+        }
+        exits.add(terminator);
+    }
+
+    IRBuilder builder(module);
+    List<IRInst*> resultParams;
+    for (auto inst : loopResults)
+    {
+        auto param = builder.createParam(inst->getFullType());
+        breakBlock->addParam(param);
+        resultParams.add(param);
+    }
+
+    // Pass the results along every exit.
+    auto addResultArgs = [&](IRUnconditionalBranch* branch)
+    {
+        List<IRInst*> args;
+        for (UInt i = 0; i < branch->getArgCount(); i++)
+            args.add(branch->getArg(i));
+        args.addRange(loopResults);
+        builder.setInsertBefore(branch);
+        builder.emitBranch(breakBlock, args.getCount(), args.getBuffer());
+        branch->removeAndDeallocate();
+    };
+    for (auto exit : exits)
+    {
+        auto ifElse = as<IRIfElse>(exit);
+        if (!ifElse)
+        {
+            addResultArgs(as<IRUnconditionalBranch>(exit));
+            continue;
+        }
+        IRUse* edges[] = {&ifElse->trueBlock, &ifElse->falseBlock};
+        for (auto edge : edges)
+        {
+            if (edge->get() != breakBlock)
+                continue;
+            auto exitBlock = builder.createBlock();
+            exitBlock->insertAfter(as<IRBlock>(ifElse->getParent()));
+            builder.setInsertInto(exitBlock);
+            builder.emitBranch(breakBlock, loopResults.getCount(), loopResults.getBuffer());
+            edge->set(exitBlock);
+            blocks.add(exitBlock);
+            blockSet.add(exitBlock);
+        }
+    }
+
+    // Redirect the uses outside the loop to the new params.
+    for (Index i = 0; i < loopResults.getCount(); i++)
+    {
+        for (auto use = loopResults[i]->firstUse; use;)
+        {
+            auto nextUse = use->nextUse;
+            if (!blockSet.contains(as<IRBlock>(use->getUser()->getParent())))
+                use->set(resultParams[i]);
+            use = nextUse;
+        }
+    }
+    return true;
+}
+
+bool partiallyUnrollLoopsInFunc(
+    TargetProgram* targetProgram,
+    IRModule* module,
+    IRGlobalValueWithCode* func)
+{
+    // The number of instructions we aim for in the body of a partially unrolled loop.
+    static const Count kTargetUnrolledBodySize = 64;
+
+    const Count maxFactor =
+        targetProgram->getOptionSet().getIntOption(CompilerOptionName::PartialUnrollFactor);
+    if (maxFactor < 2)
+        return false;
+
+    // Only consider inner loops that the user hasn't asked to keep or to unroll.
+    List<IRLoop*> loops = collectLoopsInFunc(
+        func,
+        [](IRLoop* l)
+        {
+            return l->findDecoration<IRForceUnrollDecoration>() == nullptr &&
+                   l->findDecoration<IRLoopControlDecoration>() == nullptr;
+        });
+    if (loops.getCount() == 0)
+        return false;
+
+    // Limit the code growth of the function to half of its original size.
+    Count growthBudget = getInstCountInBlocks(func) / 2;
+
+    bool changed = false;
+    for (auto loop : loops)
+    {
+        eliminateContinueBlocks(module, loop);
+
+        auto blocks = collectBlocksInRegion(func, loop);
+        if (blocks.getCount() == 0)
+            continue;
+
+        // Breakable regions, such as the ones left by eliminating continue blocks, are fine.
+        bool hasInnerLoop = false;
+        for (auto block : blocks)
+        {
+            auto innerLoop = as<IRLoop>(block->getTerminator());
+            if (!innerLoop)
+                continue;
+            for (auto pred : innerLoop->getTargetBlock()->getPredecessors())
+            {
+                if (pred != block)
+                    hasInnerLoop = true;
+            }
+        }
+        if (hasInnerLoop)
+            continue;
+
+        const Count bodySize = getInstCountInBlocks(blocks);
+        Count factor = Math::Min(maxFactor, kTargetUnrolledBodySize / bodySize);
+        factor = Math::Min(factor, growthBudget / bodySize + 1);
+        if (factor < 2)
+            continue;
+
+        if (!_routeLoopResultsThroughBreakBlock(module, loop, blocks))
+            continue;
+
+        _partiallyUnrollLoop(module, loop, blocks, factor);
+        growthBudget -= (factor - 1) * bodySize;
+        changed = true;
+    }
+
+    if (changed)
+    {
+        simplifyCFG(func, CFGSimplificationOptions::getDefault());
+        eliminateDeadCode(func);
+    }
+    return changed;
+}
+
+bool partiallyUnrollLoopsInModule(TargetProgram* target, IRModule* module)
+{
+    SLANG_PROFILE;
+
+    bool changed = false;
+    for (auto inst : module->getGlobalInsts())
+    {
+        if (auto func = as<IRFunc>(inst))
+            changed |= partiallyUnrollLoopsInFunc(target, module, func);
+    }
+    return changed;
+}
+
 void eliminateContinueBlocks(IRModule* module, IRLoop* loopInst)
 {
     // Eliminate the continue jumps by turning a loop in the form of:
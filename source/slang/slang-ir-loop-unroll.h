@@ -21,6 +21,16 @@ bool unrollLoopsInFunc(
 
 bool unrollLoopsInModule(TargetProgram* target, IRModule* module, DiagnosticSink* sink);
 
+// Partially unroll small inner loops that are not marked with `[unroll]`, `[loop]` or
+// `[ForceUnroll]`, by up to the factor set with `-partial-unroll-factor`.
+// Return true if any loop was changed.
+bool partiallyUnrollLoopsInFunc(
+    TargetProgram* target,
+    IRModule* module,
+    IRGlobalValueWithCode* func);
+
+bool partiallyUnrollLoopsInModule(TargetProgram* target, IRModule* module);
+
 // Turn a loop with continue block into a loop with only back jumps and breaks.
 // Each iteration will be wrapped in a breakable region, where everything before `continue`
 // is within the breakable region, and everything after `continue` is outside the breakable
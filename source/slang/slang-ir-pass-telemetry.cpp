@@ -0,0 +1,119 @@
+// slang-ir-pass-telemetry.cpp
+#include "slang-ir-pass-telemetry.h"
+
+#include "../compiler-core/slang-pretty-writer.h"
+#include "slang-ir-insts.h"
+#include "slang-ir.h"
+
+namespace Slang
+{
+
+static void _addSizes(IRInst* inst, IRPassTelemetry::Sizes& ioSizes)
+{
+    ioSizes.instCount++;
+    if (as<IRFunc>(inst))
+        ioSizes.funcCount++;
+
+    for (auto child : inst->getDecorationsAndChildren())
+        _addSizes(child, ioSizes);
+}
+
+static void _writeSizes(PrettyWriter& writer, const IRPassTelemetry::Sizes& sizes)
+{
+    writer << "{\"instCount\": " << int64_t(sizes.instCount);
+    writer << ", \"funcCount\": " << int64_t(sizes.funcCount);
+    writer << ", \"arenaBytes\": " << uint64_t(sizes.arenaBytes) << "}";
+}
+
+IRPassTelemetry::IRPassTelemetry()
+    : m_startTime(Clock::now())
+{
+}
+
+/* static */ IRPassTelemetry::Sizes IRPassTelemetry::calcSizes(IRModule* module)
+{
+    Sizes sizes;
+    _addSizes(module->getModuleInst(), sizes);
+    sizes.arenaBytes = module->getMemoryArena().calcTotalMemoryUsed();
+    return sizes;
+}
+
+void IRPassTelemetry::record(IRModule* module, const char* name)
+{
+    const auto endTime = Clock::now();
+
+    Pass pass;
+    pass.name = name;
+    pass.seconds = std::chrono::duration<double>(endTime - m_startTime).count();
+    pass.hasBefore = m_passes.getCount() != 0;
+    pass.before = m_sizes;
+    pass.after = calcSizes(module);
+
+    m_sizes = pass.after;
+    m_passes.add(pass);
+
+    // The time taken to measure the module isn't part of the next pass.
+    m_startTime = Clock::now();
+}
+
+void IRPassTelemetry::writeJSON(
+    PrettyWriter& writer,
+    const UnownedStringSlice& targetName,
+    const List<String>& entryPointNames) const
+{
+    double totalSeconds = 0;
+    for (const auto& pass : m_passes)
+        totalSeconds += pass.seconds;
+
+    writer << "{\n";
+    writer.indent();
+
+    writer << "\"target\": ";
+    writer.writeEscapedString(targetName);
+    writer << ",\n";
+
+    writer << "\"entryPoints\": [";
+    for (Index i = 0; i < entryPointNames.getCount(); ++i)
+    {
+        if (i)
+            writer << ", ";
+        writer.writeEscapedString(entryPointNames[i].getUnownedSlice());
+    }
+    writer << "],\n";
+
+    writer << "\"totalSeconds\": " << float(totalSeconds) << ",\n";
+
+    writer << "\"passes\": [\n";
+    writer.indent();
+    {
+        CommaTrackerRAII commaTracker(writer);
+        for (const auto& pass : m_passes)
+        {
+            writer.maybeComma();
+            writer << "{\n";
+            writer.indent();
+            writer << "\"name\": ";
+            writer.writeEscapedString(pass.name.getUnownedSlice());
+            writer << ",\n";
+            writer << "\"seconds\": " << float(pass.seconds) << ",\n";
+            if (pass.hasBefore)
+            {
+                writer << "\"before\": ";
+                _writeSizes(writer, pass.before);
+                writer << ",\n";
+            }
+            writer << "\"after\": ";
+            _writeSizes(writer, pass.after);
+            writer << "\n";
+            writer.dedent();
+            writer << "}";
+        }
+    }
+    writer.dedent();
+    writer << "\n]\n";
+
+    writer.dedent();
+    writer << "}\n";
+}
+
+} // namespace Slang
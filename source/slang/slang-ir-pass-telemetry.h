@@ -0,0 +1,69 @@
+// slang-ir-pass-telemetry.h
+#pragma once
+
+#include "../core/slang-basic.h"
+
+#include <chrono>
+
+namespace Slang
+{
+
+struct IRModule;
+struct PrettyWriter;
+
+/// Records the time taken by, and the size of the IR module after, each of the passes
+/// of `linkAndOptimizeIR`.
+///
+/// A pass is everything done between two calls to `record`, or between creating the
+/// telemetry and the first call. Time spent dumping or validating the IR in between is
+/// counted too, so those options should be off when the timings matter.
+class IRPassTelemetry : public RefObject
+{
+public:
+    struct Sizes
+    {
+        /// The number of instructions in the module, including decorations
+        Count instCount = 0;
+        /// The number of functions in the module, including those nested in generics
+        Count funcCount = 0;
+        /// Bytes used in the memory arena of the module. Instructions are not freed when
+        /// they are removed, so this only grows.
+        size_t arenaBytes = 0;
+    };
+
+    struct Pass
+    {
+        String name;
+        double seconds = 0;
+        /// False for the first pass, which links the module from others rather than starting
+        /// from an IR module of its own, so `before` isn't set.
+        bool hasBefore = false;
+        Sizes before;
+        Sizes after;
+    };
+
+    IRPassTelemetry();
+
+    /// End the current pass, which is called `name`, and start the next one.
+    void record(IRModule* module, const char* name);
+
+    const List<Pass>& getPasses() const { return m_passes; }
+
+    /// Write the passes as a JSON object, identifying the compilation that they were
+    /// recorded for by the name of the target and the names of the entry points.
+    void writeJSON(
+        PrettyWriter& writer,
+        const UnownedStringSlice& targetName,
+        const List<String>& entryPointNames) const;
+
+    static Sizes calcSizes(IRModule* module);
+
+protected:
+    typedef std::chrono::high_resolution_clock Clock;
+
+    List<Pass> m_passes;
+    Sizes m_sizes;
+    Clock::time_point m_startTime;
+};
+
+} // namespace Slang
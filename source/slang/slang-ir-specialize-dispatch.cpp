@@ -7,6 +7,151 @@
 
 namespace Slang
 {
+// A possible target of a dispatch function: the block that calls the implementation
+// of the requirement provided by `witnessTable`.
+struct DispatchCase
+{
+    IRWitnessTable* witnessTable;
+    IRIntLit* id;
+    IRBlock* block;
+};
+
+// Dispatch over more cases than this is split by binary search on the sequential ID,
+// so that no single `switch` gets too large.
+static const Index kMaxDispatchSwitchCaseCount = 32;
+
+// The most frequent conformances covering this fraction of the profiled dispatches are
+// tested for before the general dispatch logic, up to `kMaxHotDispatchCaseCount` of them.
+static const double kHotDispatchCoverage = 0.9;
+static const Index kMaxHotDispatchCaseCount = 4;
+
+static bool doesProfileEntryMatch(UnownedStringSlice entry, IRWitnessTable* witnessTable)
+{
+    auto concreteType = witnessTable->getConcreteType();
+    if (auto nameHint = concreteType->findDecoration<IRNameHintDecoration>())
+    {
+        if (nameHint->getName() == entry)
+            return true;
+    }
+    if (auto linkage = concreteType->findDecoration<IRLinkageDecoration>())
+    {
+        if (linkage->getMangledName() == entry)
+            return true;
+    }
+    return false;
+}
+
+// Returns the indices into `cases` of the conformances that should get a fast path,
+// most frequent first.
+static List<Index> findHotDispatchCases(
+    SharedGenericsLoweringContext* sharedContext,
+    List<DispatchCase> const& cases)
+{
+    List<Index> hotCases;
+    auto profile = sharedContext->targetProgram->getOptionSet().getArray(
+        CompilerOptionName::DynamicDispatchProfile);
+    if (profile.getCount() == 0)
+        return hotCases;
+
+    List<Int> counts;
+    Int totalCount = 0;
+    for (auto dispatchCase : cases)
+    {
+        Int count = 0;
+        for (auto& entry : profile)
+        {
+            auto name = entry.stringValue.getUnownedSlice();
+            if (doesProfileEntryMatch(name, dispatchCase.witnessTable))
+                count += entry.intValue;
+        }
+        counts.add(count);
+        totalCount += count;
+    }
+    if (totalCount == 0)
+        return hotCases;
+
+    List<Index> order;
+    for (Index i = 0; i < cases.getCount(); i++)
+        order.add(i);
+    order.stableSort([&](Index a, Index b) { return counts[a] > counts[b]; });
+
+    // The least frequent conformance is always left to the general dispatch logic,
+    // which needs at least one case.
+    Int coveredCount = 0;
+    for (auto caseIndex : order)
+    {
+        if (hotCases.getCount() == kMaxHotDispatchCaseCount ||
+            hotCases.getCount() == cases.getCount() - 1)
+            break;
+        if (counts[caseIndex] == 0 || coveredCount >= totalCount * kHotDispatchCoverage)
+            break;
+        hotCases.add(caseIndex);
+        coveredCount += counts[caseIndex];
+    }
+    return hotCases;
+}
+
+// Branch from `block` to the case in `cases` whose ID is `id`. The last case is used
+// when no other case matches.
+static void emitDispatchCaseSelection(
+    IRBuilder* builder,
+    IRFunc* func,
+    IRBlock* block,
+    IRInst* id,
+    ArrayView<DispatchCase> cases)
+{
+    if (cases.getCount() == 1)
+    {
+        // If there is only 1 case, no switch statement is necessary.
+        builder->setInsertInto(block);
+        builder->emitBranch(cases[0].block);
+        return;
+    }
+
+    if (cases.getCount() > kMaxDispatchSwitchCaseCount)
+    {
+        // `cases` is sorted by ID, so split it in half and select the half
+        // that contains `id`.
+        auto middle = cases.getCount() / 2;
+        builder->setInsertInto(func);
+        auto lowBlock = builder->emitBlock();
+        auto highBlock = builder->emitBlock();
+        auto afterBlock = builder->emitBlock();
+        builder->setInsertInto(afterBlock);
+        builder->emitUnreachable();
+
+        builder->setInsertInto(block);
+        auto isLow = builder->emitLess(id, cases[middle].id);
+        builder->emitIfElse(isLow, lowBlock, highBlock, afterBlock);
+
+        emitDispatchCaseSelection(builder, func, lowBlock, id, cases.head(middle));
+        emitDispatchCaseSelection(builder, func, highBlock, id, cases.tail(middle));
+        return;
+    }
+
+    // Emit a switch statement to call the correct concrete function based on
+    // the witness table sequential ID passed in.
+    List<IRInst*> caseArgs;
+    for (Index i = 0; i < cases.getCount() - 1; i++)
+    {
+        caseArgs.add(cases[i].id);
+        caseArgs.add(cases[i].block);
+    }
+
+    builder->setInsertInto(func);
+    auto breakBlock = builder->emitBlock();
+    builder->setInsertInto(breakBlock);
+    builder->emitUnreachable();
+
+    builder->setInsertInto(block);
+    builder->emitSwitch(
+        id,
+        breakBlock,
+        cases.getLast().block,
+        caseArgs.getCount(),
+        caseArgs.getBuffer());
+}
+
 IRFunc* specializeDispatchFunction(
     SharedGenericsLoweringContext* sharedContext,
     IRFunc* dispatchFunc)
@@ -70,8 +215,6 @@ IRFunc* specializeDispatchFunction(
     builder->setInsertInto(newDispatchFunc);
     auto newBlock = builder->emitBlock();
 
-    IRBlock* defaultBlock = nullptr;
-
     auto requirementKey = lookupInst->getRequirementKey();
     List<IRInst*> params;
     for (Index i = 0; i < paramTypes.getCount(); i++)
@@ -92,7 +235,7 @@ IRFunc* specializeDispatchFunction(
         builder->emitSwizzle(builder->getUIntType(), witnessTableParam, 1, &elemIdx);
 
     // Generate case blocks for each possible witness table.
-    List<IRInst*> caseBlocks;
+    List<DispatchCase> cases;
     for (Index i = 0; i < witnessTables.getCount(); i++)
     {
         auto witnessTable = witnessTables[i];
@@ -105,21 +248,13 @@ IRFunc* specializeDispatchFunction(
                 witnessTable->getConcreteType());
         }
 
-        if (i != witnessTables.getCount() - 1)
-        {
-            // Create a case block if we are not the last case.
-            caseBlocks.add(seqIdDecoration->getSequentialIDOperand());
-            builder->setInsertInto(newDispatchFunc);
-            auto caseBlock = builder->emitBlock();
-            caseBlocks.add(caseBlock);
-        }
-        else
-        {
-            // Generate code for the last possible value in the `default` block.
-            builder->setInsertInto(newDispatchFunc);
-            defaultBlock = builder->emitBlock();
-            builder->setInsertInto(defaultBlock);
-        }
+        builder->setInsertInto(newDispatchFunc);
+        DispatchCase dispatchCase;
+        dispatchCase.witnessTable = witnessTable;
+        dispatchCase.id = seqIdDecoration->getSequentialIDOperand();
+        dispatchCase.block = builder->emitBlock();
+        cases.add(dispatchCase);
+        builder->setInsertInto(dispatchCase.block);
 
         auto callee = findWitnessTableEntry(witnessTable, requirementKey);
         SLANG_ASSERT(callee);
@@ -130,32 +265,7 @@ IRFunc* specializeDispatchFunction(
             builder->emitReturn(specializedCallInst);
     }
 
-    // Emit a switch statement to call the correct concrete function based on
-    // the witness table sequential ID passed in.
-    builder->setInsertInto(newDispatchFunc);
-
-
-    if (witnessTables.getCount() == 1)
-    {
-        // If there is only 1 case, no switch statement is necessary.
-        builder->setInsertInto(newBlock);
-        builder->emitBranch(defaultBlock);
-    }
-    else if (witnessTables.getCount() > 1)
-    {
-        auto breakBlock = builder->emitBlock();
-        builder->setInsertInto(breakBlock);
-        builder->emitUnreachable();
-
-        builder->setInsertInto(newBlock);
-        builder->emitSwitch(
-            witnessTableSequentialID,
-            breakBlock,
-            defaultBlock,
-            caseBlocks.getCount(),
-            caseBlocks.getBuffer());
-    }
-    else
+    if (cases.getCount() == 0)
     {
         // We have no witness tables that implements this interface.
         // Just return a default value.
@@ -170,6 +280,45 @@ IRFunc* specializeDispatchFunction(
             builder->emitReturn(defaultValue);
         }
     }
+    else
+    {
+        // Test for the conformances that a dispatch profile says are the most frequent
+        // first, so they don't pay for the general dispatch logic.
+        auto hotCases = findHotDispatchCases(sharedContext, cases);
+        IRBlock* dispatchBlock = newBlock;
+        for (auto hotCase : hotCases)
+        {
+            builder->setInsertInto(newDispatchFunc);
+            auto nextBlock = builder->emitBlock();
+            auto afterBlock = builder->emitBlock();
+            builder->setInsertInto(afterBlock);
+            builder->emitUnreachable();
+
+            builder->setInsertInto(dispatchBlock);
+            auto isHotCase = builder->emitEql(witnessTableSequentialID, cases[hotCase].id);
+            builder->emitIfElse(isHotCase, cases[hotCase].block, nextBlock, afterBlock);
+            dispatchBlock = nextBlock;
+        }
+
+        List<DispatchCase> remainingCases;
+        for (Index i = 0; i < cases.getCount(); i++)
+        {
+            if (!hotCases.contains(i))
+                remainingCases.add(cases[i]);
+        }
+        if (remainingCases.getCount() > kMaxDispatchSwitchCaseCount)
+        {
+            remainingCases.sort([](DispatchCase const& a, DispatchCase const& b)
+                                { return a.id->getValue() < b.id->getValue(); });
+        }
+        emitDispatchCaseSelection(
+            builder,
+            newDispatchFunc,
+            dispatchBlock,
+            witnessTableSequentialID,
+            remainingCases.getArrayView());
+    }
+
     // Remove old implementation.
     dispatchFunc->replaceUsesWith(newDispatchFunc);
     dispatchFunc->removeAndDeallocate();
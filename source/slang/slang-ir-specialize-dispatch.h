@@ -9,5 +9,8 @@ struct SharedGenericsLoweringContext;
 /// of function pointer calls to implement the dynamic dispatch logic.
 /// This is only used on GPU targets where function pointers are not supported
 /// or are not efficient.
+///
+/// Conformances that the `DynamicDispatchProfile` option reports as frequent are tested for
+/// first, and large sets of conformances are dispatched by a binary search over `switch`es.
 void specializeDispatchFunctions(SharedGenericsLoweringContext* sharedContext);
 } // namespace Slang
@@ -4,6 +4,8 @@
 #include "../core/slang-performance-profiler.h"
 #include "slang-ir-dce.h"
 #include "slang-ir-deduplicate-generic-children.h"
+#include "slang-ir-gvn.h"
+#include "slang-ir-licm.h"
 #include "slang-ir-peephole.h"
 #include "slang-ir-propagate-func-properties.h"
 #include "slang-ir-redundancy-removal.h"
@@ -30,6 +32,12 @@ IRSimplificationOptions IRSimplificationOptions::getDefault(TargetProgram* targe
         result.deadCodeElimOptions.keepGlobalParamsAlive =
             targetProgram->getOptionSet().getBoolOption(CompilerOptionName::PreserveParameters);
     result.deadCodeElimOptions.useFastAnalysis = result.minimalOptimization;
+    if (targetProgram && !result.minimalOptimization)
+    {
+        auto optimizationLevel = targetProgram->getOptionSet().getEnumOption<OptimizationLevel>(
+            CompilerOptionName::Optimization);
+        result.hoistLoopInvariants = optimizationLevel >= OptimizationLevel::High;
+    }
     return result;
 }
 
@@ -91,6 +99,11 @@ void simplifyIR(
                 funcChanged |= peepholeOptimize(target, func);
                 if (options.removeRedundancy)
                     funcChanged |= removeRedundancyInFunc(func);
+                if (options.hoistLoopInvariants)
+                {
+                    funcChanged |= applyGlobalValueNumbering(func);
+                    funcChanged |= applyLoopInvariantCodeMotion(func);
+                }
                 funcChanged |= simplifyCFG(func, options.cfgOptions);
                 // Note: we disregard the `changed` state from dead code elimination pass since
                 // SCCP pass could be generating temporarily evaluated constant values and never
@@ -154,6 +167,11 @@ void simplifyFunc(
         changed |= peepholeOptimize(target, func);
         if (!options.minimalOptimization)
             changed |= removeRedundancyInFunc(func);
+        if (options.hoistLoopInvariants)
+        {
+            changed |= applyGlobalValueNumbering(func);
+            changed |= applyLoopInvariantCodeMotion(func);
+        }
         changed |= simplifyCFG(func, options.cfgOptions);
 
         // Note: we disregard the `changed` state from dead code elimination pass since
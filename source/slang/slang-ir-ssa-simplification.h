@@ -21,6 +21,10 @@ struct IRSimplificationOptions
     bool minimalOptimization = false;
     bool removeRedundancy = false;
 
+    // Run global value numbering and loop invariant code motion on each function.
+    // Enabled by `getDefault` at optimization level 2 and above.
+    bool hoistLoopInvariants = false;
+
     static IRSimplificationOptions getDefault(TargetProgram* targetProgram);
 
     static IRSimplificationOptions getFast(TargetProgram* targetProgram);
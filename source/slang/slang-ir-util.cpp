@@ -1587,6 +1587,30 @@ void moveParams(IRBlock* dest, IRBlock* src)
     }
 }
 
+static Count _getInstCountInBlock(IRBlock* block)
+{
+    Count count = 0;
+    for (auto inst = block->getFirstChild(); inst; inst = inst->getNextInst())
+        count++;
+    return count;
+}
+
+Count getInstCountInBlocks(List<IRBlock*> const& blocks)
+{
+    Count count = 0;
+    for (auto block : blocks)
+        count += _getInstCountInBlock(block);
+    return count;
+}
+
+Count getInstCountInBlocks(IRGlobalValueWithCode* code)
+{
+    Count count = 0;
+    for (auto block : code->getBlocks())
+        count += _getInstCountInBlock(block);
+    return count;
+}
+
 List<IRBlock*> collectBlocksInRegion(
     IRDominatorTree* dom,
     IRLoop* loop,
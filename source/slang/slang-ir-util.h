@@ -280,6 +280,12 @@ void resetScratchDataBit(IRInst* inst, int bitIndex);
 ///
 void moveParams(IRBlock* dest, IRBlock* src);
 
+/// Returns the number of instructions (including params) in `blocks`.
+Count getInstCountInBlocks(List<IRBlock*> const& blocks);
+
+/// Returns the number of instructions (including params) in the blocks of `code`.
+Count getInstCountInBlocks(IRGlobalValueWithCode* code);
+
 List<IRBlock*> collectBlocksInRegion(IRDominatorTree* dom, IRLoop* loop);
 
 List<IRBlock*> collectBlocksInRegion(IRDominatorTree* dom, IRSwitch* switchInst);
@@ -662,6 +662,17 @@ bool isForceInlineEarly(Decl* decl)
     return decl->hasModifier<UnsafeForceInlineEarlyAttribute>();
 }
 
+/// Is `decl` a function with a deferred body that its module left out of its IR?
+///
+/// Such a function is lowered, body and all, into each module that uses it, in the
+/// same way as a `[__unsafeForceInlineEarly]` function.
+///
+bool isDeferredFunctionBodyLeftToUser(Decl* decl)
+{
+    auto module = getModule(decl);
+    return module && module->hasDeferredFunctionBodies() && !module->isFunctionBodyLowered(decl);
+}
+
 bool isImportedDecl(IRGenContext* context, Decl* decl, bool& outIsExplicitExtern)
 {
     // If the declaration has the extern attribute then it must be imported
@@ -10271,11 +10282,24 @@ struct DeclLoweringVisitor : DeclVisitor<DeclLoweringVisitor, LoweredValInfo>
             // (although we might have to give in eventually), so
             // this case should really only occur for builtin declarations.
         }
-        else if (isDeclInDifferentModule(context, decl) && !isForceInlineEarly(decl))
+        else if (
+            isDeclInDifferentModule(context, decl) && !isForceInlineEarly(decl) &&
+            !isDeferredFunctionBodyLeftToUser(decl))
         {
         }
-        else if (emitBody)
+        else if (
+            emitBody &&
+            ensureFunctionBodyChecked(context->shared->m_linkage, decl, context->getSink()))
         {
+            // Record the deferred bodies lowered into the IR of their own module, so
+            // that modules using them don't lower them again.
+            auto declModule = getModule(decl);
+            if (declModule && declModule->hasDeferredFunctionBodies() &&
+                !isDeclInDifferentModule(context, decl))
+            {
+                declModule->addFunctionWithLoweredBody(decl);
+            }
+
             // This is a function definition, so we need to actually
             // construct IR for the body...
             IRBlock* entryBlock = subBuilder->emitBlock();
@@ -11465,8 +11489,39 @@ static void lowerProgramEntryPointToIR(
 }
 
 /// Ensure that `decl` and all relevant declarations under it get emitted.
-static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
+/// Can lowering `decl` be left until something that is lowered references it?
+///
+/// This holds for functions, unless they are entry points or can be used from
+/// outside of the module, or are attached to another function as a derivative
+/// or substitute without being referenced by it.
+///
+static bool _canLowerOnDemand(Decl* decl)
 {
+    if (auto genericDecl = as<GenericDecl>(decl))
+        decl = genericDecl->inner;
+
+    auto funcDecl = as<FunctionDeclBase>(decl);
+    if (!funcDecl)
+        return false;
+
+    return !funcDecl->hasModifier<EntryPointAttribute>() &&
+           !funcDecl->hasModifier<HLSLExportModifier>() &&
+           !funcDecl->hasModifier<DllExportAttribute>() &&
+           !funcDecl->hasModifier<ExternCppModifier>() &&
+           !funcDecl->hasModifier<DerivativeOfAttribute>() &&
+           !funcDecl->hasModifier<PrimalSubstituteOfAttribute>();
+}
+
+/// Ensure that `decl` and the declarations nested in it have been lowered.
+///
+/// If `lowerFunctionsOnDemand` is set, functions that `_canLowerOnDemand` are
+/// skipped, and only lowered if one of the declarations lowered references them.
+///
+static void ensureAllDeclsRec(IRGenContext* context, Decl* decl, bool lowerFunctionsOnDemand)
+{
+    if (lowerFunctionsOnDemand && _canLowerOnDemand(decl))
+        return;
+
     ensureDecl(context, decl);
 
     // Note: We are checking here for aggregate type declarations, and
@@ -11482,26 +11537,26 @@ static void ensureAllDeclsRec(IRGenContext* context, Decl* decl)
     {
         for (auto memberDecl : containerDecl->members)
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerFunctionsOnDemand);
         }
     }
     else if (auto namespaceDecl = as<NamespaceDecl>(decl))
     {
         for (auto memberDecl : namespaceDecl->members)
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerFunctionsOnDemand);
         }
     }
     else if (auto fileDecl = as<FileDecl>(decl))
     {
         for (auto memberDecl : fileDecl->members)
         {
-            ensureAllDeclsRec(context, memberDecl);
+            ensureAllDeclsRec(context, memberDecl, lowerFunctionsOnDemand);
         }
     }
     else if (auto genericDecl = as<GenericDecl>(decl))
     {
-        ensureAllDeclsRec(context, genericDecl->inner);
+        ensureAllDeclsRec(context, genericDecl->inner, lowerFunctionsOnDemand);
     }
 }
 
@@ -11569,9 +11624,22 @@ RefPtr<IRModule> generateIRForTranslationUnit(
     //
     // Next, ensure that all other global declarations have
     // been emitted.
+    //
+    // If the IR of the module is only used to compile its entry points, we
+    // leave functions to be lowered when the code lowered so far references them,
+    // so that only the functions reachable from the entry points are lowered.
+    //
+    // The same goes for a module with deferred function bodies, so that only
+    // the bodies it needs itself are checked here. The bodies of the other
+    // functions are checked and lowered by the modules that use them.
+    //
+    const bool lowerFunctionsOnDemand =
+        (compileRequest->lowerReachableDeclsOnly &&
+         translationUnit->getEntryPoints().getCount()) ||
+        translationUnit->getModule()->hasDeferredFunctionBodies();
     for (auto decl : translationUnit->getModuleDecl()->members)
     {
-        ensureAllDeclsRec(context, decl);
+        ensureAllDeclsRec(context, decl, lowerFunctionsOnDemand);
     }
 
     // Build a global instruction to hold all the string
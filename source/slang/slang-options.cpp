@@ -17,6 +17,7 @@
 #include "../core/slang-command-options-writer.h"
 #include "../core/slang-file-system.h"
 #include "../core/slang-hex-dump-util.h"
+#include "../core/slang-io.h"
 #include "../core/slang-name-value.h"
 #include "../core/slang-string-slice-pool.h"
 #include "../core/slang-type-text-util.h"
@@ -29,6 +30,7 @@
 #include "slang.h"
 
 #include <assert.h>
+#include <limits>
 
 namespace Slang
 {
@@ -63,6 +65,7 @@ enum class ValueCategory
     FileSystemType,
     VulkanShift,
     SourceEmbedStyle,
+    AutodiffCheckpointPolicy,
 
     CountOf,
 };
@@ -90,6 +93,17 @@ SLANG_GET_VALUE_CATEGORY(OptimizationLevel, SlangOptimizationLevel)
 SLANG_GET_VALUE_CATEGORY(VulkanShift, HLSLToVulkanLayoutOptions::Kind)
 SLANG_GET_VALUE_CATEGORY(SourceEmbedStyle, SourceEmbedUtil::Style)
 SLANG_GET_VALUE_CATEGORY(Language, SourceLanguage)
+SLANG_GET_VALUE_CATEGORY(AutodiffCheckpointPolicy, AutodiffCheckpointPolicy)
+
+static const NamesDescriptionValue kAutodiffCheckpointPolicyInfos[] = {
+    {ValueInt(AutodiffCheckpointPolicy::Default),
+     "default",
+     "Decide whether to store or recompute each value with fixed rules."},
+    {ValueInt(AutodiffCheckpointPolicy::CostModel),
+     "cost-model",
+     "Recompute side-effect free calls instead of storing their results, cheapest first, until "
+     "the estimated size of the checkpoint context fits within -autodiff-checkpoint-budget."},
+};
 
 } // namespace
 
@@ -209,6 +223,13 @@ void initCommandOptions(CommandOptions& options)
             "Source Embed Style",
             UserValue(ValueCategory::SourceEmbedStyle));
         options.addValues(SourceEmbedUtil::getStyleInfos());
+
+        options.addCategory(
+            CategoryKind::Value,
+            "autodiff-checkpoint-policy",
+            "Autodiff Checkpoint Policy",
+            UserValue(ValueCategory::AutodiffCheckpointPolicy));
+        options.addValues(makeConstArrayView(kAutodiffCheckpointPolicyInfos));
     }
 
     /* !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! target !!!!!!!!!!!!!!!!!!!!!!!!!!!!!!! */
@@ -358,6 +379,18 @@ void initCommandOptions(CommandOptions& options)
          "-emit-ir",
          nullptr,
          "Emit IR typically as a '.slang-module' when outputting to a container."},
+        {OptionKind::ValidateModuleTimestamps,
+         "-validate-module-timestamps",
+         nullptr,
+         "When checking whether a precompiled module is up to date, compare the size, "
+         "modification time and file identity of each source file with those recorded in the "
+         "module, and only read and hash the files that differ."},
+        {OptionKind::ModuleDigestCache,
+         "-module-digest-cache",
+         "-module-digest-cache <file>",
+         "Keep the digests of source files hashed while checking whether precompiled modules are "
+         "up to date in <file>, so they can be reused by other compilations while the files are "
+         "unchanged. Used with -validate-module-timestamps."},
         {OptionKind::Help,
          "-h,-help,--help",
          "-h or -h <help-category>",
@@ -392,6 +425,18 @@ void initCommandOptions(CommandOptions& options)
          "-minimum-slang-optimization",
          nullptr,
          "Perform minimum code optimization in Slang to favor compilation time."},
+        {OptionKind::LazyFunctionBodyChecking,
+         "-lazy-function-body-checking",
+         nullptr,
+         "Only check the signatures of functions in imported modules up front. The body of such "
+         "a function is checked, and lowered to IR, when code being compiled uses it. Errors in "
+         "bodies that are never used are not reported."},
+        {OptionKind::DemandDrivenIRLowering,
+         "-demand-driven-ir-lowering",
+         nullptr,
+         "Only lower the functions reachable from the entry points to IR, when the compile "
+         "doesn't output or precompile modules. Errors that are detected in IR, such as missing "
+         "returns, are not reported for functions that are never used."},
         {OptionKind::DisableNonEssentialValidations,
          "-disable-non-essential-validations",
          nullptr,
@@ -478,10 +523,35 @@ void initCommandOptions(CommandOptions& options)
          nullptr,
          "Reports information about checkpoint contexts used for reverse-mode automatic "
          "differentiation."},
+        {OptionKind::AutodiffCheckpointPolicy,
+         "-autodiff-checkpoint-policy",
+         "-autodiff-checkpoint-policy <autodiff-checkpoint-policy>",
+         "Set how reverse-mode automatic differentiation decides whether primal values are "
+         "stored in the checkpoint context or recomputed."},
+        {OptionKind::AutodiffCheckpointBudget,
+         "-autodiff-checkpoint-budget",
+         "-autodiff-checkpoint-budget <bytes>",
+         "Set the memory budget, in bytes per thread, for the values of each function that the "
+         "cost-model checkpoint policy can choose to recompute. Defaults to 0, which "
+         "recomputes everything it can."},
         {OptionKind::SkipSPIRVValidation,
          "-skip-spirv-validation",
          nullptr,
          "Skips spirv validation."},
+        {OptionKind::FastSPIRVOptimization,
+         "-fast-spirv-optimization",
+         nullptr,
+         "At the default optimization level, clean up SPIR-V generated directly by Slang with a "
+         "fast built-in pass instead of spirv-opt. The built-in pass removes unused globals and "
+         "functions, and redundant decorations, and merges blocks. -O2 and -O3 still use "
+         "spirv-opt."},
+        {OptionKind::ParallelSPIRVFinalization,
+         "-parallel-spirv-finalization",
+         nullptr,
+         "Finalize the functions of SPIR-V generated directly by Slang (block merging and "
+         "flattening into words) on multiple threads, once they have been emitted. The functions "
+         "themselves are still emitted serially. Only modules with many functions are split "
+         "across threads."},
         {OptionKind::SourceEmbedStyle,
          "-source-embed-style",
          "-source-embed-style <source-embed-style>",
@@ -520,7 +590,17 @@ void initCommandOptions(CommandOptions& options)
         {OptionKind::EmitReflectionJSON,
          "-reflection-json",
          "reflection-json <path>",
-         "Emit reflection data in JSON format to a file."}};
+         "Emit reflection data in JSON format to a file."},
+        {OptionKind::EmitReflectionSnapshot,
+         "-reflection-snapshot",
+         "-reflection-snapshot <path>",
+         "Emit reflection data to a file, in the flat binary format that "
+         "slang-reflection-snapshot.h reads."},
+        {OptionKind::ReflectionSnapshotArtifact,
+         "-reflection-snapshot-artifact",
+         nullptr,
+         "Add the reflection data, in the format of -reflection-snapshot, to the results of "
+         "IComponentType::getResultAsFileSystem."}};
 
     _addOptions(makeConstArrayView(generalOpts), options);
 
@@ -582,6 +662,29 @@ void initCommandOptions(CommandOptions& options)
          "-O...",
          "-O<optimization-level>",
          "Set the optimization level."},
+        {OptionKind::DynamicDispatchProfile,
+         "-dispatch-profile,-dispatch-profile-entry",
+         "-dispatch-profile <file>, -dispatch-profile-entry <type-name> <count>",
+         "Read how often each type is seen at dynamic dispatch sites from <file>, which holds one "
+         "'<type-name> <count>' pair per line, or give a single pair with "
+         "-dispatch-profile-entry. Dispatch code tests for the most frequent "
+         "conformances before falling back to the general dispatch logic."},
+        {OptionKind::InlineThreshold,
+         "-inline-threshold",
+         "-inline-threshold <n>",
+         "Inline calls to functions whose estimated cost is at most <n> instructions, after "
+         "accounting for constant arguments and resource parameters at the call site. Recursive "
+         "functions are never inlined. Default is 0, which disables cost-based inlining."},
+        {OptionKind::UnrollSizeLimit,
+         "-unroll-size-limit",
+         "-unroll-size-limit <n>",
+         "Limit the number of instructions a single loop can be unrolled into to <n>. Loops that "
+         "would exceed the limit are left (partially) rolled with a warning. Default is 65536."},
+        {OptionKind::PartialUnrollFactor,
+         "-partial-unroll-factor",
+         "-partial-unroll-factor <n>",
+         "Partially unroll loops that are not marked for unrolling by up to <n> times, when the "
+         "loop body is small enough. Default is 0, which disables partial unrolling."},
         {OptionKind::Obfuscate,
          "-obfuscate",
          nullptr,
@@ -705,6 +808,12 @@ void initCommandOptions(CommandOptions& options)
          "Pass arguments to downstream <compiler>. Just -X<compiler> passes just the next argument "
          "to the downstream compiler. -X<compiler>... options -X. will pass *all* of the options "
          "inbetween the opening -X and -X. to the downstream compiler."},
+        {OptionKind::DisablePrecompiledPrelude,
+         "-disable-precompiled-prelude",
+         nullptr,
+         "Don't use a precompiled header for the C++ prelude when compiling generated C++ with "
+         "gcc or clang. By default the prelude is precompiled once for each combination of "
+         "compiler and options, and reused."},
         {OptionKind::PassThrough,
          "-pass-through",
          "-pass-through <compiler>",
@@ -776,6 +885,16 @@ void initCommandOptions(CommandOptions& options)
          "-dump-ir-ids",
          nullptr,
          "Dump the IDs with -dump-ir (debug builds only)"},
+        {OptionKind::EmitIRPassTelemetry,
+         "-ir-pass-telemetry",
+         "-ir-pass-telemetry <path>",
+         "Record the time taken by each pass of IR linking and optimization, and the size of the "
+         "IR after it, and write them to a file in JSON format."},
+        {OptionKind::IRPassTelemetryArtifact,
+         "-ir-pass-telemetry-artifact",
+         nullptr,
+         "Record the IR pass telemetry, in the format of -ir-pass-telemetry, and add it to the "
+         "results of IComponentType::getResultAsFileSystem."},
         {OptionKind::PreprocessorOutput,
          "-E,-output-preprocessor",
          nullptr,
@@ -866,7 +985,7 @@ void initCommandOptions(CommandOptions& options)
          "-ir-compression",
          "-ir-compression <type>",
          "Set compression for IR and AST outputs.\n"
-         "Accepted compression types: none, lite"},
+         "Accepted compression types: none, lite, stream-vbyte, stream-vbyte-lz4"},
         {OptionKind::LoadCoreModule,
          "-load-core-module",
          "-load-core-module <filename>",
@@ -1135,6 +1254,7 @@ struct OptionsParser
     SlangResult _parseReferenceModule(const CommandLineArg& arg);
     SlangResult _parseReproFileSystem(const CommandLineArg& arg);
     SlangResult _parseLoadRepro(const CommandLineArg& arg);
+    SlangResult _parseDynamicDispatchProfile(const CommandLineArg& arg);
     SlangResult _parseDebugInformation(const CommandLineArg& arg);
     SlangResult _parseProfile(const CommandLineArg& arg);
     SlangResult _parseHelp(const CommandLineArg& arg);
@@ -1964,6 +2084,73 @@ SlangResult OptionsParser::_parseLoadRepro(const CommandLineArg& arg)
     return SLANG_OK;
 }
 
+// Makes the option value for a dynamic dispatch profile entry. Counts are stored as `int`, so
+// larger counts are clamped, which keeps them ordered above all smaller counts.
+static CompilerOptionValue _makeDynamicDispatchProfileValue(String const& typeName, Int count)
+{
+    CompilerOptionValue value = CompilerOptionValue::fromString(typeName);
+    value.intValue = int(Math::Min(count, Int(std::numeric_limits<int>::max())));
+    return value;
+}
+
+SlangResult OptionsParser::_parseDynamicDispatchProfile(const CommandLineArg& arg)
+{
+    if (arg.value == "-dispatch-profile-entry")
+    {
+        CommandLineArg typeName;
+        SLANG_RETURN_ON_FAIL(m_reader.expectArg(typeName));
+        Int count;
+        SLANG_RETURN_ON_FAIL(_expectInt(arg, count));
+        if (count < 0)
+        {
+            m_sink->diagnose(
+                arg.loc,
+                Diagnostics::invalidDispatchProfileLine,
+                typeName.value + " " + String(count));
+            return SLANG_FAIL;
+        }
+
+        m_requestImpl->getLinkage()->m_optionSet.add(
+            CompilerOptionName::DynamicDispatchProfile,
+            _makeDynamicDispatchProfileValue(typeName.value, count));
+        return SLANG_OK;
+    }
+
+    CommandLineArg profilePath;
+    SLANG_RETURN_ON_FAIL(m_reader.expectArg(profilePath));
+
+    String contents;
+    if (SLANG_FAILED(File::readAllText(profilePath.value, contents)))
+    {
+        m_sink->diagnose(profilePath.loc, Diagnostics::unableToReadFile, profilePath.value);
+        return SLANG_FAIL;
+    }
+
+    // Each line holds a type name and how many times it was seen at dynamic dispatch
+    // sites. Empty lines and lines starting with `#` are ignored.
+    for (auto line : LineParser(contents.getUnownedSlice()))
+    {
+        line = line.trim();
+        if (line.getLength() == 0 || line[0] == '#')
+            continue;
+
+        List<UnownedStringSlice> fields;
+        StringUtil::splitOnWhitespace(line, fields);
+        Int count = 0;
+        if (fields.getCount() != 2 || SLANG_FAILED(StringUtil::parseInt(fields[1], count)) ||
+            count < 0)
+        {
+            m_sink->diagnose(profilePath.loc, Diagnostics::invalidDispatchProfileLine, line);
+            return SLANG_FAIL;
+        }
+
+        m_requestImpl->getLinkage()->m_optionSet.add(
+            CompilerOptionName::DynamicDispatchProfile,
+            _makeDynamicDispatchProfileValue(fields[0], count));
+    }
+    return SLANG_OK;
+}
+
 SlangResult OptionsParser::_parseDebugInformation(const CommandLineArg& arg)
 {
     auto name = arg.value.getUnownedSlice().tail(2);
@@ -2126,6 +2313,13 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::ReportPerfBenchmark:
         case OptionKind::ReportCheckpointIntermediates:
         case OptionKind::SkipSPIRVValidation:
+        case OptionKind::FastSPIRVOptimization:
+        case OptionKind::ParallelSPIRVFinalization:
+        case OptionKind::ValidateModuleTimestamps:
+        case OptionKind::LazyFunctionBodyChecking:
+        case OptionKind::DemandDrivenIRLowering:
+        case OptionKind::ReflectionSnapshotArtifact:
+        case OptionKind::IRPassTelemetryArtifact:
         case OptionKind::DisableSpecialization:
         case OptionKind::DisableDynamicDispatch:
         case OptionKind::TrackLiveness:
@@ -2154,6 +2348,7 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoopInversion:
         case OptionKind::UnscopedEnum:
         case OptionKind::PreserveParameters:
+        case OptionKind::DisablePrecompiledPrelude:
             linkage->m_optionSet.set(optionKind, true);
             break;
         case OptionKind::MatrixLayoutRow:
@@ -2258,6 +2453,13 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::Doc, true);
                 break;
             }
+        case OptionKind::ModuleDigestCache:
+            {
+                CommandLineArg cachePath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(cachePath));
+                linkage->m_optionSet.set(optionKind, cachePath.value);
+                break;
+            }
         case OptionKind::DumpRepro:
             {
                 CommandLineArg dumpRepro;
@@ -2295,6 +2497,9 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
         case OptionKind::LoadRepro:
             SLANG_RETURN_ON_FAIL(_parseLoadRepro(arg));
             break;
+        case OptionKind::DynamicDispatchProfile:
+            SLANG_RETURN_ON_FAIL(_parseDynamicDispatchProfile(arg));
+            break;
         case OptionKind::LoadReproDirectory:
             {
                 CommandLineArg reproDirectory;
@@ -2695,6 +2900,27 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.set(CompilerOptionName::EmitReflectionJSON, outputPath.value);
                 break;
             }
+        case OptionKind::EmitReflectionSnapshot:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                linkage->m_optionSet.set(
+                    CompilerOptionName::EmitReflectionSnapshot,
+                    outputPath.value);
+                break;
+            }
+        case OptionKind::EmitIRPassTelemetry:
+            {
+                CommandLineArg outputPath;
+                SLANG_RETURN_ON_FAIL(m_reader.expectArg(outputPath));
+
+                // The telemetry written to the file is gathered from what is recorded with
+                // the results.
+                linkage->m_optionSet.set(CompilerOptionName::EmitIRPassTelemetry, outputPath.value);
+                linkage->m_optionSet.set(CompilerOptionName::IRPassTelemetryArtifact, true);
+                break;
+            }
         case OptionKind::DepFile:
             {
                 CommandLineArg dependencyPath;
@@ -2923,6 +3149,35 @@ SlangResult OptionsParser::_parse(int argc, char const* const* argv)
                 linkage->m_optionSet.add(OptionKind::BindlessSpaceIndex, (int)index);
                 break;
             }
+        case OptionKind::AutodiffCheckpointPolicy:
+            {
+                AutodiffCheckpointPolicy policy;
+                SLANG_RETURN_ON_FAIL(_expectValue(policy));
+                linkage->m_optionSet.set(optionKind, policy);
+                break;
+            }
+        case OptionKind::AutodiffCheckpointBudget:
+            {
+                Int budget = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, budget));
+                linkage->m_optionSet.set(optionKind, (int)budget);
+                break;
+            }
+        case OptionKind::InlineThreshold:
+            {
+                Int threshold = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, threshold));
+                linkage->m_optionSet.set(optionKind, (int)threshold);
+                break;
+            }
+        case OptionKind::UnrollSizeLimit:
+        case OptionKind::PartialUnrollFactor:
+            {
+                Int value = 0;
+                SLANG_RETURN_ON_FAIL(_expectInt(arg, value));
+                linkage->m_optionSet.set(optionKind, (int)value);
+                break;
+            }
         default:
             {
                 // Hmmm, we looked up and produced a valid enum, but it wasn't handled in the
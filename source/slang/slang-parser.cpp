@@ -8295,20 +8295,25 @@ Stmt* parseUnparsedStmt(
     Scope* currentScope,
     Scope* outerScope)
 {
+    // Bodies checked once the front-end request has gone, such as deferred function
+    // bodies, are parsed with the options of their module.
+    auto linkage = semanticsVisitor->getLinkage();
+    CompilerOptionSet& optionSet =
+        translationUnit ? translationUnit->compileRequest->optionSet
+                        : semanticsVisitor->getShared()->getModule()->getOptionSet();
+
     ParserOptions options = {};
     options.stage = ParsingStage::Body;
-    options.enableEffectAnnotations = translationUnit->compileRequest->optionSet.getBoolOption(
-        CompilerOptionName::EnableEffectAnnotations);
-    options.allowGLSLInput =
-        translationUnit->compileRequest->optionSet.getBoolOption(CompilerOptionName::AllowGLSL) ||
-        sourceLanguage == SourceLanguage::GLSL;
-    options.isInLanguageServer =
-        translationUnit->compileRequest->getLinkage()->isInLanguageServer();
-    options.optionSet = translationUnit->compileRequest->optionSet;
+    options.enableEffectAnnotations =
+        optionSet.getBoolOption(CompilerOptionName::EnableEffectAnnotations);
+    options.allowGLSLInput = optionSet.getBoolOption(CompilerOptionName::AllowGLSL) ||
+                             sourceLanguage == SourceLanguage::GLSL;
+    options.isInLanguageServer = linkage->isInLanguageServer();
+    options.optionSet = optionSet;
 
     Parser parser(astBuilder, tokens, sink, outerScope, options);
     parser.currentScope = outerScope;
-    parser.namePool = translationUnit->getNamePool();
+    parser.namePool = translationUnit ? translationUnit->getNamePool() : linkage->getNamePool();
     parser.sourceLanguage = sourceLanguage;
     parser.semanticsVisitor = semanticsVisitor;
     parser.currentScope = parser.currentLookupScope = currentScope;
@@ -3241,6 +3241,7 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
     // If not create a new one, and add to the list of known source files
     if (!sourceFile)
     {
+        const FileStamp stamp = SourceFile::calcStampBeforeRead(filePathInfo);
         ComPtr<ISlangBlob> foundSourceBlob;
         if (SLANG_FAILED(readFile(context, filePathInfo.foundPath, foundSourceBlob.writeRef())))
         {
@@ -3249,6 +3250,7 @@ static void HandleIncludeDirective(PreprocessorDirectiveContext* context)
         }
 
         sourceFile = sourceManager->createSourceFileWithBlob(filePathInfo, foundSourceBlob);
+        sourceFile->setStamp(stamp);
         sourceManager->addSourceFile(filePathInfo.uniqueIdentity, sourceFile);
     }
 
@@ -1289,13 +1289,7 @@ SLANG_API SlangInt spReflectionTypeLayout_findFieldIndexByName(
 
     if (auto structTypeLayout = as<StructTypeLayout>(typeLayout))
     {
-        Index fieldCount = structTypeLayout->fields.getCount();
-        for (Index f = 0; f < fieldCount; ++f)
-        {
-            auto field = structTypeLayout->fields[f];
-            if (getReflectionName(field->getVariable())->text.getUnownedSlice() == name)
-                return f;
-        }
+        return structTypeLayout->findFieldIndexByName(name);
     }
 
     return -1;
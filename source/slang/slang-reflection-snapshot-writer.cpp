@@ -0,0 +1,252 @@
+#include "slang-reflection-snapshot-writer.h"
+
+#include "../core/slang-blob.h"
+#include "../core/slang-dictionary.h"
+#include "slang-reflection-snapshot.h"
+
+namespace Slang
+{
+using namespace slang::reflection_snapshot;
+
+namespace
+{ // anonymous
+
+/// Builds the records of a snapshot by walking the public reflection API.
+struct SnapshotBuilder
+{
+    static uint32_t _toUInt32(size_t value)
+    {
+        return value > size_t(kNone) ? kNone : uint32_t(value);
+    }
+
+    uint32_t addString(const char* text)
+    {
+        if (!text || !*text)
+            return 0;
+
+        const UnownedStringSlice slice(text);
+        if (auto offset = m_stringOffsets.tryGetValue(slice))
+            return *offset;
+
+        const uint32_t offset = uint32_t(m_strings.getCount());
+        m_strings.addRange(slice.begin(), slice.getLength());
+        m_strings.add(0);
+        m_stringOffsets.add(slice, offset);
+        return offset;
+    }
+
+    uint32_t addType(slang::TypeLayoutReflection* typeLayout)
+    {
+        if (!typeLayout)
+            return kNone;
+
+        if (auto index = m_typeIndices.tryGetValue(typeLayout))
+            return *index;
+
+        // Register the index before visiting other types, because a type (such as a
+        // pointer) can refer back to itself.
+        const uint32_t index = uint32_t(m_types.getCount());
+        m_types.add(TypeRecord{});
+        m_typeIndices.add(typeLayout, index);
+
+        TypeRecord record = {};
+        record.kind = uint32_t(typeLayout->getKind());
+        if (auto type = typeLayout->getType())
+        {
+            record.name = addString(type->getName());
+            record.scalarType = uint32_t(type->getScalarType());
+            record.rowCount = type->getRowCount();
+            record.columnCount = type->getColumnCount();
+            record.resourceShape = uint32_t(type->getResourceShape());
+            record.resourceAccess = uint32_t(type->getResourceAccess());
+        }
+        record.uniformSize = _toUInt32(typeLayout->getSize());
+        record.uniformAlignment = uint32_t(typeLayout->getAlignment());
+
+        if (record.kind == SLANG_TYPE_KIND_ARRAY)
+        {
+            record.elementCount = _toUInt32(typeLayout->getElementCount());
+            record.uniformStride =
+                _toUInt32(typeLayout->getElementStride(SLANG_PARAMETER_CATEGORY_UNIFORM));
+        }
+
+        // The fields of a structure are held consecutively, so they are allocated
+        // before the types they refer to add fields of their own.
+        if (record.kind == SLANG_TYPE_KIND_STRUCT)
+        {
+            record.fieldCount = typeLayout->getFieldCount();
+            record.firstField = uint32_t(m_fields.getCount());
+            m_fields.setCount(m_fields.getCount() + record.fieldCount);
+            for (uint32_t i = 0; i < record.fieldCount; ++i)
+            {
+                setField(record.firstField + i, typeLayout->getFieldByIndex(i));
+            }
+        }
+
+        record.elementType = addType(typeLayout->getElementTypeLayout());
+
+        m_types[index] = record;
+        return index;
+    }
+
+    void setField(uint32_t fieldIndex, slang::VariableLayoutReflection* var)
+    {
+        FieldRecord record = {};
+        record.name = addString(var->getName());
+        record.type = addType(var->getTypeLayout());
+        record.semanticName = addString(var->getSemanticName());
+        record.semanticIndex = _toUInt32(var->getSemanticIndex());
+
+        auto typeLayout = var->getTypeLayout();
+        record.firstBinding = uint32_t(m_bindings.getCount());
+        record.bindingCount = var->getCategoryCount();
+        for (uint32_t i = 0; i < record.bindingCount; ++i)
+        {
+            auto category = SlangParameterCategory(var->getCategoryByIndex(i));
+
+            BindingRecord binding;
+            binding.category = uint32_t(category);
+            binding.index = _toUInt32(var->getOffset(category));
+            binding.space = _toUInt32(var->getBindingSpace(category));
+            binding.count = typeLayout ? _toUInt32(typeLayout->getSize(category)) : 0;
+            m_bindings.add(binding);
+        }
+
+        m_fields[fieldIndex] = record;
+    }
+
+    uint32_t addField(slang::VariableLayoutReflection* var)
+    {
+        if (!var)
+            return kNone;
+        const uint32_t index = uint32_t(m_fields.getCount());
+        m_fields.add(FieldRecord{});
+        setField(index, var);
+        return index;
+    }
+
+    /// Add the fields for a list of `count` variables, which are read with `getVar`.
+    template<typename F>
+    uint32_t addFields(uint32_t count, const F& getVar)
+    {
+        const uint32_t first = uint32_t(m_fields.getCount());
+        m_fields.setCount(first + count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            setField(first + i, getVar(i));
+        }
+        return first;
+    }
+
+    void addEntryPoint(slang::EntryPointReflection* entryPoint)
+    {
+        EntryPointRecord record = {};
+        record.name = addString(entryPoint->getName());
+        record.stage = uint32_t(entryPoint->getStage());
+
+        if (entryPoint->getStage() == SLANG_STAGE_COMPUTE)
+        {
+            SlangUInt threadGroupSize[3] = {};
+            entryPoint->getComputeThreadGroupSize(3, threadGroupSize);
+            for (int i = 0; i < 3; ++i)
+                record.threadGroupSize[i] = _toUInt32(threadGroupSize[i]);
+        }
+
+        record.parameterCount = entryPoint->getParameterCount();
+        record.firstParameter = addFields(
+            record.parameterCount,
+            [&](uint32_t i) { return entryPoint->getParameterByIndex(i); });
+        record.result = addField(entryPoint->getResultVarLayout());
+
+        m_entryPoints.add(record);
+    }
+
+    template<typename T>
+    static void _appendSection(
+        List<uint8_t>& out,
+        Section& outSection,
+        const List<T>& records)
+    {
+        outSection.offset = uint32_t(out.getCount());
+        outSection.count = uint32_t(records.getCount());
+        outSection.recordSize = uint32_t(sizeof(T));
+        out.addRange((const uint8_t*)records.getBuffer(), records.getCount() * Index(sizeof(T)));
+    }
+
+    void write(slang::ShaderReflection* reflection, List<uint8_t>& out)
+    {
+        // The string table starts with the empty string, which offset 0 refers to.
+        m_strings.add(0);
+
+        const uint32_t parameterCount = reflection->getParameterCount();
+        const uint32_t firstParameter = addFields(
+            parameterCount,
+            [&](uint32_t i) { return reflection->getParameterByIndex(i); });
+
+        const auto entryPointCount = reflection->getEntryPointCount();
+        for (SlangUInt i = 0; i < entryPointCount; ++i)
+        {
+            addEntryPoint(reflection->getEntryPointByIndex(i));
+        }
+
+        Header header = {};
+        header.magic = kMagic;
+        header.version = kVersion;
+        header.firstParameter = firstParameter;
+        header.parameterCount = parameterCount;
+
+        out.clear();
+        out.setCount(sizeof(Header));
+        _appendSection(out, header.sections[Index(SectionKind::Types)], m_types);
+        _appendSection(out, header.sections[Index(SectionKind::Fields)], m_fields);
+        _appendSection(out, header.sections[Index(SectionKind::Bindings)], m_bindings);
+        _appendSection(out, header.sections[Index(SectionKind::EntryPoints)], m_entryPoints);
+
+        header.stringsOffset = uint32_t(out.getCount());
+        header.stringsSize = uint32_t(m_strings.getCount());
+        out.addRange((const uint8_t*)m_strings.getBuffer(), m_strings.getCount());
+
+        // Keep the size a multiple of 4, so snapshots can be concatenated and stay aligned.
+        while (out.getCount() & 3)
+            out.add(0);
+
+        header.size = uint32_t(out.getCount());
+        ::memcpy(out.getBuffer(), &header, sizeof(header));
+    }
+
+    List<TypeRecord> m_types;
+    List<FieldRecord> m_fields;
+    List<BindingRecord> m_bindings;
+    List<EntryPointRecord> m_entryPoints;
+    List<char> m_strings;
+
+    Dictionary<slang::TypeLayoutReflection*, uint32_t> m_typeIndices;
+    Dictionary<UnownedStringSlice, uint32_t> m_stringOffsets;
+};
+
+} // namespace
+
+void writeReflectionSnapshot(slang::ShaderReflection* reflection, List<uint8_t>& outData)
+{
+    SnapshotBuilder builder;
+    builder.write(reflection, outData);
+}
+
+} // namespace Slang
+
+extern "C"
+{
+    SLANG_API SlangResult spReflection_ToSnapshot(
+        SlangReflection* reflection,
+        ISlangBlob** outBlob)
+    {
+        using namespace Slang;
+        if (!reflection || !outBlob)
+            return SLANG_E_INVALID_ARG;
+
+        List<uint8_t> data;
+        writeReflectionSnapshot((slang::ShaderReflection*)reflection, data);
+        *outBlob = ListBlob::moveCreate(data).detach();
+        return SLANG_OK;
+    }
+}
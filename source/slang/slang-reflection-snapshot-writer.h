@@ -0,0 +1,15 @@
+#ifndef SLANG_REFLECTION_SNAPSHOT_WRITER_H
+#define SLANG_REFLECTION_SNAPSHOT_WRITER_H
+
+#include "../core/slang-list.h"
+#include "slang.h"
+
+namespace Slang
+{
+
+/// Write the snapshot of `reflection` described in `slang-reflection-snapshot.h` to `outData`.
+void writeReflectionSnapshot(slang::ShaderReflection* reflection, List<uint8_t>& outData);
+
+} // namespace Slang
+
+#endif
@@ -88,6 +88,11 @@ namespace Slang
         }
         if (options.optionFlags & SerialOptionFlag::IRModule)
         {
+            // The IR of a module with deferred function bodies leaves out the
+            // functions that it doesn't use itself, so it can't stand on its own.
+            if (module->hasDeferredFunctionBodies())
+                return SLANG_E_NOT_AVAILABLE;
+
             // IR module
             dstModule.irModule = module->getIRModule();
             SLANG_ASSERT(dstModule.irModule);
@@ -193,6 +198,21 @@ namespace Slang
             }
         }
         dstModule.digest = module->computeDigest();
+
+        // Record the state of each dependent file on disk when it was read, so later checks can
+        // skip files that haven't changed. Stamps vary between machines and checkouts, so they
+        // are only recorded when timestamp validation is requested, and are only meaningful for
+        // files read through the OS file system.
+        auto linkage = module->getLinkage();
+        if (linkage && linkage->isUsingOSFileSystem() &&
+            linkage->m_optionSet.getBoolOption(CompilerOptionName::ValidateModuleTimestamps))
+        {
+            for (auto file : fileDependencies)
+            {
+                dstModule.dependentFileStamps.add(file->getStamp());
+                dstModule.dependentFileDigests.add(file->getDigest());
+            }
+        }
         outData.modules.add(dstModule);
     }
 
@@ -341,6 +361,21 @@ namespace Slang
                 uint32_t fileListLength = (uint32_t)filePathsSB.getLength();
                 headerMemStream.write(&fileListLength, sizeof(uint32_t));
                 headerMemStream.write(filePathsSB.getBuffer(), fileListLength);
+
+                // The file stamps (if any) follow the file list, so that readers that don't
+                // know about them can ignore them.
+                uint32_t fileStampCount = (uint32_t)module.dependentFileStamps.getCount();
+                if (fileStampCount)
+                    headerMemStream.write(&fileStampCount, sizeof(uint32_t));
+                for (uint32_t i = 0; i < fileStampCount; ++i)
+                {
+                    const auto& stamp = module.dependentFileStamps[i];
+                    const uint64_t stampValues[] = {stamp.size, stamp.modifiedTime, stamp.fileId};
+                    headerMemStream.write(stampValues, sizeof(stampValues));
+                    headerMemStream.write(
+                        module.dependentFileDigests[i].data,
+                        sizeof(SHA1::Digest::data));
+                }
                 container->write(
                     headerMemStream.getContents().getBuffer(),
                     headerMemStream.getContents().getCount());
@@ -601,6 +636,32 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         module.dependentFiles.add(file);
                     }
                 }
+
+                // Modules written by older versions don't have file stamps.
+                uint32_t fileStampCount = 0;
+                memStream.read(&fileStampCount, sizeof(uint32_t), readSize);
+                if (readSize == sizeof(uint32_t) &&
+                    fileStampCount == (uint32_t)module.dependentFiles.getCount())
+                {
+                    for (uint32_t i = 0; i < fileStampCount; ++i)
+                    {
+                        uint64_t stampValues[3];
+                        memStream.read(stampValues, sizeof(stampValues), readSize);
+                        if (readSize != sizeof(stampValues))
+                            return SLANG_FAIL;
+                        SHA1::Digest fileDigest;
+                        memStream.read(fileDigest.data, sizeof(fileDigest.data), readSize);
+                        if (readSize != sizeof(fileDigest.data))
+                            return SLANG_FAIL;
+
+                        FileStamp stamp;
+                        stamp.size = stampValues[0];
+                        stamp.modifiedTime = stampValues[1];
+                        stamp.fileId = stampValues[2];
+                        module.dependentFileStamps.add(stamp);
+                        module.dependentFileDigests.add(fileDigest);
+                    }
+                }
                 // Onto next chunk
                 chunk = chunk->m_next;
             }
@@ -671,6 +732,10 @@ static List<ExtensionDecl*>& _getCandidateExtensionList(
                         // and created on demand (strings) and imported symbols will have their
                         // object pointers unset (they are resolved in next step)
                         SLANG_RETURN_ON_FAIL(reader.constructObjects(options.namePool));
+                        if (options.seedNamePool)
+                        {
+                            reader.addStringsToNamePool();
+                        }
 
                         // Resolve external references if the linkage is specified
                         if (options.linkage)
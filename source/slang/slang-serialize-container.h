@@ -2,6 +2,7 @@
 #ifndef SLANG_SERIALIZE_CONTAINER_H
 #define SLANG_SERIALIZE_CONTAINER_H
 
+#include "../core/slang-io.h"
 #include "../core/slang-riff.h"
 #include "slang-ir-insts.h"
 #include "slang-profile.h"
@@ -38,6 +39,13 @@ struct SerialContainerDataModule
     NodeBase* astRootNode = nullptr; ///< The module decl
     List<String> dependentFiles;
     SHA1::Digest digest;
+
+    /// The stamps and content digests of the `dependentFiles` when the module was written, so
+    /// that a file that hasn't changed doesn't need to be read to check the module is up to date.
+    /// Either empty, or holds an entry for each dependent file. The stamps of files that were
+    /// not read from disk are invalid.
+    List<FileStamp> dependentFileStamps;
+    List<SHA1::Digest> dependentFileDigests;
 };
 
 /* Struct that holds all the data that can be held in a 'container' */
@@ -104,6 +112,8 @@ struct SerialContainerUtil
         Linkage* linkage = nullptr;
         DiagnosticSink* sink = nullptr;
         bool readHeaderOnly = false;
+        /// If set, all the strings of the AST are interned as names before it is read.
+        bool seedNamePool = false;
         String modulePath;
     };
 
@@ -434,6 +434,63 @@ Result _encodeInsts(
     return SLANG_OK;
 }
 
+// For the stream encodings instructions are split into three parts, so that all of the
+// variable sized integers can be decoded in one go:
+//
+// * The payload type of each instruction, one byte each
+// * The Float64/Int64 payloads, in instruction order
+// * The op, result type and operands of each instruction, stream encoded
+//
+static void _encodeInstsStream(
+    const List<IRSerialData::Inst>& instsIn,
+    List<uint8_t>& encodeArrayOut,
+    uint32_t& outNumValues)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    List<uint32_t> values;
+    List<uint8_t> wideValues;
+
+    encodeArrayOut.clear();
+    for (const auto& inst : instsIn)
+    {
+        encodeArrayOut.add(uint8_t(inst.m_payloadType));
+
+        values.add(inst.m_op);
+        values.add((uint32_t)inst.m_resultTypeIndex);
+
+        switch (inst.m_payloadType)
+        {
+        case PayloadType::Empty:
+            break;
+        case PayloadType::Operand_1:
+        case PayloadType::String_1:
+        case PayloadType::UInt32:
+            values.add((uint32_t)inst.m_payload.m_operands[0]);
+            break;
+        case PayloadType::Operand_2:
+        case PayloadType::OperandAndUInt32:
+        case PayloadType::OperandExternal:
+        case PayloadType::String_2:
+            values.add((uint32_t)inst.m_payload.m_operands[0]);
+            values.add((uint32_t)inst.m_payload.m_operands[1]);
+            break;
+        case PayloadType::Float64:
+        case PayloadType::Int64:
+            {
+                // Both are 8 bytes, and we just want the bits
+                const uint8_t* bytes = (const uint8_t*)&inst.m_payload.m_int64;
+                wideValues.addRange(bytes, sizeof(inst.m_payload.m_int64));
+                break;
+            }
+        }
+    }
+
+    encodeArrayOut.addRange(wideValues);
+    ByteEncodeUtil::encodeStreamUInt32(values.getBuffer(), size_t(values.getCount()), encodeArrayOut);
+    outNumValues = uint32_t(values.getCount());
+}
+
 Result _writeInstArrayChunk(
     SerialCompressionType compressionType,
     FourCC chunkId,
@@ -470,6 +527,22 @@ Result _writeInstArrayChunk(
 
             return SLANG_OK;
         }
+    case SerialCompressionType::StreamVByte:
+    case SerialCompressionType::StreamVByteLZ4:
+        {
+            List<uint8_t> encoded;
+            uint32_t numValues = 0;
+            _encodeInstsStream(array, encoded, numValues);
+
+            ScopeChunk scope(container, Chunk::Kind::Data, SLANG_MAKE_COMPRESSED_FOUR_CC(chunkId));
+
+            SerialBinary::CompressedArrayHeader header;
+            header.numEntries = uint32_t(array.getCount());
+            header.numCompressedEntries = numValues;
+
+            container->write(&header, sizeof(header));
+            return SerialRiffUtil::writeStreamPayload(compressionType, encoded, container);
+        }
     default:
         break;
     }
@@ -639,6 +712,107 @@ static Result _decodeInsts(
     return SLANG_OK;
 }
 
+static Result _decodeInstsStream(
+    const uint8_t* encodeCur,
+    size_t encodeInSize,
+    uint32_t numValues,
+    List<IRSerialData::Inst>& instsOut)
+{
+    typedef IRSerialData::Inst::PayloadType PayloadType;
+
+    const size_t numInsts = size_t(instsOut.getCount());
+    if (encodeInSize < numInsts)
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint8_t* payloadTypes = encodeCur;
+
+    size_t numWideValues = 0;
+    for (size_t i = 0; i < numInsts; ++i)
+    {
+        const PayloadType payloadType = PayloadType(payloadTypes[i]);
+        numWideValues +=
+            (payloadType == PayloadType::Float64 || payloadType == PayloadType::Int64) ? 1 : 0;
+    }
+
+    const uint8_t* wideValues = payloadTypes + numInsts;
+    const uint8_t* encodedValues = wideValues + numWideValues * sizeof(int64_t);
+    const uint8_t* encodeEnd = encodeCur + encodeInSize;
+    if (encodedValues > encodeEnd)
+    {
+        return SLANG_FAIL;
+    }
+
+    // Decode all of the integers at once, this is where the stream layout pays off
+    List<uint32_t> values;
+    values.setCount(numValues);
+    if (numValues && !ByteEncodeUtil::decodeStreamUInt32(
+                         encodedValues,
+                         size_t(encodeEnd - encodedValues),
+                         numValues,
+                         values.getBuffer()))
+    {
+        return SLANG_FAIL;
+    }
+
+    const uint32_t* valueCur = values.begin();
+    const uint32_t* valueEnd = values.end();
+
+    IRSerialData::Inst* insts = instsOut.begin();
+    for (size_t i = 0; i < numInsts; ++i)
+    {
+        auto& inst = insts[i];
+        inst.m_payloadType = PayloadType(payloadTypes[i]);
+
+        if (valueCur + 2 > valueEnd)
+        {
+            return SLANG_FAIL;
+        }
+        inst.m_op = (uint16_t)valueCur[0];
+        inst.m_resultTypeIndex = IRSerialData::InstIndex(valueCur[1]);
+        valueCur += 2;
+
+        switch (inst.m_payloadType)
+        {
+        case PayloadType::Empty:
+            break;
+        case PayloadType::Operand_1:
+        case PayloadType::String_1:
+        case PayloadType::UInt32:
+            {
+                if (valueCur + 1 > valueEnd)
+                    return SLANG_FAIL;
+                inst.m_payload.m_operands[0] = IRSerialData::InstIndex(*valueCur++);
+                break;
+            }
+        case PayloadType::Operand_2:
+        case PayloadType::OperandAndUInt32:
+        case PayloadType::OperandExternal:
+        case PayloadType::String_2:
+            {
+                if (valueCur + 2 > valueEnd)
+                    return SLANG_FAIL;
+                inst.m_payload.m_operands[0] = IRSerialData::InstIndex(valueCur[0]);
+                inst.m_payload.m_operands[1] = IRSerialData::InstIndex(valueCur[1]);
+                valueCur += 2;
+                break;
+            }
+        case PayloadType::Float64:
+        case PayloadType::Int64:
+            {
+                memcpy(&inst.m_payload.m_int64, wideValues, sizeof(inst.m_payload.m_int64));
+                wideValues += sizeof(inst.m_payload.m_int64);
+                break;
+            }
+        default:
+            return SLANG_FAIL;
+        }
+    }
+
+    return SLANG_OK;
+}
+
 static Result _readInstArrayChunk(
     SerialCompressionType containerCompressionType,
     RiffContainer::DataChunk* chunk,
@@ -670,6 +844,28 @@ static Result _readInstArrayChunk(
                 _decodeInsts(compressionType, read.getData(), read.getRemainingSize(), arrayOut));
             break;
         }
+    case SerialCompressionType::StreamVByte:
+    case SerialCompressionType::StreamVByteLZ4:
+        {
+            RiffReadHelper read = chunk->asReadHelper();
+
+            SerialBinary::CompressedArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+
+            List<uint8_t> decompressed;
+            ConstArrayView<uint8_t> encoded;
+            SLANG_RETURN_ON_FAIL(
+                SerialRiffUtil::readStreamPayload(compressionType, read, decompressed, encoded));
+
+            arrayOut.setCount(header.numEntries);
+
+            SLANG_RETURN_ON_FAIL(_decodeInstsStream(
+                encoded.getBuffer(),
+                size_t(encoded.getCount()),
+                header.numCompressedEntries,
+                arrayOut));
+            break;
+        }
     default:
         {
             return SLANG_FAIL;
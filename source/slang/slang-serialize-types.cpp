@@ -2,6 +2,7 @@
 #include "slang-serialize-types.h"
 
 #include "../core/slang-byte-encode-util.h"
+#include "../core/slang-lz4-compression-system.h"
 #include "../core/slang-math.h"
 #include "../core/slang-text-io.h"
 
@@ -196,6 +197,25 @@ struct ByteReader
             container->write(compressedPayload.getBuffer(), compressedPayload.getCount());
             break;
         }
+    case SerialCompressionType::StreamVByte:
+    case SerialCompressionType::StreamVByteLZ4:
+        {
+            List<uint8_t> encoded;
+
+            size_t numCompressedEntries = (numEntries * typeSize) / sizeof(uint32_t);
+            ByteEncodeUtil::encodeStreamUInt32(
+                (const uint32_t*)data,
+                numCompressedEntries,
+                encoded);
+
+            SerialBinary::CompressedArrayHeader header;
+            header.numEntries = uint32_t(numEntries);
+            header.numCompressedEntries = uint32_t(numCompressedEntries);
+
+            container->write(&header, sizeof(header));
+            SLANG_RETURN_ON_FAIL(writeStreamPayload(compressionType, encoded, container));
+            break;
+        }
     default:
         {
             return SLANG_FAIL;
@@ -204,6 +224,57 @@ struct ByteReader
     return SLANG_OK;
 }
 
+/* static */ Result SerialRiffUtil::writeStreamPayload(
+    SerialCompressionType compressionType,
+    const List<uint8_t>& encoded,
+    RiffContainer* container)
+{
+    if (compressionType != SerialCompressionType::StreamVByteLZ4)
+    {
+        container->write(encoded.getBuffer(), encoded.getCount());
+        return SLANG_OK;
+    }
+
+    CompressionStyle style;
+    ComPtr<ISlangBlob> compressed;
+    SLANG_RETURN_ON_FAIL(LZ4CompressionSystem::getSingleton()->compress(
+        &style,
+        encoded.getBuffer(),
+        encoded.getCount(),
+        compressed.writeRef()));
+
+    const uint32_t encodedSize = uint32_t(encoded.getCount());
+    container->write(&encodedSize, sizeof(encodedSize));
+    container->write(compressed->getBufferPointer(), compressed->getBufferSize());
+    return SLANG_OK;
+}
+
+/* static */ Result SerialRiffUtil::readStreamPayload(
+    SerialCompressionType compressionType,
+    RiffReadHelper& read,
+    List<uint8_t>& ioDecompressed,
+    ConstArrayView<uint8_t>& outEncoded)
+{
+    if (compressionType != SerialCompressionType::StreamVByteLZ4)
+    {
+        outEncoded = ConstArrayView<uint8_t>(read.getData(), Index(read.getRemainingSize()));
+        return SLANG_OK;
+    }
+
+    uint32_t encodedSize;
+    SLANG_RETURN_ON_FAIL(read.read(encodedSize));
+
+    ioDecompressed.setCount(Index(encodedSize));
+    SLANG_RETURN_ON_FAIL(LZ4CompressionSystem::getSingleton()->decompress(
+        read.getData(),
+        read.getRemainingSize(),
+        encodedSize,
+        ioDecompressed.getBuffer()));
+
+    outEncoded = ioDecompressed.getArrayView();
+    return SLANG_OK;
+}
+
 /* static */ Result SerialRiffUtil::readArrayChunk(
     SerialCompressionType compressionType,
     RiffContainer::DataChunk* dataChunk,
@@ -233,6 +304,31 @@ struct ByteReader
                 (uint32_t*)dst);
             break;
         }
+    case SerialCompressionType::StreamVByte:
+    case SerialCompressionType::StreamVByteLZ4:
+        {
+            Bin::CompressedArrayHeader header;
+            SLANG_RETURN_ON_FAIL(read.read(header));
+
+            void* dst = listOut.setSize(header.numEntries);
+            SLANG_ASSERT(
+                header.numCompressedEntries ==
+                uint32_t((header.numEntries * typeSize) / sizeof(uint32_t)));
+
+            List<uint8_t> decompressed;
+            ConstArrayView<uint8_t> encoded;
+            SLANG_RETURN_ON_FAIL(readStreamPayload(compressionType, read, decompressed, encoded));
+
+            if (header.numCompressedEntries && !ByteEncodeUtil::decodeStreamUInt32(
+                                                   encoded.getBuffer(),
+                                                   size_t(encoded.getCount()),
+                                                   header.numCompressedEntries,
+                                                   (uint32_t*)dst))
+            {
+                return SLANG_FAIL;
+            }
+            break;
+        }
     case SerialCompressionType::None:
         {
             // Read uncompressed
@@ -253,7 +349,9 @@ struct ByteReader
 // clang-format off
 #define SLANG_SERIAL_BINARY_COMPRESSION_TYPE(x) \
     x(None, none) \
-    x(VariableByteLite, lite)
+    x(VariableByteLite, lite) \
+    x(StreamVByte, stream-vbyte) \
+    x(StreamVByteLZ4, stream-vbyte-lz4)
 // clang-format on
 
 /* static */ SlangResult SerialParseUtil::parseCompressionType(
@@ -47,6 +47,8 @@ enum class SerialCompressionType : uint8_t
 {
     None,
     VariableByteLite,
+    StreamVByte,    ///< Lengths stored apart from value bytes, so can be decoded with SIMD shuffles
+    StreamVByteLZ4, ///< As StreamVByte, with the encoded bytes of each chunk LZ4 compressed
 };
 
 
@@ -266,6 +268,21 @@ struct SerialRiffUtil
         RiffContainer::DataChunk* dataChunk,
         ListResizer& listOut);
 
+    /// Write the bytes produced by a stream encoding to the current chunk. For
+    /// StreamVByteLZ4 they are LZ4 compressed (preceded by their uncompressed size).
+    static Result writeStreamPayload(
+        SerialCompressionType compressionType,
+        const List<uint8_t>& encoded,
+        RiffContainer* container);
+
+    /// Read the remainder of a chunk written with `writeStreamPayload`. If decompression
+    /// is needed `ioDecompressed` holds the result, and `outEncoded` points into it.
+    static Result readStreamPayload(
+        SerialCompressionType compressionType,
+        RiffReadHelper& read,
+        List<uint8_t>& ioDecompressed,
+        ConstArrayView<uint8_t>& outEncoded);
+
     template<typename T>
     static Result readArrayChunk(
         SerialCompressionType moduleCompressionType,
@@ -992,9 +992,8 @@ Name* SerialReader::getName(SerialIndex index)
         return name;
     }
 
-    UnownedStringSlice slice = getStringSlice(index);
-    String string(slice);
-    Name* name = m_namePool->getName(string);
+    // Intern straight from the serialized chars, no need to construct a `String`
+    Name* name = m_namePool->getName(getStringSlice(index));
     // Don't need to add to scope, because scoped on the pool
     m_objects[Index(index)] = name;
     return name;
@@ -1066,6 +1065,8 @@ SlangResult SerialReader::constructObjects(NamePool* namePool)
     m_objects.setCount(m_entries.getCount());
     memset(m_objects.getBuffer(), 0, m_objects.getCount() * sizeof(void*));
 
+    Index stringCount = 0;
+
     // Go through entries, constructing objects.
     for (Index i = 1; i < m_entries.getCount(); ++i)
     {
@@ -1084,6 +1085,7 @@ SlangResult SerialReader::constructObjects(NamePool* namePool)
             {
                 // Don't need to construct an object. This is probably a StringRepresentation, or a
                 // Name Will evaluate lazily.
+                stringCount++;
                 break;
             }
         case SerialTypeKind::RefObject:
@@ -1113,9 +1115,35 @@ SlangResult SerialReader::constructObjects(NamePool* namePool)
         }
     }
 
+    // Most strings in a serialized AST are names, so size the name table up front rather
+    // than growing it piecemeal as names are looked up (this matters mostly for the core module).
+    if (namePool && namePool->rootPool)
+    {
+        RootNamePool* rootPool = namePool->rootPool;
+        rootPool->reserve(rootPool->getCount() + stringCount);
+    }
+
     return SLANG_OK;
 }
 
+void SerialReader::addStringsToNamePool()
+{
+    if (!m_namePool || !m_namePool->rootPool)
+    {
+        return;
+    }
+
+    List<UnownedStringSlice> texts;
+    for (Index i = 1; i < m_entries.getCount(); ++i)
+    {
+        if (m_entries[i]->typeKind == SerialTypeKind::String)
+        {
+            texts.add(getStringSlice(SerialIndex(i)));
+        }
+    }
+    m_namePool->rootPool->addNames(texts.getArrayView());
+}
+
 SlangResult SerialReader::deserializeObjects()
 {
     // Deserialize
@@ -274,6 +274,10 @@ public:
     }
     /// For each entry construct an object. Does *NOT* deserialize them
     SlangResult constructObjects(NamePool* namePool);
+    /// Intern every string held in the entries as a name in the name pool passed to
+    /// `constructObjects`, taking the pool's lock once. Worthwhile when nearly all of the
+    /// strings are names, as with the core module.
+    void addStringsToNamePool();
     /// Entries must be loaded (with loadEntries), and objects constructed (with constructObjects)
     /// before deserializing
     SlangResult deserializeObjects();
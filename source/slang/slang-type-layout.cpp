@@ -5686,6 +5686,46 @@ RefPtr<TypeLayout> TypeLayout::unwrapArray()
 }
 
 
+Index StructTypeLayout::findFieldIndexByName(const UnownedStringSlice& name)
+{
+    // For small structures a linear scan is as fast as a hash lookup, and
+    // doesn't need any extra memory.
+    const Index kMinFieldCountForIndex = 8;
+
+    const Index fieldCount = fields.getCount();
+    if (fieldCount < kMinFieldCountForIndex)
+    {
+        for (Index f = 0; f < fieldCount; ++f)
+        {
+            if (getReflectionName(fields[f]->getVariable())->text.getUnownedSlice() == name)
+                return f;
+        }
+        return -1;
+    }
+
+    // Reflection can be queried from several threads at once, so the index is built and
+    // read under a lock.
+    std::lock_guard<std::mutex> lock(m_fieldIndexMutex);
+
+    // Fields are only ever appended while the layout is being constructed, so the
+    // index only needs to be rebuilt if it was built before that finished.
+    if (m_indexedFieldCount != fieldCount)
+    {
+        m_fieldIndexByName.clear();
+        for (Index f = 0; f < fieldCount; ++f)
+        {
+            auto fieldName = getReflectionName(fields[f]->getVariable());
+            // Keep the first field with a given name, to match the order of a scan.
+            m_fieldIndexByName.addIfNotExists(fieldName->text.getUnownedSlice(), f);
+        }
+        m_indexedFieldCount = fieldCount;
+    }
+
+    if (auto index = m_fieldIndexByName.tryGetValue(name))
+        return *index;
+    return -1;
+}
+
 GlobalGenericParamDecl* GenericParamTypeLayout::getGlobalGenericParamDecl()
 {
     auto declRefType = as<DeclRefType>(type);
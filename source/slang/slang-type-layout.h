@@ -7,6 +7,8 @@
 #include "slang-syntax.h"
 #include "slang.h"
 
+#include <mutex>
+
 namespace Slang
 {
 
@@ -749,6 +751,22 @@ public:
     // in the array above, rather than to the actual pointer,
     // so that we
     Dictionary<Decl*, RefPtr<VarLayout>> mapVarToLayout;
+
+    /// Find the index in `fields` of the first field with the given reflection `name`.
+    ///
+    /// Returns -1 if there is no such field. Lookups on structures with many fields
+    /// go through a name index that is built on first use. Safe to call from multiple
+    /// threads once the layout is constructed.
+    Index findFieldIndexByName(const UnownedStringSlice& name);
+
+protected:
+    // Guards `m_fieldIndexByName` and `m_indexedFieldCount`.
+    std::mutex m_fieldIndexMutex;
+    // Maps the reflection name of a field to its index in `fields`. The keys reference
+    // the text of the (pooled) field names, which outlive the layout.
+    Dictionary<UnownedStringSlice, Index> m_fieldIndexByName;
+    // The number of fields that `m_fieldIndexByName` was built from.
+    Index m_indexedFieldCount = 0;
 };
 
 class GenericParamTypeLayout : public TypeLayout
@@ -33,6 +33,7 @@
 #include "slang-parser.h"
 #include "slang-preprocessor.h"
 #include "slang-reflection-json.h"
+#include "slang-reflection-snapshot-writer.h"
 #include "slang-repro.h"
 #include "slang-serialize-ast.h"
 #include "slang-serialize-container.h"
@@ -173,6 +174,30 @@ void Session::init()
     DownstreamCompilerUtil::setDefaultLocators(m_downstreamCompilerLocators);
     m_downstreamCompilerSet = new DownstreamCompilerSet;
 
+    // Downstream compilations are cached if a cache directory is set in the environment
+    {
+        StringBuilder cachePath;
+        if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+                toSlice("SLANG_DOWNSTREAM_COMPILER_CACHE_PATH"),
+                cachePath)) &&
+            cachePath.getLength())
+        {
+            PersistentCache::Desc cacheDesc;
+            cacheDesc.directory = cachePath.getBuffer();
+
+            StringBuilder maxEntryCount;
+            if (SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+                    toSlice("SLANG_DOWNSTREAM_COMPILER_CACHE_MAX_ENTRIES"),
+                    maxEntryCount)) &&
+                maxEntryCount.getLength())
+            {
+                cacheDesc.maxEntryCount = Count(stringToInt(maxEntryCount));
+            }
+
+            m_downstreamCompilerCache = new PersistentCache(cacheDesc);
+        }
+    }
+
     // Initialize name pool
     getNamePool()->setRootNamePool(getRootNamePool());
     m_completionTokenName = getNamePool()->getName("#?");
@@ -190,6 +215,8 @@ void Session::init()
     auto builtinAstBuilder = m_sharedASTBuilder->getInnerASTBuilder();
     globalAstBuilder = builtinAstBuilder;
 
+    m_sharedTypeCheckingCache = new SharedTypeCheckingCache(builtinAstBuilder);
+
     // Make sure our source manager is initialized
     builtinSourceManager.initialize(nullptr, nullptr);
 
@@ -673,6 +700,8 @@ SlangResult Session::_readBuiltinModule(
     options.astBuilder = linkage->getASTBuilder();
     options.sourceManager = sourceManger;
     options.linkage = linkage;
+    // Nearly every string in a builtin module is a name, so intern them all at once.
+    options.seedNamePool = true;
 
     // Hmm - don't have a suitable sink yet, so attempt to just not have one
     options.sink = nullptr;
@@ -2448,9 +2477,14 @@ SlangResult TranslationUnitRequest::requireSourceFiles()
             }
         }
 
-        // If we *don't* have a blob try and get a blob from the artifact
+        // If we *don't* have a blob try and get a blob from the artifact. If that reads the
+        // file, stamp it first.
+        FileStamp stamp;
         if (!blob)
         {
+            if (!findRepresentation<ISlangBlob>(artifact))
+                stamp = SourceFile::calcStampBeforeRead(pathInfo);
+
             const SlangResult res = artifact->loadBlob(ArtifactKeep::Yes, blob.writeRef());
             if (SLANG_FAILED(res))
             {
@@ -2472,12 +2506,14 @@ SlangResult TranslationUnitRequest::requireSourceFiles()
             if (!sourceFile->getContentBlob())
             {
                 sourceFile->setContents(blob);
+                sourceFile->setStamp(stamp);
             }
         }
         else
         {
             // Create a new source file, using the pathInfo and blob
             sourceFile = sourceManager->createSourceFileWithBlob(pathInfo, blob);
+            sourceFile->setStamp(stamp);
         }
 
         auto uniqueIdentity = pathInfo.getMostUniqueIdentity();
@@ -3647,6 +3683,25 @@ void EndToEndCompileRequest::init()
     m_frontEndReq = new FrontEndCompileRequest(getLinkage(), m_writers, getSink());
 }
 
+bool EndToEndCompileRequest::_canLowerReachableDeclsOnly()
+{
+    if (!getOptionSet().getBoolOption(CompilerOptionName::DemandDrivenIRLowering))
+        return false;
+
+    // Written modules must hold all of their code.
+    if (m_emitIr || m_containerFormat != ContainerFormat::None)
+        return false;
+
+    for (auto target : getLinkage()->targets)
+    {
+        if (target->getOptionSet().getBoolOption(CompilerOptionName::EmbedDownstreamIR))
+            return false;
+    }
+
+    // A translation unit can import another one, and then needs all of its code.
+    return getFrontEndReq()->translationUnits.getCount() == 1;
+}
+
 SlangResult EndToEndCompileRequest::executeActionsInner()
 {
     SLANG_PROFILE_SECTION(endToEndActions);
@@ -3678,6 +3733,7 @@ SlangResult EndToEndCompileRequest::executeActionsInner()
     for (auto target : getLinkage()->targets)
         target->getOptionSet().inheritFrom(getOptionSet());
     m_frontEndReq->optionSet = getOptionSet();
+    m_frontEndReq->lowerReachableDeclsOnly = _canLowerReachableDeclsOnly();
 
     // We only do parsing and semantic checking if we *aren't* doing
     // a pass-through compilation.
@@ -4144,6 +4200,7 @@ RefPtr<Module> Linkage::loadModule(
     frontEndReq->addTranslationUnit(translationUnit);
 
     auto module = translationUnit->getModule();
+    module->setIsLoadedByImport(m_importDeclDepth != 0);
 
     ModuleBeingImportedRAII moduleBeingImported(this, module, name, srcLoc);
 
@@ -4257,6 +4314,37 @@ String getFileNameFromModuleName(Name* name, bool translateUnderScore)
     return fileName;
 }
 
+// A file that a module may be loaded from.
+struct ModuleFileCandidate
+{
+    String fileName;
+    bool isBinary;
+};
+
+// Get the files that the module `name` may be loaded from, in the order they should be tried.
+// Precompiled modules are tried first, unless `preferSource` is set.
+static void _getModuleFileCandidates(
+    Name* name,
+    bool preferSource,
+    List<ModuleFileCandidate>& outCandidates)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        const bool isBinary = (i == 0) != preferSource;
+
+        // Try without translating `_` to `-` first, if that fails, try translating.
+        for (int translateUnderScore = 0; translateUnderScore <= 1; translateUnderScore++)
+        {
+            auto moduleSourceFileName = getFileNameFromModuleName(name, translateUnderScore == 1);
+            ModuleFileCandidate candidate;
+            candidate.fileName = isBinary ? Path::replaceExt(moduleSourceFileName, "slang-module")
+                                          : moduleSourceFileName;
+            candidate.isBinary = isBinary;
+            outCandidates.add(candidate);
+        }
+    }
+}
+
 RefPtr<Module> Linkage::findOrImportModule(
     Name* name,
     SourceLoc const& loc,
@@ -4321,64 +4409,274 @@ RefPtr<Module> Linkage::findOrImportModule(
 
 
     // Look for a precompiled module first, if not exist, load from source.
-    bool shouldCheckBinaryModuleSettings[2] = {true, false};
+    // When in language server, we always prefer to use source module if it is available.
+    List<ModuleFileCandidate> candidates;
+    _getModuleFileCandidates(name, isInLanguageServer(), candidates);
 
-    for (auto checkBinaryModule : shouldCheckBinaryModuleSettings)
+    for (const auto& candidate : candidates)
     {
-        // When in language server, we always prefer to use source module if it is available.
-        if (isInLanguageServer())
-            checkBinaryModule = !checkBinaryModule;
+        ComPtr<ISlangBlob> fileContents;
 
-        // Try without translating `_` to `-` first, if that fails, try translating.
-        for (int translateUnderScore = 0; translateUnderScore <= 1; translateUnderScore++)
+        // We have to load via the found path - as that is how file was originally loaded
+        if (SLANG_FAILED(includeSystem.findFile(
+                candidate.fileName,
+                pathIncludedFromInfo.foundPath,
+                filePathInfo)))
         {
-            auto moduleSourceFileName = getFileNameFromModuleName(name, translateUnderScore == 1);
-            String fileName;
-            if (checkBinaryModule == 1)
-                fileName = Path::replaceExt(moduleSourceFileName, "slang-module");
-            else
-                fileName = moduleSourceFileName;
+            continue;
+        }
+
+        // Maybe this was loaded previously at a different relative name?
+        if (mapPathToLoadedModule.tryGetValue(filePathInfo.getMostUniqueIdentity(), loadedModule))
+            return loadedModule;
 
-            ComPtr<ISlangBlob> fileContents;
+        // Try to load it
+        if (!fileContents && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
+        {
+            continue;
+        }
 
-            // We have to load via the found path - as that is how file was originally loaded
-            if (SLANG_FAILED(
-                    includeSystem.findFile(fileName, pathIncludedFromInfo.foundPath, filePathInfo)))
+        // We've found a file that we can load for the given module, so
+        // go ahead and perform the module-load action
+        auto resultModule = loadModule(
+            name,
+            filePathInfo,
+            fileContents,
+            loc,
+            sink,
+            loadedModules,
+            (candidate.isBinary ? ModuleBlobType::IR : ModuleBlobType::Source));
+        if (resultModule)
+            return resultModule;
+    }
+
+    // Error: we cannot find the file.
+    sink->diagnose(loc, Diagnostics::cannotOpenFile, getFileNameFromModuleName(name, false));
+    mapNameToLoadedModules[name] = nullptr;
+    return nullptr;
+}
+
+// Find the module names named by `import` declarations in `text`.
+//
+// This is a light-weight scan rather than a parse: comments and string literals are
+// skipped, but the preprocessor is not evaluated, so an `import` in a disabled `#if`
+// block is still reported. That only costs a file read that turns out to be unused.
+static void _scanForImportedModuleNames(UnownedStringSlice text, List<String>& outNames)
+{
+    const char* cur = text.begin();
+    const char* const end = text.end();
+
+    auto isIdentifierStart = [](char c) { return CharUtil::isAlpha(c) || c == '_'; };
+    auto isIdentifierChar = [](char c) { return CharUtil::isAlphaOrDigit(c) || c == '_'; };
+    auto skipWhitespace = [&]()
+    {
+        while (cur < end && CharUtil::isWhitespace(*cur))
+            cur++;
+    };
+    auto readIdentifier = [&]()
+    {
+        const char* start = cur;
+        while (cur < end && isIdentifierChar(*cur))
+            cur++;
+        return UnownedStringSlice(start, cur);
+    };
+
+    while (cur < end)
+    {
+        const char c = *cur;
+        if (c == '/' && cur + 1 < end && cur[1] == '/')
+        {
+            while (cur < end && *cur != '\n')
+                cur++;
+        }
+        else if (c == '/' && cur + 1 < end && cur[1] == '*')
+        {
+            cur += 2;
+            while (cur + 1 < end && !(cur[0] == '*' && cur[1] == '/'))
+                cur++;
+            // An unterminated comment runs to the end of the text
+            cur = (cur + 1 < end) ? cur + 2 : end;
+        }
+        else if (c == '"' || c == '\'')
+        {
+            cur++;
+            while (cur < end && *cur != c)
             {
+                // An escape at the very end of the text has nothing to escape
+                cur += (*cur == '\\' && cur + 1 < end) ? 2 : 1;
+            }
+            if (cur < end)
+                cur++;
+        }
+        else if (isIdentifierStart(c))
+        {
+            auto keyword = readIdentifier();
+            if (keyword != "import" && keyword != "__import")
                 continue;
+
+            skipWhitespace();
+            StringBuilder moduleName;
+            if (cur < end && *cur == '"')
+            {
+                const char* start = ++cur;
+                while (cur < end && *cur != '"' && *cur != '\\' && *cur != '\n')
+                    cur++;
+                // Escaped paths are left for the real parser to deal with
+                if (cur >= end || *cur != '"')
+                    continue;
+                moduleName << UnownedStringSlice(start, cur);
+                cur++;
+            }
+            else if (cur < end && isIdentifierStart(*cur))
+            {
+                // `import a.b.c;` names the module `a/b/c`
+                moduleName << readIdentifier();
+                for (skipWhitespace(); cur < end && *cur == '.'; skipWhitespace())
+                {
+                    cur++;
+                    skipWhitespace();
+                    if (cur >= end || !isIdentifierStart(*cur))
+                        break;
+                    moduleName << "/" << readIdentifier();
+                }
+            }
+            skipWhitespace();
+            if (moduleName.getLength() && cur < end && *cur == ';')
+            {
+                outNames.add(moduleName.produceString());
             }
+        }
+        else
+        {
+            cur++;
+        }
+    }
+}
+
+// Find the source file that `findOrImportModule` would load for the module `name`.
+// Returns false if the module can't be found, or would be loaded from a binary module.
+static bool _findImportedModuleSourceFile(
+    IncludeSystem& includeSystem,
+    Name* name,
+    String const& pathFrom,
+    PathInfo& outPathInfo)
+{
+    List<ModuleFileCandidate> candidates;
+    _getModuleFileCandidates(name, false, candidates);
+
+    for (const auto& candidate : candidates)
+    {
+        if (SLANG_SUCCEEDED(includeSystem.findFile(candidate.fileName, pathFrom, outPathInfo)))
+            return !candidate.isBinary;
+    }
+    return false;
+}
+
+void Linkage::prefetchImportedModuleSources(ModuleDecl* moduleDecl)
+{
+    // The language server loads and reloads modules as documents change, so it always goes
+    // through the ordinary path.
+    if (isInLanguageServer())
+        return;
+
+    struct PendingImport
+    {
+        Name* name;
+        String pathFrom;
+    };
+    List<PendingImport> pending;
+
+    auto addImportDecls = [&](ContainerDecl* containerDecl)
+    {
+        for (auto importDecl : containerDecl->getMembersOfType<ImportDecl>())
+        {
+            auto loc = importDecl->moduleNameAndLoc.loc;
+            pending.add(
+                {importDecl->moduleNameAndLoc.name,
+                 getSourceManager()->getPathInfo(loc, SourceLocType::Actual).foundPath});
+        }
+    };
+    addImportDecls(moduleDecl);
+    for (auto fileDecl : moduleDecl->getMembersOfType<FileDecl>())
+        addImportDecls(fileDecl);
+
+    struct PrefetchedFile
+    {
+        PathInfo pathInfo;
+        FileStamp stamp;
+        ComPtr<ISlangBlob> blob;
+        List<String> importedModuleNames;
+    };
+
+    // Reads go through the linkage's file system, exactly as a normal load would. It isn't
+    // required to be safe to call concurrently, so the reads are serialized.
+    ISlangFileSystemExt* fileSystemExt = getFileSystemExt();
+    std::mutex fileSystemMutex;
 
-            // Maybe this was loaded previously at a different relative name?
-            if (mapPathToLoadedModule.tryGetValue(
-                    filePathInfo.getMostUniqueIdentity(),
-                    loadedModule))
-                return loadedModule;
+    IncludeSystem includeSystem(&getSearchDirectories(), fileSystemExt, getSourceManager());
+    HashSet<String> seenFiles;
+
+    // Walk the import graph a level at a time. Resolving paths and registering files
+    // touches shared state so happens here, the scans happen concurrently.
+    while (pending.getCount())
+    {
+        List<PrefetchedFile> files;
+        for (auto& import : pending)
+        {
+            if (import.name == getSessionImpl()->glslModuleName ||
+                mapNameToLoadedModules.containsKey(import.name))
+                continue;
+
+            PathInfo pathInfo;
+            if (!_findImportedModuleSourceFile(includeSystem, import.name, import.pathFrom, pathInfo))
+                continue;
+
+            if (!seenFiles.add(pathInfo.getMostUniqueIdentity()) ||
+                mapPathToLoadedModule.containsKey(pathInfo.getMostUniqueIdentity()) ||
+                getSourceManager()->findSourceFileRecursively(pathInfo.uniqueIdentity))
+                continue;
 
-            // Try to load it
-            if (!fileContents && SLANG_FAILED(includeSystem.loadFile(filePathInfo, fileContents)))
+            files.add({pathInfo, FileStamp(), nullptr, List<String>()});
+        }
+        pending.clear();
+
+        if (files.getCount() == 0)
+            break;
+
+        getSessionImpl()->getThreadPool()->parallelFor(
+            files.getCount(),
+            [&](Index i)
             {
+                auto& file = files[i];
+                {
+                    std::lock_guard<std::mutex> lock(fileSystemMutex);
+                    file.stamp = SourceFile::calcStampBeforeRead(file.pathInfo);
+                    if (SLANG_FAILED(fileSystemExt->loadFile(
+                            file.pathInfo.foundPath.getBuffer(),
+                            file.blob.writeRef())))
+                        return;
+                }
+                _scanForImportedModuleNames(
+                    UnownedStringSlice(
+                        (const char*)file.blob->getBufferPointer(),
+                        file.blob->getBufferSize()),
+                    file.importedModuleNames);
+            });
+
+        // Register in a fixed order so the result doesn't depend on thread scheduling.
+        for (auto& file : files)
+        {
+            if (!file.blob)
                 continue;
-            }
 
-            // We've found a file that we can load for the given module, so
-            // go ahead and perform the module-load action
-            auto resultModule = loadModule(
-                name,
-                filePathInfo,
-                fileContents,
-                loc,
-                sink,
-                loadedModules,
-                (checkBinaryModule == 1 ? ModuleBlobType::IR : ModuleBlobType::Source));
-            if (resultModule)
-                return resultModule;
+            auto sourceFile = getSourceManager()->createSourceFileWithBlob(file.pathInfo, file.blob);
+            sourceFile->setStamp(file.stamp);
+            getSourceManager()->addSourceFile(file.pathInfo.uniqueIdentity, sourceFile);
+
+            for (auto& importedModuleName : file.importedModuleNames)
+                pending.add({getNamePool()->getName(importedModuleName), file.pathInfo.foundPath});
         }
     }
-
-    // Error: we cannot find the file.
-    sink->diagnose(loc, Diagnostics::cannotOpenFile, getFileNameFromModuleName(name, false));
-    mapNameToLoadedModules[name] = nullptr;
-    return nullptr;
 }
 
 SourceFile* Linkage::loadSourceFile(String pathFrom, String path)
@@ -4436,8 +4734,49 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
         }
     }
 
-    for (auto file : moduleHeader.dependentFiles)
+    // When validating with file stamps, a file whose stamp matches the one recorded in the
+    // module (or in the digest cache) is assumed to be unchanged, and isn't read.
+    const bool useFileStamps =
+        m_optionSet.getBoolOption(CompilerOptionName::ValidateModuleTimestamps) &&
+        isUsingOSFileSystem();
+    FileDigestCache* digestCache = useFileStamps ? getModuleDigestCache() : nullptr;
+    const bool hasRecordedStamps =
+        moduleHeader.dependentFileStamps.getCount() == moduleHeader.dependentFiles.getCount();
+
+    IncludeSystem includeSystem(&getSearchDirectories(), getFileSystemExt(), getSourceManager());
+    bool isUpToDate = true;
+    for (Index i = 0; i < moduleHeader.dependentFiles.getCount(); ++i)
     {
+        const auto& file = moduleHeader.dependentFiles[i];
+
+        FileStamp stamp;
+        String canonicalPath;
+        if (useFileStamps)
+        {
+            PathInfo pathInfo;
+            if ((SLANG_SUCCEEDED(includeSystem.findFile(file, fromPath, pathInfo)) ||
+                 SLANG_SUCCEEDED(includeSystem.findFile(file, moduleSrcPath, pathInfo))) &&
+                pathInfo.hasFileFoundPath() &&
+                SLANG_SUCCEEDED(File::getStamp(pathInfo.foundPath, stamp)))
+            {
+                if (hasRecordedStamps && stamp.isValid() &&
+                    stamp == moduleHeader.dependentFileStamps[i])
+                {
+                    digestBuilder.append(moduleHeader.dependentFileDigests[i]);
+                    continue;
+                }
+
+                SHA1::Digest cachedDigest;
+                if (digestCache &&
+                    SLANG_SUCCEEDED(Path::getCanonical(pathInfo.foundPath, canonicalPath)) &&
+                    digestCache->tryGetDigest(canonicalPath, stamp, cachedDigest))
+                {
+                    digestBuilder.append(cachedDigest);
+                    continue;
+                }
+            }
+        }
+
         auto sourceFile = loadSourceFile(fromPath, file);
         if (!sourceFile)
         {
@@ -4447,10 +4786,23 @@ bool Linkage::isBinaryModuleUpToDate(String fromPath, RiffContainer* container)
                 sourceFile = loadSourceFile(moduleSrcPath, file);
         }
         if (!sourceFile)
-            return false;
+        {
+            isUpToDate = false;
+            break;
+        }
         digestBuilder.append(sourceFile->getDigest());
+
+        // The source file may have been read before the stamp above was taken, so cache the
+        // digest against the stamp taken when it was read.
+        if (digestCache && canonicalPath.getLength() && sourceFile->getStamp().isValid())
+            digestCache->setDigest(canonicalPath, sourceFile->getStamp(), sourceFile->getDigest());
     }
-    return digestBuilder.finalize() == moduleHeader.digest;
+
+    // Digests computed for files are worth keeping even if the module turned out to be stale.
+    if (digestCache)
+        digestCache->save();
+
+    return isUpToDate && digestBuilder.finalize() == moduleHeader.digest;
 }
 
 SLANG_NO_THROW bool SLANG_MCALL
@@ -4668,6 +5020,18 @@ Module::Module(Linkage* linkage, ASTBuilder* astBuilder)
     addModuleDependency(this);
 }
 
+Module::~Module() {}
+
+SharedSemanticsContext* Module::getSemanticsForDeferredFunctionBodies()
+{
+    return m_semanticsForDeferredFunctionBodies;
+}
+
+void Module::setSemanticsForDeferredFunctionBodies(SharedSemanticsContext* context)
+{
+    m_semanticsForDeferredFunctionBodies = context;
+}
+
 ISlangUnknown* Module::getInterface(const Guid& guid)
 {
     if (guid == IModule::getTypeGuid())
@@ -4934,6 +5298,18 @@ static ICastable* _findDiagnosticRepresentation(IArtifact* artifact)
     return nullptr;
 }
 
+static IArtifact* _findReflectionSnapshot(IArtifact* artifact)
+{
+    for (auto associated : artifact->getAssociated())
+    {
+        if (associated->getDesc().payload == ArtifactPayload::ReflectionSnapshot)
+        {
+            return associated;
+        }
+    }
+    return nullptr;
+}
+
 static IArtifact* _findObfuscatedSourceMap(IArtifact* artifact)
 {
     // If we find any obfuscated source maps, we are done
@@ -4959,7 +5335,7 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
     ComPtr<ISlangBlob> code;
 
     SLANG_RETURN_ON_FAIL(
-        getEntryPointCode(entryPointIndex, targetIndex, diagnostics.writeRef(), code.writeRef()));
+        getEntryPointCode(entryPointIndex, targetIndex, code.writeRef(), diagnostics.writeRef()));
 
     auto linkage = getLinkage();
 
@@ -4969,6 +5345,39 @@ SLANG_NO_THROW SlangResult SLANG_MCALL ComponentType::getResultAsFileSystem(
 
     IArtifact* artifact = targetProgram->getExistingEntryPointResult(entryPointIndex);
 
+    // Add the reflection snapshot, if requested. This comes first, so that the
+    // diagnostics from laying out the program are added with the others.
+    if (targetProgram->getOptionSet().getBoolOption(
+            CompilerOptionName::ReflectionSnapshotArtifact) &&
+        !_findReflectionSnapshot(artifact))
+    {
+        DiagnosticSink sink(linkage->getSourceManager(), Lexer::sourceLocationLexer);
+        applySettingsToDiagnosticSink(&sink, &sink, linkage->m_optionSet);
+        applySettingsToDiagnosticSink(&sink, &sink, m_optionSet);
+
+        if (auto programLayout = targetProgram->getOrCreateLayout(&sink))
+        {
+            List<uint8_t> snapshot;
+            writeReflectionSnapshot(asExternal(programLayout), snapshot);
+
+            auto snapshotArtifact = Artifact::create(ArtifactDesc::make(
+                ArtifactKind::BinaryFormat,
+                ArtifactPayload::ReflectionSnapshot));
+            snapshotArtifact->addRepresentationUnknown(ListBlob::moveCreate(snapshot));
+
+            artifact->addAssociated(snapshotArtifact);
+        }
+
+        if (sink.outputBuffer.getLength())
+        {
+            StringBuilder allDiagnostics;
+            if (diagnostics)
+                allDiagnostics << StringUtil::getSlice(diagnostics);
+            allDiagnostics << sink.outputBuffer;
+            diagnostics = StringBlob::moveCreate(allDiagnostics);
+        }
+    }
+
     // Add diagnostics id needs be...
     if (diagnostics && !_findDiagnosticRepresentation(artifact))
     {
@@ -6134,6 +6543,29 @@ Session* CompileRequestBase::getSession()
     return getLinkage()->getSessionImpl();
 }
 
+bool Linkage::isUsingOSFileSystem()
+{
+    // A `CacheFileSystem` set by the user may wrap any file system, so it isn't considered.
+    return m_fileSystem == nullptr || m_fileSystem == OSFileSystem::getLoadSingleton() ||
+           m_fileSystem == OSFileSystem::getExtSingleton() ||
+           m_fileSystem == OSFileSystem::getMutableSingleton();
+}
+
+FileDigestCache* Linkage::getModuleDigestCache()
+{
+    if (!m_moduleDigestCache)
+    {
+        auto cachePath = m_optionSet.getStringOption(CompilerOptionName::ModuleDigestCache);
+        if (cachePath.getLength() == 0)
+            return nullptr;
+
+        m_moduleDigestCache = new FileDigestCache(cachePath);
+        // An unreadable cache is treated as empty; it is replaced on the next save.
+        m_moduleDigestCache->load();
+    }
+    return m_moduleDigestCache;
+}
+
 void Linkage::setFileSystem(ISlangFileSystem* inFileSystem)
 {
     // Set the fileSystem
@@ -6252,6 +6684,19 @@ RefPtr<Module> findOrImportModule(
     DiagnosticSink* sink,
     const LoadedModuleDictionary* loadedModules)
 {
+    // Modules loaded from here are imported by the module being checked.
+    struct ImportDeclDepthRAII
+    {
+        ImportDeclDepthRAII(Linkage* linkage)
+            : linkage(linkage)
+        {
+            linkage->m_importDeclDepth++;
+        }
+        ~ImportDeclDepthRAII() { linkage->m_importDeclDepth--; }
+        Linkage* linkage;
+    };
+    ImportDeclDepthRAII importDeclDepth(linkage);
+
     return linkage->findOrImportModule(name, loc, sink, loadedModules);
 }
 
@@ -6325,6 +6770,16 @@ void Session::addBuiltinSource(
     outModule = module;
 }
 
+ThreadPool* Session::getThreadPool()
+{
+    std::lock_guard<std::mutex> lock(m_threadPoolMutex);
+    if (!m_threadPool)
+    {
+        m_threadPool = new ThreadPool();
+    }
+    return m_threadPool;
+}
+
 Session::~Session()
 {
     // This is necessary because this ASTBuilder uses the SharedASTBuilder also owned by the
@@ -6332,6 +6787,7 @@ Session::~Session()
     // pointer, which is referenced in the ASTBuilder dtor (likely) causing a crash.
     //
     // By destroying first we know it is destroyed, before the SharedASTBuilder.
+    m_sharedTypeCheckingCache.setNull();
     globalAstBuilder.setNull();
 
     // destroy modules next
@@ -6974,6 +7430,53 @@ void EndToEndCompileRequest::setAllowGLSLInput(bool value)
     getOptionSet().set(CompilerOptionName::AllowGLSL, value);
 }
 
+static void _appendIRPassTelemetry(IArtifact* artifact, List<ComPtr<ISlangBlob>>& ioBlobs)
+{
+    if (!artifact)
+        return;
+
+    for (auto associated : artifact->getAssociated())
+    {
+        ComPtr<ISlangBlob> blob;
+        if (associated->getDesc().payload == ArtifactPayload::IRPassTelemetry &&
+            SLANG_SUCCEEDED(associated->loadBlob(ArtifactKeep::No, blob.writeRef())))
+        {
+            ioBlobs.add(blob);
+        }
+    }
+}
+
+/// Get the IR pass telemetry recorded for every target and entry point of `program`,
+/// as a JSON array.
+static String _getIRPassTelemetryJSON(Linkage* linkage, ComponentType* program)
+{
+    List<ComPtr<ISlangBlob>> blobs;
+    if (program)
+    {
+        for (auto targetReq : linkage->targets)
+        {
+            auto targetProgram = program->getTargetProgram(targetReq);
+            _appendIRPassTelemetry(targetProgram->getExistingWholeProgramResult(), blobs);
+
+            for (Index i = 0; i < program->getEntryPointCount(); ++i)
+            {
+                _appendIRPassTelemetry(targetProgram->getExistingEntryPointResult(i), blobs);
+            }
+        }
+    }
+
+    StringBuilder builder;
+    builder << "[\n";
+    for (Index i = 0; i < blobs.getCount(); ++i)
+    {
+        if (i)
+            builder << ",\n";
+        builder << StringUtil::getSlice(blobs[i]);
+    }
+    builder << "]\n";
+    return builder.produceString();
+}
+
 SlangResult EndToEndCompileRequest::compile()
 {
     SlangResult res = SLANG_FAIL;
@@ -7061,6 +7564,10 @@ SlangResult EndToEndCompileRequest::compile()
         StringBuilder perfResult;
         PerformanceProfiler::getProfiler()->getResult(perfResult);
         perfResult << "\nType Dictionary Size: " << getSession()->m_typeDictionarySize << "\n";
+        const auto sharedCacheStats = getSession()->getSharedTypeCheckingCache()->getStats();
+        perfResult << "Shared Type Checking Cache: " << sharedCacheStats.hitCount << " hits, "
+                   << sharedCacheStats.missCount << " misses, " << sharedCacheStats.entryCount
+                   << " entries\n";
         getSink()->diagnose(
             SourceLoc(),
             Diagnostics::performanceBenchmarkResult,
@@ -7118,6 +7625,39 @@ SlangResult EndToEndCompileRequest::compile()
         }
     }
 
+    auto snapshotPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitReflectionSnapshot);
+    if (snapshotPath.getLength() != 0)
+    {
+        if (auto reflection = getReflection())
+        {
+            List<uint8_t> snapshot;
+            writeReflectionSnapshot((slang::ShaderReflection*)reflection, snapshot);
+            if (SLANG_FAILED(
+                    File::writeAllBytes(snapshotPath, snapshot.getBuffer(), snapshot.getCount())))
+            {
+                getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, snapshotPath);
+            }
+        }
+    }
+
+    auto passTelemetryPath =
+        getOptionSet().getStringOption(CompilerOptionName::EmitIRPassTelemetry);
+    if (passTelemetryPath.getLength() != 0)
+    {
+        auto passTelemetry = _getIRPassTelemetryJSON(
+            getLinkage(),
+            getSpecializedGlobalAndEntryPointsComponentType());
+        if (passTelemetryPath == "-")
+        {
+            StdWriters::getOut().write(passTelemetry.getBuffer(), passTelemetry.getLength());
+        }
+        else if (SLANG_FAILED(File::writeAllText(passTelemetryPath, passTelemetry)))
+        {
+            getSink()->diagnose(SourceLoc(), Diagnostics::unableToWriteFile, passTelemetryPath);
+        }
+    }
+
     return res;
 }
 
@@ -0,0 +1,193 @@
+#include "core/slang-basic.h"
+#include "gfx-test-util.h"
+#include "gfx-util/shader-cursor.h"
+#include "slang-gfx.h"
+#include "unit-test/slang-unit-test.h"
+using namespace gfx;
+
+namespace gfx_test
+{
+namespace
+{ // anonymous
+struct uint4
+{
+    uint32_t x, y, z, w;
+};
+} // namespace
+
+static Slang::ComPtr<IBufferResource> _createUint4Buffer(
+    IDevice* device,
+    uint32_t data,
+    ResourceState defaultState)
+{
+    uint32_t initialData[] = {data, data, data, data};
+    IBufferResource::Desc bufferDesc = {};
+    bufferDesc.sizeInBytes = sizeof(initialData);
+    bufferDesc.format = gfx::Format::Unknown;
+    bufferDesc.elementSize = sizeof(uint32_t) * 4;
+    bufferDesc.allowedStates = ResourceStateSet(
+        ResourceState::ShaderResource,
+        ResourceState::UnorderedAccess,
+        ResourceState::CopyDestination,
+        ResourceState::CopySource);
+    bufferDesc.defaultState = defaultState;
+    bufferDesc.memoryType = MemoryType::DeviceLocal;
+
+    ComPtr<IBufferResource> buffer;
+    GFX_CHECK_CALL_ABORT(
+        device->createBufferResource(bufferDesc, (void*)initialData, buffer.writeRef()));
+    return buffer;
+}
+
+static Slang::ComPtr<IResourceView> _createUint4BufferView(
+    IDevice* device,
+    IBufferResource* buffer,
+    IResourceView::Type type)
+{
+    IResourceView::Desc viewDesc = {};
+    viewDesc.type = type;
+    viewDesc.format = Format::Unknown;
+    viewDesc.bufferRange.offset = 0;
+    viewDesc.bufferRange.size = sizeof(uint32_t) * 4;
+    ComPtr<IResourceView> view;
+    GFX_CHECK_CALL_ABORT(device->createBufferView(buffer, nullptr, viewDesc, view.writeRef()));
+    return view;
+}
+
+// Check that a compiled path leads to the same location as the equivalent textual path.
+static ShaderCursor _getCheckedPath(const ShaderCursor& cursor, const char* path)
+{
+    ShaderCursorPath compiledPath;
+    SLANG_CHECK(SLANG_SUCCEEDED(cursor.compilePath(path, compiledPath)));
+
+    ShaderCursor expected = cursor.getPath(path);
+    ShaderCursor actual = cursor.getPath(compiledPath);
+    SLANG_CHECK(actual.isValid());
+    SLANG_CHECK(actual.m_baseObject == expected.m_baseObject);
+    SLANG_CHECK(actual.m_typeLayout == expected.m_typeLayout);
+    SLANG_CHECK(actual.m_containerType == expected.m_containerType);
+    SLANG_CHECK(actual.m_offset == expected.m_offset);
+    return actual;
+}
+
+void compiledShaderCursorPathTestImpl(IDevice* device, UnitTestContext* context)
+{
+    Slang::ComPtr<ITransientResourceHeap> transientHeap;
+    ITransientResourceHeap::Desc transientHeapDesc = {};
+    transientHeapDesc.constantBufferSize = 4096;
+    GFX_CHECK_CALL_ABORT(
+        device->createTransientResourceHeap(transientHeapDesc, transientHeap.writeRef()));
+
+    ComPtr<IShaderProgram> shaderProgram;
+    slang::ProgramLayout* slangReflection;
+    GFX_CHECK_CALL_ABORT(loadComputeProgram(
+        device,
+        shaderProgram,
+        "nested-parameter-block",
+        "computeMain",
+        slangReflection));
+
+    ComputePipelineStateDesc pipelineDesc = {};
+    pipelineDesc.program = shaderProgram.get();
+    ComPtr<gfx::IPipelineState> pipelineState;
+    GFX_CHECK_CALL_ABORT(
+        device->createComputePipelineState(pipelineDesc, pipelineState.writeRef()));
+
+    ComPtr<IShaderObject> shaderObject;
+    SLANG_CHECK(SLANG_SUCCEEDED(
+        device->createMutableRootShaderObject(shaderProgram, shaderObject.writeRef())));
+
+    auto srvBuffer1 = _createUint4Buffer(device, 1, gfx::ResourceState::ShaderResource);
+    auto srvBuffer2 = _createUint4Buffer(device, 2, gfx::ResourceState::ShaderResource);
+    auto srv1 = _createUint4BufferView(device, srvBuffer1, IResourceView::Type::ShaderResource);
+    auto srv2 = _createUint4BufferView(device, srvBuffer2, IResourceView::Type::ShaderResource);
+
+    auto resultBuffer = _createUint4Buffer(device, 0, gfx::ResourceState::UnorderedAccess);
+    auto resultBufferView =
+        _createUint4BufferView(device, resultBuffer, IResourceView::Type::UnorderedAccess);
+
+    Slang::ComPtr<IShaderObject> materialObject;
+    SLANG_CHECK(SLANG_SUCCEEDED(device->createMutableShaderObject(
+        slangReflection->findTypeByName("MaterialSystem"),
+        ShaderObjectContainerType::None,
+        materialObject.writeRef())));
+
+    Slang::ComPtr<IShaderObject> sceneObject;
+    SLANG_CHECK(SLANG_SUCCEEDED(device->createMutableShaderObject(
+        slangReflection->findTypeByName("Scene"),
+        ShaderObjectContainerType::None,
+        sceneObject.writeRef())));
+
+    ShaderCursor cursor(shaderObject);
+    _getCheckedPath(cursor, "resultBuffer").setResource(resultBufferView);
+    _getCheckedPath(cursor, "scene").setObject(sceneObject);
+
+    Slang::ComPtr<IShaderObject> globalCB;
+    SLANG_CHECK(SLANG_SUCCEEDED(device->createShaderObject(
+        cursor[0].getTypeLayout()->getType(),
+        ShaderObjectContainerType::None,
+        globalCB.writeRef())));
+    _getCheckedPath(cursor, "[0]").setObject(globalCB);
+    _getCheckedPath(cursor, "[0].value").setData(uint4{20, 20, 20, 20});
+
+    // Paths through the parameter blocks are resolved against the objects bound to them.
+    _getCheckedPath(cursor, "scene.sceneCb").setData(uint4{100, 100, 100, 100});
+    _getCheckedPath(cursor, "scene.data").setResource(srv1);
+    _getCheckedPath(cursor, "scene.material").setObject(materialObject);
+
+    ShaderCursorPath materialCbPath;
+    SLANG_CHECK(SLANG_SUCCEEDED(cursor.compilePath("scene.material.cb.value", materialCbPath)));
+    SLANG_CHECK(materialCbPath.m_segmentCount == 3);
+    _getCheckedPath(cursor, "scene.material.data").setResource(srv2);
+
+    // A compiled path can be applied repeatedly; the last write wins.
+    for (uint32_t i = 0; i <= 1000; i += 100)
+    {
+        SLANG_CHECK(
+            SLANG_SUCCEEDED(cursor.getPath(materialCbPath).setData(uint4{i, i, i, i})));
+    }
+
+    // Paths to fields that don't exist can't be compiled.
+    ShaderCursorPath invalidPath;
+    SLANG_CHECK(SLANG_FAILED(cursor.compilePath("scene.missing", invalidPath)));
+    SLANG_CHECK(SLANG_FAILED(cursor.compilePath("scene..data", invalidPath)));
+    SLANG_CHECK(!invalidPath.isValid());
+
+    // A compiled path only applies to cursors of the type it was compiled against.
+    ShaderCursorPath sceneDataPath;
+    SLANG_CHECK(SLANG_SUCCEEDED(ShaderCursor(sceneObject).compilePath("data", sceneDataPath)));
+    SLANG_CHECK(ShaderCursor(sceneObject).getPath(sceneDataPath).isValid());
+    SLANG_CHECK(!ShaderCursor(materialObject).getPath(sceneDataPath).isValid());
+
+    {
+        ICommandQueue::Desc queueDesc = {ICommandQueue::QueueType::Graphics};
+        auto queue = device->createCommandQueue(queueDesc);
+
+        auto commandBuffer = transientHeap->createCommandBuffer();
+        auto encoder = commandBuffer->encodeComputeCommands();
+
+        encoder->bindPipelineWithRootObject(pipelineState, shaderObject);
+
+        encoder->dispatchCompute(1, 1, 1);
+        encoder->endEncoding();
+        commandBuffer->close();
+        queue->executeCommandBuffer(commandBuffer);
+        queue->waitOnHost();
+    }
+
+    compareComputeResult(
+        device,
+        resultBuffer,
+        Slang::makeArray<uint32_t>(1123u, 1123u, 1123u, 1123u));
+}
+
+SLANG_UNIT_TEST(compiledShaderCursorPathD3D12)
+{
+    runTestImpl(compiledShaderCursorPathTestImpl, unitTestContext, Slang::RenderApiFlag::D3D12);
+}
+
+SLANG_UNIT_TEST(compiledShaderCursorPathVulkan)
+{
+    runTestImpl(compiledShaderCursorPathTestImpl, unitTestContext, Slang::RenderApiFlag::Vulkan);
+}
+} // namespace gfx_test
@@ -289,10 +289,12 @@ static int _get(const char*& slice)
     return result;
 }
 
-Result ShaderCursor::followPath(const char* path, ShaderCursor& ioCursor)
+/// Parse a path of the form accepted by `ShaderCursor::followPath`, calling
+/// `visitor.visitName(nameBegin, nameEnd)` for each field name and `visitor.visitIndex(index)`
+/// for each subscript in it.
+template<typename Visitor>
+static Result _parsePath(const char* path, Visitor& visitor)
 {
-    ShaderCursor cursor = ioCursor;
-
     enum
     {
         ALLOW_NAME = 0x1,
@@ -341,7 +343,7 @@ Result ShaderCursor::followPath(const char* path, ShaderCursor& ioCursor)
                 return SLANG_E_INVALID_ARG;
             _get(rest);
 
-            cursor = cursor.getElement(index);
+            SLANG_RETURN_ON_FAIL(visitor.visitIndex(index));
             state = ALLOW_DOT | ALLOW_SUBSCRIPT;
             continue;
         }
@@ -364,12 +366,220 @@ Result ShaderCursor::followPath(const char* path, ShaderCursor& ioCursor)
                 break;
             }
             char const* nameEnd = rest;
+            SLANG_RETURN_ON_FAIL(visitor.visitName(nameBegin, nameEnd));
+            state = ALLOW_DOT | ALLOW_SUBSCRIPT;
+            continue;
+        }
+    }
+    return SLANG_OK;
+}
+
+Result ShaderCursor::followPath(const char* path, ShaderCursor& ioCursor)
+{
+    struct Visitor
+    {
+        ShaderCursor cursor;
+
+        Result visitName(const char* nameBegin, const char* nameEnd)
+        {
+            // A missing field results in an invalid cursor rather than an error.
             ShaderCursor newCursor;
             cursor.getField(nameBegin, nameEnd, newCursor);
             cursor = newCursor;
-            state = ALLOW_DOT | ALLOW_SUBSCRIPT;
-            continue;
+            return SLANG_OK;
+        }
+
+        Result visitIndex(GfxIndex index)
+        {
+            cursor = cursor.getElement(index);
+            return SLANG_OK;
+        }
+    };
+
+    Visitor visitor;
+    visitor.cursor = ioCursor;
+    SLANG_RETURN_ON_FAIL(_parsePath(path, visitor));
+
+    ioCursor = visitor.cursor;
+    return SLANG_OK;
+}
+
+namespace
+{ // anonymous
+
+// Resolves a path while following it with an actual cursor. The cursor is only needed to
+// find the sub-objects bound to constant buffers and parameter blocks, while the offsets
+// the path adds are accumulated into the segments of the compiled path.
+struct ShaderCursorPathCompiler
+{
+    ShaderCursor cursor;
+    ShaderCursorPath* path = nullptr;
+
+    ShaderCursorPath::Segment& getSegment() { return path->m_segments[path->m_segmentCount - 1]; }
+
+    Result beginSegment(bool dereference)
+    {
+        if (path->m_segmentCount > ShaderCursorPath::kMaxDereferenceCount)
+            return SLANG_E_NOT_IMPLEMENTED;
+
+        ShaderCursorPath::Segment segment;
+        segment.dereference = dereference;
+        segment.baseTypeLayout = cursor.m_typeLayout;
+        segment.baseContainerType = cursor.m_containerType;
+        path->m_segments[path->m_segmentCount++] = segment;
+        return SLANG_OK;
+    }
+
+    void setCursor(const ShaderCursor& newCursor)
+    {
+        cursor = newCursor;
+
+        auto& segment = getSegment();
+        segment.typeLayout = cursor.m_typeLayout;
+        segment.containerType = cursor.m_containerType;
+    }
+
+    /// Add the offset of the field at `fieldIndex` of the current (structure) type.
+    void addFieldOffset(GfxIndex fieldIndex)
+    {
+        auto& segment = getSegment();
+        auto typeLayout = cursor.m_typeLayout;
+        auto fieldLayout = typeLayout->getFieldByIndex((unsigned int)fieldIndex);
+        segment.offset.uniformOffset += fieldLayout->getOffset();
+        segment.offset.bindingRangeIndex +=
+            (GfxIndex)typeLayout->getFieldBindingRangeOffset(fieldIndex);
+    }
+
+    Result visitName(const char* nameBegin, const char* nameEnd)
+    {
+        if (!cursor.isValid())
+            return SLANG_E_INVALID_ARG;
+
+        switch (cursor.m_typeLayout->getKind())
+        {
+        case slang::TypeReflection::Kind::Struct:
+            {
+                SlangInt fieldIndex = cursor.m_typeLayout->findFieldIndexByName(nameBegin, nameEnd);
+                if (fieldIndex == -1)
+                    return SLANG_E_INVALID_ARG;
+
+                ShaderCursor fieldCursor;
+                SLANG_RETURN_ON_FAIL(cursor.getField(nameBegin, nameEnd, fieldCursor));
+                addFieldOffset((GfxIndex)fieldIndex);
+                setCursor(fieldCursor);
+                return SLANG_OK;
+            }
+
+        case slang::TypeReflection::Kind::ConstantBuffer:
+        case slang::TypeReflection::Kind::ParameterBlock:
+            {
+                ShaderCursor d;
+                SLANG_RETURN_ON_FAIL(cursor.getDereferenced(d));
+                if (!d.isValid())
+                    return SLANG_E_INVALID_ARG;
+                cursor = d;
+                SLANG_RETURN_ON_FAIL(beginSegment(true));
+                setCursor(d);
+                return visitName(nameBegin, nameEnd);
+            }
+
+        default:
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+
+    Result visitIndex(GfxIndex index)
+    {
+        if (!cursor.isValid())
+            return SLANG_E_INVALID_ARG;
+
+        ShaderCursor elementCursor = cursor.getElement(index);
+        if (!elementCursor.isValid())
+            return SLANG_E_INVALID_ARG;
+
+        // The changes to the offset mirror those made by `getElement`.
+        auto& segment = getSegment();
+        auto typeLayout = cursor.m_typeLayout;
+        if (cursor.m_containerType != ShaderObjectContainerType::None)
+        {
+            segment.resetOffset = true;
+            segment.offset.uniformOffset = index * typeLayout->getStride();
+            segment.offset.bindingRangeIndex = 0;
+            segment.offset.bindingArrayIndex = index;
+            segment.bindingArrayIndexScale = 1;
+        }
+        else if (typeLayout->getKind() == slang::TypeReflection::Kind::Array)
+        {
+            auto elementCount = (GfxCount)typeLayout->getElementCount();
+            segment.offset.uniformOffset +=
+                index * typeLayout->getElementStride(SLANG_PARAMETER_CATEGORY_UNIFORM);
+            segment.offset.bindingArrayIndex =
+                segment.offset.bindingArrayIndex * elementCount + index;
+            segment.bindingArrayIndexScale *= elementCount;
+        }
+        else if (typeLayout->getKind() == slang::TypeReflection::Kind::Struct)
+        {
+            addFieldOffset(index);
+        }
+        else
+        {
+            segment.offset.uniformOffset +=
+                typeLayout->getElementStride(SLANG_PARAMETER_CATEGORY_UNIFORM) * index;
         }
+
+        setCursor(elementCursor);
+        return SLANG_OK;
+    }
+};
+
+} // namespace
+
+Result ShaderCursor::compilePath(const char* path, ShaderCursorPath& outPath) const
+{
+    if (!isValid())
+        return SLANG_E_INVALID_ARG;
+
+    ShaderCursorPath compiledPath;
+    ShaderCursorPathCompiler compiler;
+    compiler.cursor = *this;
+    compiler.path = &compiledPath;
+    SLANG_RETURN_ON_FAIL(compiler.beginSegment(false));
+    compiler.setCursor(*this);
+    SLANG_RETURN_ON_FAIL(_parsePath(path, compiler));
+
+    outPath = compiledPath;
+    return SLANG_OK;
+}
+
+Result ShaderCursor::followPath(const ShaderCursorPath& path, ShaderCursor& ioCursor)
+{
+    if (!path.isValid() || !ioCursor.isValid())
+        return SLANG_E_INVALID_ARG;
+
+    ShaderCursor cursor = ioCursor;
+    for (GfxCount i = 0; i < path.m_segmentCount; ++i)
+    {
+        auto& segment = path.m_segments[i];
+        if (segment.dereference)
+        {
+            SLANG_RETURN_ON_FAIL(cursor.getDereferenced(cursor));
+            if (!cursor.isValid())
+                return SLANG_E_INVALID_ARG;
+        }
+
+        if (cursor.m_typeLayout != segment.baseTypeLayout ||
+            cursor.m_containerType != segment.baseContainerType)
+            return SLANG_E_INVALID_ARG;
+
+        ShaderOffset baseOffset = segment.resetOffset ? ShaderOffset() : cursor.m_offset;
+        cursor.m_offset.uniformOffset = baseOffset.uniformOffset + segment.offset.uniformOffset;
+        cursor.m_offset.bindingRangeIndex =
+            baseOffset.bindingRangeIndex + segment.offset.bindingRangeIndex;
+        cursor.m_offset.bindingArrayIndex =
+            baseOffset.bindingArrayIndex * segment.bindingArrayIndexScale +
+            segment.offset.bindingArrayIndex;
+        cursor.m_typeLayout = segment.typeLayout;
+        cursor.m_containerType = segment.containerType;
     }
 
     ioCursor = cursor;
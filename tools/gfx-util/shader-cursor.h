@@ -5,6 +5,64 @@
 namespace gfx
 {
 
+/// A path to a shader parameter, like `"material.textures[2]"`, that has been resolved once
+/// so that cursors for it can be formed repeatedly without parsing the path or looking up
+/// field names.
+///
+/// A compiled path is formed with `ShaderCursor::compilePath`, and records the offsets that
+/// the path adds to the cursor it starts from. It can be applied with `ShaderCursor::getPath`
+/// to any cursor that points at a value with the same type layout as the cursor it was
+/// compiled against, which makes per-frame parameter writes simple offset arithmetic.
+///
+/// A path that goes through a constant buffer or parameter block records the type layout
+/// of the sub-object that was bound there when the path was compiled. Applying the path
+/// fails if the sub-object bound at that point has a different layout.
+///
+struct ShaderCursorPath
+{
+    /// The maximum number of constant buffers or parameter blocks a path can go through.
+    static const GfxCount kMaxDereferenceCount = 7;
+
+    /// A run of field and element accesses within a single shader object.
+    struct Segment
+    {
+        /// Does the segment start by dereferencing the constant buffer or parameter block
+        /// that the cursor points at?
+        bool dereference = false;
+
+        /// Does the segment select an element of a container object? If so the offset of
+        /// the incoming cursor is discarded, as it is by `ShaderCursor::getElement`.
+        bool resetOffset = false;
+
+        /// The type layout and container type the cursor must have at the start of the
+        /// segment (after any dereference).
+        slang::TypeLayoutReflection* baseTypeLayout = nullptr;
+        ShaderObjectContainerType baseContainerType = ShaderObjectContainerType::None;
+
+        /// The type layout and container type of the cursor at the end of the segment.
+        slang::TypeLayoutReflection* typeLayout = nullptr;
+        ShaderObjectContainerType containerType = ShaderObjectContainerType::None;
+
+        /// The offset added to the incoming cursor. The `bindingArrayIndex` of the
+        /// incoming cursor is multiplied by `bindingArrayIndexScale` before the offset's
+        /// `bindingArrayIndex` is added, to account for indexing into arrays.
+        ShaderOffset offset;
+        GfxCount bindingArrayIndexScale = 1;
+    };
+
+    Segment m_segments[kMaxDereferenceCount + 1];
+    GfxCount m_segmentCount = 0;
+
+    /// Is this path valid (that is, was it successfully compiled)?
+    bool isValid() const { return m_segmentCount != 0; }
+
+    /// Get the type (layout) of the value the path leads to.
+    slang::TypeLayoutReflection* getTypeLayout() const
+    {
+        return m_segmentCount ? m_segments[m_segmentCount - 1].typeLayout : nullptr;
+    }
+};
+
 /// Represents a "pointer" to the storage for a shader parameter of a (dynamically) known type.
 ///
 /// A `ShaderCursor` serves as a pointer-like type for things stored inside a `ShaderObject`.
@@ -81,6 +139,27 @@ struct ShaderCursor
         return result;
     }
 
+    /// Resolve `path` starting from this cursor, producing a compiled path that can be
+    /// applied to this or other cursors pointing at values of the same type layout.
+    ///
+    /// Unlike `followPath`, lookups of names that fall back to the entry points of a
+    /// root shader object are not supported, and fail.
+    Result compilePath(const char* path, ShaderCursorPath& outPath) const;
+
+    /// Apply a compiled `path` to `ioCursor`.
+    ///
+    /// Fails with `SLANG_E_INVALID_ARG` if the cursor, or a sub-object the path goes
+    /// through, doesn't have the type layout the path was compiled against.
+    static Result followPath(const ShaderCursorPath& path, ShaderCursor& ioCursor);
+
+    ShaderCursor getPath(const ShaderCursorPath& path) const
+    {
+        ShaderCursor result(*this);
+        if (SLANG_FAILED(followPath(path, result)))
+            return ShaderCursor();
+        return result;
+    }
+
     ShaderCursor() {}
 
     ShaderCursor(IShaderObject* object)
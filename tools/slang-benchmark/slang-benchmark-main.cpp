@@ -0,0 +1,881 @@
+// slang-benchmark-main.cpp
+
+// A compiler throughput benchmark.
+//
+// Runs the fixed scenario corpus in `tools/slang-benchmark/scenarios` through
+// the Slang API, one phase at a time:
+//
+// * global session creation
+// * loading a module from source (parsing and semantic checking)
+// * serializing a module, and loading it back from the `.slang-module` blob,
+//   with the default IR compression and each of `kIrCompressions`
+// * linking, optimizing and emitting each entry point for SPIR-V, HLSL, GLSL,
+//   Metal, WGSL and C++
+// * hashing a buffer with each of the digest algorithms used for cache keys
+//   and stored digests, reported as bytes per second
+//
+// For each phase the wall time (min and median over the iterations), the
+// number of heap allocations, the bytes allocated and the peak live heap size
+// are recorded. Where the compiler's own profiler has finer grained timings
+// for the phase (e.g. `checkAllTranslationUnits` or `linkAndOptimizeIR`) they
+// are reported as a breakdown.
+//
+// Results are written as JSON, and can be compared against the JSON of a
+// previous run with `-baseline`, in which case the process fails if any phase
+// got slower than the allowed threshold.
+//
+// Heap statistics are gathered by replacing the global allocation functions
+// of this executable. On platforms where the slang shared library doesn't
+// bind to those (Windows), only allocations made directly by the benchmark are
+// seen, so the numbers are only meaningful when compared on the same platform.
+
+#include "../../source/compiler-core/slang-json-parser.h"
+#include "../../source/compiler-core/slang-json-value.h"
+#include "../../source/compiler-core/slang-lexer.h"
+#include "../../source/core/slang-crypto.h"
+#include "../../source/core/slang-dictionary.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-list.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-helper.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <stdio.h>
+#include <stdlib.h>
+
+#if !SLANG_WINDOWS_FAMILY
+#include <sys/resource.h>
+#endif
+
+using namespace Slang;
+
+//
+// Heap tracking
+//
+
+namespace
+{
+
+struct HeapStats
+{
+    std::atomic<uint64_t> allocationCount{0};
+    std::atomic<uint64_t> allocatedBytes{0};
+    std::atomic<uint64_t> liveBytes{0};
+    std::atomic<uint64_t> peakLiveBytes{0};
+};
+
+HeapStats g_heapStats;
+
+// Every allocation is prefixed by a header holding its size, so frees can be
+// accounted for. The header keeps the returned pointer maximally aligned.
+const size_t kHeapHeaderSize = alignof(std::max_align_t);
+
+void* _trackedAlloc(size_t size)
+{
+    void* block = ::malloc(size + kHeapHeaderSize);
+    if (!block)
+        return nullptr;
+    *(size_t*)block = size;
+
+    g_heapStats.allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_heapStats.allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    const uint64_t live =
+        g_heapStats.liveBytes.fetch_add(size, std::memory_order_relaxed) + size;
+
+    uint64_t peak = g_heapStats.peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak &&
+           !g_heapStats.peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+    return (char*)block + kHeapHeaderSize;
+}
+
+void _trackedFree(void* ptr)
+{
+    if (!ptr)
+        return;
+    void* block = (char*)ptr - kHeapHeaderSize;
+    g_heapStats.liveBytes.fetch_sub(*(size_t*)block, std::memory_order_relaxed);
+    ::free(block);
+}
+
+} // namespace
+
+void* operator new(size_t size)
+{
+    if (void* ptr = _trackedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size)
+{
+    if (void* ptr = _trackedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return _trackedAlloc(size);
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return _trackedAlloc(size);
+}
+void operator delete(void* ptr) noexcept
+{
+    _trackedFree(ptr);
+}
+void operator delete[](void* ptr) noexcept
+{
+    _trackedFree(ptr);
+}
+void operator delete(void* ptr, size_t) noexcept
+{
+    _trackedFree(ptr);
+}
+void operator delete[](void* ptr, size_t) noexcept
+{
+    _trackedFree(ptr);
+}
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+    _trackedFree(ptr);
+}
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+    _trackedFree(ptr);
+}
+
+//
+// Corpus
+//
+
+namespace
+{
+
+struct BenchmarkEntryPoint
+{
+    const char* name;
+    SlangStage stage;
+};
+
+struct BenchmarkScenario
+{
+    const char* name;
+    const char* fileName;
+    const BenchmarkEntryPoint* entryPoints;
+    Index entryPointCount;
+    /// Graphics stages can't be emitted for the C++ target
+    bool isComputeOnly;
+};
+
+struct BenchmarkTarget
+{
+    const char* name;
+    SlangCompileTarget format;
+    const char* profile;
+};
+
+const BenchmarkEntryPoint kComputeEntryPoints[] = {{"computeMain", SLANG_STAGE_COMPUTE}};
+const BenchmarkEntryPoint kRasterEntryPoints[] = {
+    {"vertexMain", SLANG_STAGE_VERTEX},
+    {"fragmentMain", SLANG_STAGE_FRAGMENT}};
+
+const BenchmarkScenario kScenarios[] = {
+    {"compute-basic", "compute-basic.slang", kComputeEntryPoints, 1, true},
+    {"generics-interfaces", "generics-interfaces.slang", kComputeEntryPoints, 1, true},
+    {"autodiff", "autodiff.slang", kComputeEntryPoints, 1, true},
+    {"raster", "raster.slang", kRasterEntryPoints, 2, false},
+};
+
+const BenchmarkTarget kTargets[] = {
+    {"spirv", SLANG_SPIRV, "spirv_1_5"},
+    {"hlsl", SLANG_HLSL, "sm_6_5"},
+    {"glsl", SLANG_GLSL, "glsl_450"},
+    {"metal", SLANG_METAL, nullptr},
+    {"wgsl", SLANG_WGSL, nullptr},
+    {"cpp", SLANG_CPP_SOURCE, nullptr},
+};
+
+// IR compression types compared against the default (`lite`) for serialize/load-binary
+const char* const kIrCompressions[] = {
+    "stream-vbyte",
+    "stream-vbyte-lz4",
+};
+
+//
+// Measurement
+//
+
+struct PhaseResult
+{
+    String name;
+    List<double> wallTimesMS;
+    uint64_t allocationCount = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t peakLiveBytes = 0;
+    /// Minimum over the iterations of the time the compiler's profiler
+    /// attributed to each of its sections during this phase.
+    OrderedDictionary<String, double> breakdownMS;
+    /// Bytes processed by each iteration, for phases that measure throughput.
+    uint64_t processedBytes = 0;
+    bool failed = false;
+
+    double getMinMS() const
+    {
+        double result = wallTimesMS.getCount() ? wallTimesMS[0] : 0.0;
+        for (auto t : wallTimesMS)
+            result = std::min(result, t);
+        return result;
+    }
+
+    double getMedianMS() const
+    {
+        if (wallTimesMS.getCount() == 0)
+            return 0.0;
+        List<double> sorted(wallTimesMS);
+        sorted.sort();
+        return sorted[sorted.getCount() / 2];
+    }
+
+    double getBytesPerSecond() const
+    {
+        const double minMS = getMinMS();
+        return minMS > 0.0 ? double(processedBytes) * 1000.0 / minMS : 0.0;
+    }
+};
+
+struct Options
+{
+    Index iterationCount = 3;
+    String scenarioDirectory = "tools/slang-benchmark/scenarios";
+    List<String> scenarioFilter;
+    List<String> targetFilter;
+    String outputPath;
+    String baselinePath;
+    double thresholdPercent = 10.0;
+};
+
+class BenchmarkContext
+{
+public:
+    SlangResult init()
+    {
+        SLANG_RETURN_ON_FAIL(slang::createGlobalSession(m_globalSession.writeRef()));
+
+        // The compiler's profiler is only reachable through a compile request. It
+        // records for the whole thread, so one request serves for all phases.
+        slang::SessionDesc sessionDesc;
+        SLANG_RETURN_ON_FAIL(
+            m_globalSession->createSession(sessionDesc, m_profileSession.writeRef()));
+        SLANG_RETURN_ON_FAIL(m_profileSession->createCompileRequest(m_profileRequest.writeRef()));
+        _readProfile(nullptr);
+        return SLANG_OK;
+    }
+
+    /// Run `func` as one iteration of the phase `name`, which processes
+    /// `processedBytes` bytes if it measures throughput.
+    template<typename F>
+    SlangResult measure(const String& name, const F& func, uint64_t processedBytes = 0)
+    {
+        PhaseResult& phase = _getPhase(name);
+        phase.processedBytes = processedBytes;
+
+        _readProfile(nullptr);
+
+        const uint64_t startCount = g_heapStats.allocationCount.load();
+        const uint64_t startBytes = g_heapStats.allocatedBytes.load();
+        const uint64_t startLive = g_heapStats.liveBytes.load();
+        g_heapStats.peakLiveBytes.store(startLive);
+
+        const auto startTime = std::chrono::steady_clock::now();
+        const SlangResult res = func();
+        const auto endTime = std::chrono::steady_clock::now();
+
+        phase.wallTimesMS.add(
+            std::chrono::duration<double, std::milli>(endTime - startTime).count());
+
+        // Allocation counts are deterministic, so keep those of the last iteration.
+        phase.allocationCount = g_heapStats.allocationCount.load() - startCount;
+        phase.allocatedBytes = g_heapStats.allocatedBytes.load() - startBytes;
+        phase.peakLiveBytes = g_heapStats.peakLiveBytes.load() - startLive;
+
+        _readProfile(&phase);
+
+        if (SLANG_FAILED(res))
+        {
+            phase.failed = true;
+        }
+        return res;
+    }
+
+    slang::IGlobalSession* getGlobalSession() const { return m_globalSession; }
+
+    const OrderedDictionary<String, PhaseResult>& getPhases() const { return m_phases; }
+
+protected:
+    PhaseResult& _getPhase(const String& name)
+    {
+        if (auto phase = m_phases.tryGetValue(name))
+            return *phase;
+        PhaseResult phase;
+        phase.name = name;
+        m_phases.add(name, phase);
+        return *m_phases.tryGetValue(name);
+    }
+
+    void _readProfile(PhaseResult* phase)
+    {
+        if (!m_profileRequest)
+            return;
+
+        ComPtr<ISlangProfiler> profiler;
+        if (SLANG_FAILED(m_profileRequest->getCompileTimeProfile(profiler.writeRef(), true)) ||
+            !phase)
+        {
+            return;
+        }
+
+        const uint32_t entryCount = uint32_t(profiler->getEntryCount());
+        for (uint32_t i = 0; i < entryCount; ++i)
+        {
+            const String entryName = profiler->getEntryName(i);
+            const double timeMS = double(profiler->getEntryTimeMS(i));
+
+            if (auto existing = phase->breakdownMS.tryGetValue(entryName))
+            {
+                *existing = std::min(*existing, timeMS);
+            }
+            else
+            {
+                phase->breakdownMS.add(entryName, timeMS);
+            }
+        }
+    }
+
+    ComPtr<slang::IGlobalSession> m_globalSession;
+    ComPtr<slang::ISession> m_profileSession;
+    ComPtr<slang::ICompileRequest> m_profileRequest;
+    OrderedDictionary<String, PhaseResult> m_phases;
+};
+
+//
+// Scenarios
+//
+
+bool _isSelected(const List<String>& filter, const char* name)
+{
+    return filter.getCount() == 0 || filter.indexOf(String(name)) >= 0;
+}
+
+SlangResult _createSession(
+    slang::IGlobalSession* globalSession,
+    const BenchmarkTarget* target,
+    const String& searchPath,
+    slang::ISession** outSession,
+    const char* irCompression = nullptr)
+{
+    slang::TargetDesc targetDesc;
+    if (target)
+    {
+        targetDesc.format = target->format;
+        if (target->profile)
+            targetDesc.profile = globalSession->findProfile(target->profile);
+    }
+
+    const char* searchPaths[] = {searchPath.getBuffer()};
+
+    slang::SessionDesc sessionDesc;
+    sessionDesc.targets = target ? &targetDesc : nullptr;
+    sessionDesc.targetCount = target ? 1 : 0;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.searchPathCount = 1;
+
+    slang::CompilerOptionEntry compressionEntry;
+    if (irCompression)
+    {
+        compressionEntry.name = slang::CompilerOptionName::IrCompression;
+        compressionEntry.value.kind = slang::CompilerOptionValueKind::String;
+        compressionEntry.value.stringValue0 = irCompression;
+        sessionDesc.compilerOptionEntries = &compressionEntry;
+        sessionDesc.compilerOptionEntryCount = 1;
+    }
+
+    return globalSession->createSession(sessionDesc, outSession);
+}
+
+void _reportDiagnostics(slang::IBlob* diagnostics)
+{
+    if (diagnostics && diagnostics->getBufferSize())
+    {
+        fprintf(stderr, "%s\n", (const char*)diagnostics->getBufferPointer());
+    }
+}
+
+SlangResult _runScenario(
+    BenchmarkContext& context,
+    const Options& options,
+    const BenchmarkScenario& scenario)
+{
+    auto globalSession = context.getGlobalSession();
+
+    const String path = Path::combine(options.scenarioDirectory, scenario.fileName);
+    String source;
+    SLANG_RETURN_ON_FAIL(File::readAllText(path, source));
+
+    const String prefix = String(scenario.name) + "/";
+
+    ComPtr<ISlangBlob> moduleBlob;
+
+    // Parse and check from source
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(
+            _createSession(globalSession, nullptr, options.scenarioDirectory, session.writeRef()));
+
+        slang::IModule* module = nullptr;
+        SLANG_RETURN_ON_FAIL(context.measure(
+            prefix + "load-source",
+            [&]() -> SlangResult
+            {
+                ComPtr<slang::IBlob> diagnostics;
+                module = session->loadModuleFromSourceString(
+                    scenario.name,
+                    path.getBuffer(),
+                    source.getBuffer(),
+                    diagnostics.writeRef());
+                _reportDiagnostics(diagnostics);
+                return module ? SLANG_OK : SLANG_FAIL;
+            }));
+
+        SLANG_RETURN_ON_FAIL(context.measure(
+            prefix + "serialize",
+            [&]() { return module->serialize(moduleBlob.writeRef()); }));
+    }
+
+    // Load from the serialized `.slang-module`
+    {
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(
+            _createSession(globalSession, nullptr, options.scenarioDirectory, session.writeRef()));
+
+        SLANG_RETURN_ON_FAIL(context.measure(
+            prefix + "load-binary",
+            [&]() -> SlangResult
+            {
+                ComPtr<slang::IBlob> diagnostics;
+                auto module = session->loadModuleFromIRBlob(
+                    scenario.name,
+                    path.getBuffer(),
+                    moduleBlob,
+                    diagnostics.writeRef());
+                _reportDiagnostics(diagnostics);
+                return module ? SLANG_OK : SLANG_FAIL;
+            }));
+    }
+
+    // The same round trip with each of the other IR compression types
+    for (auto irCompression : kIrCompressions)
+    {
+        ComPtr<ISlangBlob> compressedModuleBlob;
+        {
+            ComPtr<slang::ISession> session;
+            SLANG_RETURN_ON_FAIL(_createSession(
+                globalSession,
+                nullptr,
+                options.scenarioDirectory,
+                session.writeRef(),
+                irCompression));
+
+            slang::IModule* module = session->loadModuleFromSourceString(
+                scenario.name,
+                path.getBuffer(),
+                source.getBuffer());
+            if (!module)
+                return SLANG_FAIL;
+
+            SLANG_RETURN_ON_FAIL(context.measure(
+                prefix + "serialize-" + irCompression,
+                [&]() { return module->serialize(compressedModuleBlob.writeRef()); }));
+        }
+
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(
+            _createSession(globalSession, nullptr, options.scenarioDirectory, session.writeRef()));
+
+        SLANG_RETURN_ON_FAIL(context.measure(
+            prefix + "load-binary-" + irCompression,
+            [&]() -> SlangResult
+            {
+                ComPtr<slang::IBlob> diagnostics;
+                auto module = session->loadModuleFromIRBlob(
+                    scenario.name,
+                    path.getBuffer(),
+                    compressedModuleBlob,
+                    diagnostics.writeRef());
+                _reportDiagnostics(diagnostics);
+                return module ? SLANG_OK : SLANG_FAIL;
+            }));
+    }
+
+    // Link, optimize and emit for each target. The module is loaded from the
+    // binary blob so front-end work doesn't count towards these phases.
+    for (const auto& target : kTargets)
+    {
+        if (!_isSelected(options.targetFilter, target.name) ||
+            (target.format == SLANG_CPP_SOURCE && !scenario.isComputeOnly))
+        {
+            continue;
+        }
+
+        ComPtr<slang::ISession> session;
+        SLANG_RETURN_ON_FAIL(
+            _createSession(globalSession, &target, options.scenarioDirectory, session.writeRef()));
+
+        slang::IModule* module =
+            session->loadModuleFromIRBlob(scenario.name, path.getBuffer(), moduleBlob);
+        if (!module)
+            return SLANG_FAIL;
+
+        List<ComPtr<slang::IComponentType>> components;
+        components.add(ComPtr<slang::IComponentType>(module));
+        for (Index i = 0; i < scenario.entryPointCount; ++i)
+        {
+            const auto& entryPointInfo = scenario.entryPoints[i];
+
+            ComPtr<slang::IEntryPoint> entryPoint;
+            ComPtr<slang::IBlob> diagnostics;
+            SLANG_RETURN_ON_FAIL(module->findAndCheckEntryPoint(
+                entryPointInfo.name,
+                entryPointInfo.stage,
+                entryPoint.writeRef(),
+                diagnostics.writeRef()));
+            components.add(ComPtr<slang::IComponentType>(entryPoint.get()));
+        }
+
+        // Emission failures for a target are recorded in the results rather
+        // than aborting the whole run.
+        context.measure(
+            prefix + "emit-" + target.name,
+            [&]() -> SlangResult
+            {
+                ComPtr<slang::IComponentType> composite;
+                SLANG_RETURN_ON_FAIL(session->createCompositeComponentType(
+                    (slang::IComponentType* const*)components.getBuffer(),
+                    components.getCount(),
+                    composite.writeRef()));
+
+                ComPtr<slang::IComponentType> linked;
+                ComPtr<slang::IBlob> diagnostics;
+                SLANG_RETURN_ON_FAIL(composite->link(linked.writeRef(), diagnostics.writeRef()));
+
+                for (Index i = 0; i < scenario.entryPointCount; ++i)
+                {
+                    ComPtr<slang::IBlob> code;
+                    diagnostics.setNull();
+                    const SlangResult res =
+                        linked->getEntryPointCode(i, 0, code.writeRef(), diagnostics.writeRef());
+                    if (SLANG_FAILED(res))
+                    {
+                        _reportDiagnostics(diagnostics);
+                        return res;
+                    }
+                }
+                return SLANG_OK;
+            });
+    }
+
+    return SLANG_OK;
+}
+
+//
+// Hashing
+//
+
+// Size of the buffer hashed by each iteration of the hash phases
+const size_t kHashBufferSize = 64 * 1024 * 1024;
+
+template<typename Hash>
+SlangResult _measureHash(BenchmarkContext& context, const char* name, const List<uint8_t>& buffer)
+{
+    return context.measure(
+        String("hash-") + name,
+        [&]() -> SlangResult
+        {
+            const auto digest = Hash::compute(buffer.getBuffer(), buffer.getCount());
+            return digest == typename Hash::Digest() ? SLANG_FAIL : SLANG_OK;
+        },
+        uint64_t(buffer.getCount()));
+}
+
+SlangResult _runHashes(BenchmarkContext& context, const Options& options)
+{
+    List<uint8_t> buffer;
+    buffer.setCount(kHashBufferSize);
+    uint32_t state = 0x12345678;
+    for (auto& byte : buffer)
+    {
+        state = state * 1664525 + 1013904223;
+        byte = uint8_t(state >> 24);
+    }
+
+    for (Index i = 0; i < options.iterationCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(_measureHash<MD5>(context, "md5", buffer));
+        SLANG_RETURN_ON_FAIL(_measureHash<SHA1>(context, "sha1", buffer));
+        SLANG_RETURN_ON_FAIL(_measureHash<MurmurHash3>(context, "murmur3", buffer));
+    }
+    return SLANG_OK;
+}
+
+//
+// Output
+//
+
+void _writeResults(const BenchmarkContext& context, const Options& options, StringBuilder& out)
+{
+    out << "{\n";
+    out << "  \"version\": 1,\n";
+    out << "  \"slangVersion\": \"" << context.getGlobalSession()->getBuildTagString() << "\",\n";
+    out << "  \"iterations\": " << options.iterationCount << ",\n";
+
+#if !SLANG_WINDOWS_FAMILY
+    {
+        struct rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+#if SLANG_APPLE_FAMILY
+        const uint64_t peakResidentBytes = uint64_t(usage.ru_maxrss);
+#else
+        const uint64_t peakResidentBytes = uint64_t(usage.ru_maxrss) * 1024;
+#endif
+        out << "  \"peakResidentBytes\": " << peakResidentBytes << ",\n";
+    }
+#endif
+
+    out << "  \"phases\": [\n";
+    Index phaseIndex = 0;
+    for (const auto& [name, phase] : context.getPhases())
+    {
+        out << "    {\n";
+        out << "      \"name\": \"" << name << "\",\n";
+        out << "      \"failed\": " << (phase.failed ? "true" : "false") << ",\n";
+        out << "      \"minMS\": " << phase.getMinMS() << ",\n";
+        out << "      \"medianMS\": " << phase.getMedianMS() << ",\n";
+        out << "      \"allocations\": " << phase.allocationCount << ",\n";
+        out << "      \"allocatedBytes\": " << phase.allocatedBytes << ",\n";
+        out << "      \"peakHeapBytes\": " << phase.peakLiveBytes << ",\n";
+        if (phase.processedBytes)
+        {
+            out << "      \"bytesPerSecond\": " << phase.getBytesPerSecond() << ",\n";
+        }
+        out << "      \"breakdownMS\": {";
+        Index entryIndex = 0;
+        for (const auto& [entryName, timeMS] : phase.breakdownMS)
+        {
+            out << (entryIndex++ ? ", " : " ") << "\"" << entryName << "\": " << timeMS;
+        }
+        out << (entryIndex ? " }\n" : "}\n");
+        out << "    }" << (++phaseIndex < Index(context.getPhases().getCount()) ? "," : "")
+            << "\n";
+    }
+    out << "  ]\n";
+    out << "}\n";
+}
+
+/// Compares the min wall time of each phase with `baselinePath`. Returns
+/// SLANG_FAIL if any phase regressed by more than the threshold.
+SlangResult _compareWithBaseline(const BenchmarkContext& context, const Options& options)
+{
+    SourceManager sourceManager;
+    sourceManager.initialize(nullptr, nullptr);
+    DiagnosticSink sink(&sourceManager, Lexer::sourceLocationLexer);
+
+    String contents;
+    if (SLANG_FAILED(File::readAllText(options.baselinePath, contents)))
+    {
+        fprintf(stderr, "error: unable to read baseline '%s'\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    PathInfo pathInfo = PathInfo::makeFromString(options.baselinePath);
+    SourceFile* sourceFile = sourceManager.createSourceFileWithString(pathInfo, contents);
+    SourceView* sourceView = sourceManager.createSourceView(sourceFile, nullptr, SourceLoc());
+
+    JSONContainer container(&sourceManager);
+    JSONBuilder builder(&container);
+    JSONLexer lexer;
+    lexer.init(sourceView, &sink);
+    JSONParser parser;
+    if (SLANG_FAILED(parser.parse(&lexer, sourceView, &builder, &sink)))
+    {
+        fprintf(stderr, "error: unable to parse baseline '%s'\n", options.baselinePath.getBuffer());
+        return SLANG_FAIL;
+    }
+
+    const JSONValue root = builder.getRootValue();
+    const JSONValue phases = container.findObjectValue(root, container.getKey(toSlice("phases")));
+    if (!phases.isValid() || phases.type != JSONValue::Type::Array)
+    {
+        fprintf(stderr, "error: baseline has no 'phases'\n");
+        return SLANG_FAIL;
+    }
+
+    const JSONKey nameKey = container.getKey(toSlice("name"));
+    const JSONKey minKey = container.getKey(toSlice("minMS"));
+
+    // Phases that take less than this are too noisy to compare.
+    const double kMinComparableMS = 1.0;
+
+    SlangResult result = SLANG_OK;
+    printf("%-40s %12s %12s %9s\n", "phase", "baseline ms", "current ms", "change");
+    for (const auto& baselinePhase : container.getArray(phases))
+    {
+        const String name =
+            container.getString(container.findObjectValue(baselinePhase, nameKey));
+        const double baselineMS =
+            container.asFloat(container.findObjectValue(baselinePhase, minKey));
+
+        auto phase = context.getPhases().tryGetValue(name);
+        if (!phase || phase->failed)
+            continue;
+
+        const double currentMS = phase->getMinMS();
+        const double changePercent =
+            baselineMS > 0.0 ? (currentMS - baselineMS) * 100.0 / baselineMS : 0.0;
+
+        const bool isRegression =
+            baselineMS >= kMinComparableMS && changePercent > options.thresholdPercent;
+        printf(
+            "%-40s %12.3f %12.3f %+8.1f%%%s\n",
+            name.getBuffer(),
+            baselineMS,
+            currentMS,
+            changePercent,
+            isRegression ? "  REGRESSION" : "");
+
+        if (isRegression)
+            result = SLANG_FAIL;
+    }
+    return result;
+}
+
+SlangResult _parseOptions(int argc, char** argv, Options& outOptions)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const UnownedStringSlice arg(argv[i]);
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == toSlice("-iterations") && hasValue)
+        {
+            Int count = 0;
+            SLANG_RETURN_ON_FAIL(StringUtil::parseInt(UnownedStringSlice(argv[++i]), count));
+            outOptions.iterationCount = std::max(Index(count), Index(1));
+        }
+        else if (arg == toSlice("-scenario-dir") && hasValue)
+        {
+            outOptions.scenarioDirectory = argv[++i];
+        }
+        else if (arg == toSlice("-scenario") && hasValue)
+        {
+            outOptions.scenarioFilter.add(argv[++i]);
+        }
+        else if (arg == toSlice("-target") && hasValue)
+        {
+            outOptions.targetFilter.add(argv[++i]);
+        }
+        else if (arg == toSlice("-o") && hasValue)
+        {
+            outOptions.outputPath = argv[++i];
+        }
+        else if (arg == toSlice("-baseline") && hasValue)
+        {
+            outOptions.baselinePath = argv[++i];
+        }
+        else if (arg == toSlice("-threshold") && hasValue)
+        {
+            SLANG_RETURN_ON_FAIL(
+                StringUtil::parseDouble(UnownedStringSlice(argv[++i]), outOptions.thresholdPercent));
+        }
+        else
+        {
+            fprintf(
+                stderr,
+                "usage: %s [-iterations <n>] [-scenario-dir <dir>] [-scenario <name>]... "
+                "[-target <name>]... [-o <results.json>] [-baseline <results.json>] "
+                "[-threshold <percent>]\n",
+                argv[0]);
+            return SLANG_E_INVALID_ARG;
+        }
+    }
+    return SLANG_OK;
+}
+
+} // namespace
+
+SlangResult innerMain(int argc, char** argv)
+{
+    Options options;
+    SLANG_RETURN_ON_FAIL(_parseOptions(argc, argv, options));
+
+    BenchmarkContext context;
+
+    for (Index i = 0; i < options.iterationCount; ++i)
+    {
+        SLANG_RETURN_ON_FAIL(context.measure(
+            "global-session-create",
+            []() -> SlangResult
+            {
+                ComPtr<slang::IGlobalSession> globalSession;
+                return slang::createGlobalSession(globalSession.writeRef());
+            }));
+    }
+
+    SLANG_RETURN_ON_FAIL(context.init());
+
+    SLANG_RETURN_ON_FAIL(_runHashes(context, options));
+
+    for (const auto& scenario : kScenarios)
+    {
+        if (!_isSelected(options.scenarioFilter, scenario.name))
+            continue;
+
+        for (Index i = 0; i < options.iterationCount; ++i)
+        {
+            if (SLANG_FAILED(_runScenario(context, options, scenario)))
+            {
+                fprintf(stderr, "error: scenario '%s' failed\n", scenario.name);
+                return SLANG_FAIL;
+            }
+        }
+    }
+
+    StringBuilder results;
+    _writeResults(context, options, results);
+
+    if (options.outputPath.getLength())
+    {
+        SLANG_RETURN_ON_FAIL(File::writeAllText(options.outputPath, results));
+    }
+    else
+    {
+        fputs(results.getBuffer(), stdout);
+    }
+
+    if (options.baselinePath.getLength())
+    {
+        return _compareWithBaseline(context, options);
+    }
+    return SLANG_OK;
+}
+
+int main(int argc, char** argv)
+{
+    const SlangResult res = innerMain(argc, argv);
+    return SLANG_SUCCEEDED(res) ? 0 : 1;
+}
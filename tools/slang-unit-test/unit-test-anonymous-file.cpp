@@ -0,0 +1,63 @@
+// unit-test-anonymous-file.cpp
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-representation-impl.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+#include "unit-test/slang-unit-test.h"
+
+#if SLANG_LINUX_FAMILY
+#include <fcntl.h>
+#include <stdlib.h>
+#endif
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(anonymousFile)
+{
+    if (!AnonymousFileArtifactRepresentation::isSupported())
+    {
+        return;
+    }
+
+    const UnownedStringSlice contents = toSlice("Hello anonymous file");
+
+    ComPtr<IOSFileArtifactRepresentation> fileRep;
+    SLANG_CHECK(SLANG_SUCCEEDED(AnonymousFileArtifactRepresentation::create(
+        "test",
+        contents.begin(),
+        size_t(contents.getLength()),
+        fileRep)));
+    if (!fileRep)
+    {
+        return;
+    }
+
+    SLANG_CHECK(fileRep->exists());
+
+    // The path can be used like any other OS path
+    String text;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::readAllText(fileRep->getPath(), text)));
+    SLANG_CHECK(text == contents);
+
+#if SLANG_LINUX_FAMILY
+    {
+        // The descriptor isn't inherited by launched processes, and the path doesn't depend on it
+        // being inherited.
+        const String path = fileRep->getPath();
+        const Index fdStart = path.lastIndexOf('/') + 1;
+        const int fd = atoi(path.getBuffer() + fdStart);
+        SLANG_CHECK((::fcntl(fd, F_GETFD) & FD_CLOEXEC) != 0);
+        SLANG_CHECK(!path.startsWith("/proc/self/"));
+    }
+#endif
+
+    // And the contents are available as a blob through an artifact
+    auto artifact =
+        ArtifactUtil::createArtifact(ArtifactDescUtil::makeDescForCompileTarget(SLANG_CPP_SOURCE));
+    artifact->addRepresentation(fileRep);
+
+    ComPtr<ISlangBlob> blob;
+    SLANG_CHECK(SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())));
+    SLANG_CHECK(blob && StringUtil::getSlice(blob) == contents);
+}
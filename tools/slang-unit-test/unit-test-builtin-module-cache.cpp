@@ -0,0 +1,140 @@
+// unit-test-builtin-module-cache.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-platform.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <stdlib.h>
+
+using namespace Slang;
+
+// Test that a compiled core module is saved to the cache, loaded from it, and rebuilt when the
+// cached entry is invalid, and that saving only removes entries left by other builds of the same
+// library.
+
+namespace
+{ // anonymous
+
+static int _setEnvironmentVariable(const char* key, const char* val)
+{
+#ifdef _WIN32
+    String var = String(key) + "=" + val;
+    return _putenv(var.getBuffer());
+#else
+    return setenv(key, val, 1);
+#endif
+}
+
+struct CacheFileFinder : Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File && fileName.startsWith(toSlice("slang-core-module-")) &&
+            fileName.endsWith(toSlice(".bin")))
+        {
+            fileNames.add(fileName);
+        }
+    }
+
+    List<String> fileNames;
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(builtinModuleCache)
+{
+    // The cache is only used when the core module isn't embedded in slang.
+    if (slang_getEmbeddedCoreModule())
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/builtin-module-cache-test" +
+        String(Process::getId()));
+    Path::createDirectoryRecursive(directory);
+
+    StringBuilder previousDirectory;
+    const bool hadPreviousDirectory = SLANG_SUCCEEDED(PlatformUtil::getEnvironmentVariable(
+        toSlice("SLANG_CORE_MODULE_CACHE_PATH"),
+        previousDirectory));
+    SLANG_CHECK_ABORT(
+        _setEnvironmentVariable("SLANG_CORE_MODULE_CACHE_PATH", directory.getBuffer()) == 0);
+
+    auto findFiles = [&]()
+    {
+        CacheFileFinder finder;
+        Path::find(directory, nullptr, &finder);
+        return finder.fileNames;
+    };
+
+    auto createSession = [&]()
+    {
+        ComPtr<slang::IGlobalSession> globalSession;
+        SLANG_CHECK(
+            slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+        return globalSession != nullptr;
+    };
+
+    // The first session compiles the module and saves it
+    SLANG_CHECK(createSession());
+    auto fileNames = findFiles();
+    SLANG_CHECK_ABORT(fileNames.getCount() == 1);
+
+    // The name is `slang-core-module-<library>-<build>-<config>.bin`
+    const String fileName = fileNames[0];
+    const String path = Path::combine(directory, fileName);
+    List<UnownedStringSlice> parts;
+    StringUtil::split(fileName.getUnownedSlice().head(fileName.getLength() - 4), '-', parts);
+    SLANG_CHECK_ABORT(parts.getCount() == 6);
+    const String library = parts[3];
+    const String build = parts[4];
+    const String config = parts[5];
+
+    ScopedAllocation savedContents;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::readAllBytes(path, savedContents)));
+
+    // Entries for an earlier build of this library, for another library, and for other options
+    const String staleFileName =
+        "slang-core-module-" + library + "-0000000000000000-" + config + ".bin";
+    const String otherLibraryFileName =
+        "slang-core-module-0000000000000000-" + build + "-" + config + ".bin";
+    const String otherConfigFileName =
+        "slang-core-module-" + library + "-" + build + "-0000000000000000.bin";
+    for (const auto& name : {staleFileName, otherLibraryFileName, otherConfigFileName})
+    {
+        SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllText(Path::combine(directory, name), "stale")));
+    }
+
+    // The next session loads the saved module, leaving the cache as it is
+    SLANG_CHECK(createSession());
+    SLANG_CHECK(findFiles().getCount() == 4);
+
+    // An invalid entry is replaced by a newly compiled module, which removes the earlier build's
+    SLANG_CHECK(SLANG_SUCCEEDED(File::writeAllText(path, "invalid")));
+    SLANG_CHECK(createSession());
+
+    fileNames = findFiles();
+    SLANG_CHECK(fileNames.getCount() == 3);
+    SLANG_CHECK(fileNames.indexOf(fileName) >= 0);
+    SLANG_CHECK(fileNames.indexOf(staleFileName) < 0);
+    SLANG_CHECK(fileNames.indexOf(otherLibraryFileName) >= 0);
+    SLANG_CHECK(fileNames.indexOf(otherConfigFileName) >= 0);
+
+    ScopedAllocation contents;
+    SLANG_CHECK(SLANG_SUCCEEDED(File::readAllBytes(path, contents)));
+    SLANG_CHECK(contents.getSizeInBytes() == savedContents.getSizeInBytes());
+
+    _setEnvironmentVariable(
+        "SLANG_CORE_MODULE_CACHE_PATH",
+        hadPreviousDirectory ? previousDirectory.getBuffer() : "");
+    for (const auto& name : fileNames)
+    {
+        File::remove(Path::combine(directory, name));
+    }
+    Path::remove(directory);
+}
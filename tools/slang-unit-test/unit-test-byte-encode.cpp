@@ -151,4 +151,43 @@ SLANG_UNIT_TEST(byteEncode)
         }
 #endif
     }
+
+    {
+        // Stream encoding, with counts that exercise whole groups, partial groups and
+        // (for the larger counts) the shuffle based decode
+        const uint32_t masks[] = {0x000000ff, 0x0000ffff, 0x00ffffff, 0xffffffff};
+        for (int count = 0; count < 100; count++)
+        {
+            List<uint32_t> values;
+            for (int i = 0; i < count; i++)
+            {
+                values.add(randGen.nextInt32() & masks[randGen.nextInt32UpTo(4)]);
+            }
+
+            List<uint8_t> encoded;
+            ByteEncodeUtil::encodeStreamUInt32(values.begin(), size_t(count), encoded);
+
+            List<uint32_t> decoded;
+            decoded.setCount(count);
+            const size_t decodedSize = ByteEncodeUtil::decodeStreamUInt32(
+                encoded.begin(),
+                size_t(encoded.getCount()),
+                size_t(count),
+                decoded.begin());
+
+            SLANG_CHECK(decodedSize == size_t(encoded.getCount()));
+            SLANG_CHECK(decoded == values);
+
+            // A truncated encoding must be detected rather than read past
+            if (count && values.getLast() > 0xff)
+            {
+                SLANG_CHECK(
+                    ByteEncodeUtil::decodeStreamUInt32(
+                        encoded.begin(),
+                        size_t(encoded.getCount() - 1),
+                        size_t(count),
+                        decoded.begin()) == 0);
+            }
+        }
+    }
 }
@@ -0,0 +1,93 @@
+// unit-test-compiler-option-hash.cpp
+
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that the values of compiler options, including the ints held by string valued options,
+// are part of the hash used to identify compiled code.
+
+namespace
+{ // anonymous
+
+static const char* kSource = R"(
+    RWStructuredBuffer<int> output;
+
+    [shader("compute")]
+    [numthreads(1, 1, 1)]
+    void computeMain()
+    {
+        output[0] = 1;
+    }
+    )";
+
+} // namespace
+
+SLANG_UNIT_TEST(compilerOptionHash)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    // Get the hash of the entry point compiled with a dispatch profile of one entry.
+    auto getHash = [&](const char* typeName, int count)
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::DynamicDispatchProfile;
+        entry.value.kind = slang::CompilerOptionValueKind::String;
+        entry.value.stringValue0 = typeName;
+        entry.value.intValue0 = count;
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.compilerOptionEntryCount = 1;
+        sessionDesc.compilerOptionEntries = &entry;
+
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module =
+            session->loadModuleFromSourceString("m", "m.slang", kSource, diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint};
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+        ComPtr<slang::IBlob> hash;
+        program->getEntryPointHash(0, 0, hash.writeRef());
+        SLANG_CHECK_ABORT(hash != nullptr);
+        return hash;
+    };
+
+    auto isSame = [](slang::IBlob* a, slang::IBlob* b)
+    {
+        return a->getBufferSize() == b->getBufferSize() &&
+               memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+    };
+
+    auto hash = getHash("MyImpl", 100);
+    SLANG_CHECK(isSame(hash, getHash("MyImpl", 100)));
+
+    // Only the count differs
+    SLANG_CHECK(!isSame(hash, getHash("MyImpl", 200)));
+
+    // Only the type name differs
+    SLANG_CHECK(!isSame(hash, getHash("MyImpl2", 100)));
+}
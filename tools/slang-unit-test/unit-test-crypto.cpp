@@ -120,6 +120,60 @@ SLANG_UNIT_TEST(crypto)
             "cca0871ecbe200379f0a1e4b46de177e2d62e655");
     }
 
+    // MurmurHash3
+
+    // Empty string
+    {
+        MurmurHash3 hash;
+        auto digest = hash.finalize();
+        SLANG_CHECK(digest.toString() == "00000000000000000000000000000000");
+    }
+
+    // One call to update()
+    {
+        MurmurHash3 hash;
+        const String str("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+                         "tempor incididunt ut labore et dolore magna aliqua.");
+        hash.update(str.getBuffer(), str.getLength());
+        auto digest = hash.finalize();
+        SLANG_CHECK(digest.toString() == "afc19d4795be99f3942700eba09e8643");
+    }
+
+    // Two calls to update()
+    {
+        MurmurHash3 hash;
+        const String str1("Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod "
+                          "tempor incididunt ut labore et dolore magna aliqua.");
+        const String str2("Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi "
+                          "ut aliquip ex ea commodo consequat.");
+        hash.update(str1.getBuffer(), str1.getLength());
+        hash.update(str2.getBuffer(), str2.getLength());
+        auto digest = hash.finalize();
+        SLANG_CHECK(digest.toString() == "77f6e41a23d3dc35e9e0ec91a450efe0");
+    }
+
+    // compute(), and updates of every size up to a few blocks
+    {
+        const String str("The quick brown fox jumps over the lazy dog");
+        SLANG_CHECK(
+            MurmurHash3::compute(str.getBuffer(), str.getLength()).toString() ==
+            "6c1b07bc7bbc4be347939ac4a93c437a");
+
+        for (Index length = 0; length <= str.getLength(); ++length)
+        {
+            const auto expected = MurmurHash3::compute(str.getBuffer(), length);
+            for (Index step = 1; step <= 17; ++step)
+            {
+                MurmurHash3 hash;
+                for (Index i = 0; i < length; i += step)
+                {
+                    hash.update(str.getBuffer() + i, Math::Min(step, length - i));
+                }
+                SLANG_CHECK(hash.finalize() == expected);
+            }
+        }
+    }
+
     // DigestBuider
 
     // Raw numerical values, etc.
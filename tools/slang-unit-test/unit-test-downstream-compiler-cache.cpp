@@ -0,0 +1,194 @@
+// unit-test-downstream-compiler-cache.cpp
+#include "../../source/compiler-core/slang-artifact-associated-impl.h"
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-downstream-compiler-cache.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-file-system.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+namespace
+{ // anonymous
+
+/// A compiler that 'compiles' by reversing the source text, and produces a warning.
+/// It counts how many times it has been invoked.
+class ReversingCompiler : public DownstreamCompilerBase
+{
+public:
+    virtual SLANG_NO_THROW SlangResult SLANG_MCALL
+    compile(const CompileOptions& options, IArtifact** outArtifact) SLANG_OVERRIDE
+    {
+        ++m_compileCount;
+
+        ComPtr<ISlangBlob> sourceBlob;
+        SLANG_RETURN_ON_FAIL(
+            options.sourceArtifacts[0]->loadBlob(ArtifactKeep::No, sourceBlob.writeRef()));
+
+        const auto size = sourceBlob->getBufferSize();
+        const char* src = (const char*)sourceBlob->getBufferPointer();
+        List<uint8_t> product;
+        product.setCount(Count(size));
+        for (size_t i = 0; i < size; ++i)
+        {
+            product[Index(i)] = uint8_t(src[size - 1 - i]);
+        }
+
+        auto artifact = ArtifactUtil::createArtifactForCompileTarget(options.targetType);
+
+        auto diagnostics = ArtifactDiagnostics::create();
+        ArtifactDiagnostic diagnostic;
+        diagnostic.severity = ArtifactDiagnostic::Severity::Warning;
+        diagnostic.text = TerminatedCharSlice("reversed");
+        diagnostic.code = TerminatedCharSlice("W1");
+        diagnostic.location.line = 3;
+        diagnostics->add(diagnostic);
+        diagnostics->setResult(SLANG_OK);
+        ArtifactUtil::addAssociated(artifact, diagnostics);
+
+        artifact->addRepresentationUnknown(ListBlob::moveCreate(product));
+
+        *outArtifact = artifact.detach();
+        return SLANG_OK;
+    }
+    virtual SLANG_NO_THROW bool SLANG_MCALL isFileBased() SLANG_OVERRIDE { return false; }
+
+    ReversingCompiler()
+        : DownstreamCompilerBase(DownstreamCompilerDesc(SLANG_PASS_THROUGH_GLSLANG, 1, 0))
+    {
+    }
+
+    Index m_compileCount = 0;
+};
+
+struct DownstreamCompilerCacheTest
+{
+    DownstreamCompilerCacheTest()
+    {
+        cacheDirectory = Path::simplify(
+            Path::getParentDirectory(Path::getExecutablePath()) +
+            "/downstream-compiler-cache-test" + String(Process::getId()));
+        removeFiles();
+        Path::createDirectory(cacheDirectory);
+
+        PersistentCache::Desc desc;
+        desc.directory = cacheDirectory.getBuffer();
+        cache = new PersistentCache(desc);
+
+        inner = new ReversingCompiler;
+        compiler = new CachingDownstreamCompiler(inner, cache);
+    }
+
+    ~DownstreamCompilerCacheTest()
+    {
+        compiler.setNull();
+        cache = nullptr;
+        removeFiles();
+    }
+
+    void removeFiles()
+    {
+        auto fileSystem = OSFileSystem::getMutableSingleton();
+        fileSystem->enumeratePathContents(
+            cacheDirectory.getBuffer(),
+            [](SlangPathType, const char* fileName, void* userData)
+            {
+                auto self = static_cast<DownstreamCompilerCacheTest*>(userData);
+                OSFileSystem::getMutableSingleton()->remove(
+                    Path::combine(self->cacheDirectory, fileName).getBuffer());
+            },
+            this);
+        fileSystem->remove(cacheDirectory.getBuffer());
+    }
+
+    /// Compile `source` and return the product as a string, checking the diagnostics are intact.
+    String compile(const char* source, const char* define = nullptr)
+    {
+        auto sourceArtifact =
+            ArtifactUtil::createArtifact(ArtifactDescUtil::makeDescForCompileTarget(SLANG_GLSL));
+        sourceArtifact->setName(Path::combine(cacheDirectory, "source.glsl").getBuffer());
+        sourceArtifact->addRepresentationUnknown(StringBlob::create(UnownedStringSlice(source)));
+
+        DownstreamCompileOptions::Define defines[1];
+        if (define)
+        {
+            defines[0].nameWithSig = TerminatedCharSlice(define);
+            defines[0].value = TerminatedCharSlice("1");
+        }
+
+        TerminatedCharSlice includePath(cacheDirectory.getBuffer(), cacheDirectory.getLength());
+
+        DownstreamCompileOptions options;
+        options.targetType = SLANG_SPIRV;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_GLSL;
+        options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+        options.defines = makeSlice(defines, define ? 1 : 0);
+        options.includePaths = makeSlice(&includePath, 1);
+
+        ComPtr<IArtifact> artifact;
+        SLANG_CHECK(SLANG_SUCCEEDED(compiler->compile(options, artifact.writeRef())));
+
+        auto diagnostics = findAssociatedRepresentation<IArtifactDiagnostics>(artifact);
+        SLANG_CHECK(diagnostics && diagnostics->getCount() == 1);
+        if (diagnostics && diagnostics->getCount() == 1)
+        {
+            const auto& diagnostic = *diagnostics->getAt(0);
+            SLANG_CHECK(diagnostic.severity == ArtifactDiagnostic::Severity::Warning);
+            SLANG_CHECK(asStringSlice(diagnostic.text) == toSlice("reversed"));
+            SLANG_CHECK(asStringSlice(diagnostic.code) == toSlice("W1"));
+            SLANG_CHECK(diagnostic.location.line == 3);
+        }
+
+        ComPtr<ISlangBlob> blob;
+        SLANG_CHECK(SLANG_SUCCEEDED(artifact->loadBlob(ArtifactKeep::No, blob.writeRef())));
+        return blob ? String(UnownedStringSlice(
+                          (const char*)blob->getBufferPointer(),
+                          blob->getBufferSize()))
+                    : String();
+    }
+
+    void writeHeader(const char* contents)
+    {
+        File::writeAllText(Path::combine(cacheDirectory, "header.h"), contents);
+    }
+
+    String cacheDirectory;
+    RefPtr<PersistentCache> cache;
+    ReversingCompiler* inner;
+    ComPtr<IDownstreamCompiler> compiler;
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(downstreamCompilerCache)
+{
+    DownstreamCompilerCacheTest test;
+
+    // A miss, then a hit that reproduces the product and diagnostics
+    SLANG_CHECK(test.compile("abc") == "cba");
+    SLANG_CHECK(test.inner->m_compileCount == 1);
+    SLANG_CHECK(test.compile("abc") == "cba");
+    SLANG_CHECK(test.inner->m_compileCount == 1);
+
+    // Different source, or different options are misses
+    SLANG_CHECK(test.compile("abcd") == "dcba");
+    SLANG_CHECK(test.inner->m_compileCount == 2);
+    SLANG_CHECK(test.compile("abc", "SOME_DEFINE") == "cba");
+    SLANG_CHECK(test.inner->m_compileCount == 3);
+    SLANG_CHECK(test.compile("abc", "SOME_DEFINE") == "cba");
+    SLANG_CHECK(test.inner->m_compileCount == 3);
+
+    // Changing an included header is a miss
+    const char* includingSource = "#include \"header.h\"\n";
+    test.writeHeader("int a;");
+    test.compile(includingSource);
+    SLANG_CHECK(test.inner->m_compileCount == 4);
+    test.compile(includingSource);
+    SLANG_CHECK(test.inner->m_compileCount == 4);
+    test.writeHeader("int b;");
+    test.compile(includingSource);
+    SLANG_CHECK(test.inner->m_compileCount == 5);
+}
@@ -0,0 +1,113 @@
+// unit-test-field-index-reflection.cpp
+
+#include "../../source/core/slang-list.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Slang;
+
+// Test that `findFieldIndexByName` finds fields of both small structures, and of
+// structures large enough to be looked up through a name index, including when the
+// index is first used from several threads at once.
+
+SLANG_UNIT_TEST(fieldIndexReflection)
+{
+    const char* userSourceBody = R"(
+        struct Small
+        {
+            float a;
+            int b;
+        };
+
+        struct Large
+        {
+            float f0; float f1; float f2; float f3; float f4;
+            float f5; float f6; float f7; float f8; float f9;
+            Texture2D t10;
+            Small s11;
+        };
+
+        struct Shared
+        {
+            float f0; float f1; float f2; float f3; float f4;
+            float f5; float f6; float f7; float f8; float f9;
+        };
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK(module != nullptr);
+
+    auto layout = module->getLayout(0);
+    SLANG_CHECK(layout != nullptr);
+
+    auto smallLayout = layout->getTypeLayout(layout->findTypeByName("Small"));
+    SLANG_CHECK(smallLayout != nullptr);
+    SLANG_CHECK(smallLayout->findFieldIndexByName("a") == 0);
+    SLANG_CHECK(smallLayout->findFieldIndexByName("b") == 1);
+    SLANG_CHECK(smallLayout->findFieldIndexByName("c") == -1);
+
+    auto largeLayout = layout->getTypeLayout(layout->findTypeByName("Large"));
+    SLANG_CHECK(largeLayout != nullptr);
+    SLANG_CHECK(largeLayout->getFieldCount() == 12);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("f0") == 0);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("f7") == 7);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("t10") == 10);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("s11") == 11);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("f10") == -1);
+    SLANG_CHECK(largeLayout->findFieldIndexByName("") == -1);
+
+    // Lookups with an explicit end only consider the given part of the name.
+    const char* path = "f9.x";
+    SLANG_CHECK(largeLayout->findFieldIndexByName(path, path + 2) == 9);
+    SLANG_CHECK(largeLayout->findFieldIndexByName(path, path + 1) == -1);
+
+    // Repeated lookups use the already built index.
+    for (int i = 0; i < 10; ++i)
+    {
+        char name[3] = {'f', char('0' + i), 0};
+        SLANG_CHECK(largeLayout->findFieldIndexByName(name) == i);
+    }
+
+    // The first lookups of a structure's fields can happen on several threads at once.
+    auto sharedLayout = layout->getTypeLayout(layout->findTypeByName("Shared"));
+    SLANG_CHECK_ABORT(sharedLayout != nullptr);
+
+    std::atomic<bool> allFound{true};
+    List<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.add(std::thread(
+            [&]()
+            {
+                for (int i = 0; i < 1000; ++i)
+                {
+                    char name[3] = {'f', char('0' + i % 10), 0};
+                    if (sharedLayout->findFieldIndexByName(name) != i % 10)
+                        allFound = false;
+                }
+            }));
+    }
+    for (auto& thread : threads)
+        thread.join();
+    SLANG_CHECK(allFound);
+}
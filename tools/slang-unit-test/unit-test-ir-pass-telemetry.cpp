@@ -0,0 +1,125 @@
+// unit-test-ir-pass-telemetry.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Test that the telemetry of the IR passes is added to the results of a compilation when
+// it is requested with the `IRPassTelemetryArtifact` option.
+
+struct TelemetryFileFinder
+{
+    ISlangMutableFileSystem* fileSystem;
+    List<String> directories;
+    List<String> telemetryPaths;
+
+    void find(const String& directory)
+    {
+        m_directory = directory;
+        fileSystem->enumeratePathContents(directory.getBuffer(), &_onEntry, this);
+    }
+
+private:
+    static void _onEntry(SlangPathType pathType, const char* name, void* userData)
+    {
+        auto finder = (TelemetryFileFinder*)userData;
+        const String path = Path::combine(finder->m_directory, name);
+        if (pathType == SLANG_PATH_TYPE_DIRECTORY)
+            finder->directories.add(path);
+        else if (Path::getPathExt(path) == "slang-pass-telemetry")
+            finder->telemetryPaths.add(path);
+    }
+
+    String m_directory;
+};
+
+SLANG_UNIT_TEST(irPassTelemetry)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> output;
+
+        float square(float x) { return x * x; }
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid: SV_DispatchThreadID)
+        {
+            output[tid.x] = square(output[tid.x]);
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry entry;
+    entry.name = slang::CompilerOptionName::IRPassTelemetryArtifact;
+    entry.value.kind = slang::CompilerOptionValueKind::Int;
+    entry.value.intValue0 = 1;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &entry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+    ComPtr<ISlangMutableFileSystem> fileSystem;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getResultAsFileSystem(0, 0, fileSystem.writeRef())));
+
+    // Look for the telemetry anywhere in the results.
+    TelemetryFileFinder finder;
+    finder.fileSystem = fileSystem;
+    finder.find(".");
+    for (Index i = 0; i < finder.directories.getCount(); ++i)
+    {
+        finder.find(String(finder.directories[i]));
+    }
+    SLANG_CHECK_ABORT(finder.telemetryPaths.getCount() == 1);
+
+    ComPtr<ISlangBlob> telemetryBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(fileSystem->loadFile(
+        finder.telemetryPaths[0].getBuffer(),
+        telemetryBlob.writeRef())));
+    const auto telemetry = StringUtil::getSlice(telemetryBlob);
+
+    SLANG_CHECK(telemetry.indexOf(toSlice("\"target\": \"hlsl\"")) >= 0);
+    SLANG_CHECK(telemetry.indexOf(toSlice("\"entryPoints\": [\"computeMain\"]")) >= 0);
+
+    // The passes are in order. The first pass links the module, so it has no sizes before it,
+    // and every pass after it does.
+    const Index linked = telemetry.indexOf(toSlice("\"name\": \"LINKED\""));
+    const Index optimized = telemetry.indexOf(toSlice("\"name\": \"OPTIMIZED\""));
+    SLANG_CHECK_ABORT(linked >= 0);
+    SLANG_CHECK(optimized > linked);
+    const auto afterLinked = telemetry.tail(linked + 1);
+    const Index nextPass = afterLinked.indexOf(toSlice("\"name\": "));
+    SLANG_CHECK_ABORT(nextPass >= 0);
+    SLANG_CHECK(afterLinked.head(nextPass).indexOf(toSlice("\"before\"")) < 0);
+    SLANG_CHECK(afterLinked.tail(nextPass).indexOf(toSlice("\"before\"")) >= 0);
+    SLANG_CHECK(telemetry.indexOf(toSlice("\"instCount\": 0,")) < 0);
+}
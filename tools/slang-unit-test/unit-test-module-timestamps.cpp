@@ -0,0 +1,202 @@
+// unit-test-module-timestamps.cpp
+
+#include "../../source/core/slang-file-digest-cache.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string.h>
+
+using namespace Slang;
+
+// Test that precompiled modules are validated correctly using file stamps, that stamps are only
+// recorded when asked for, and that file digests persist in a digest cache.
+
+static ComPtr<slang::ISession> _createSession(
+    slang::IGlobalSession* globalSession,
+    const String& searchPath,
+    const String& digestCachePath,
+    bool validateTimestamps = true)
+{
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry entries[2];
+    entries[0].name = slang::CompilerOptionName::ValidateModuleTimestamps;
+    entries[0].value.kind = slang::CompilerOptionValueKind::Int;
+    entries[0].value.intValue0 = 1;
+    entries[1].name = slang::CompilerOptionName::ModuleDigestCache;
+    entries[1].value.kind = slang::CompilerOptionValueKind::String;
+    entries[1].value.stringValue0 = digestCachePath.getBuffer();
+
+    const char* searchPaths[] = {searchPath.getBuffer()};
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.searchPathCount = 1;
+    sessionDesc.searchPaths = searchPaths;
+    sessionDesc.compilerOptionEntryCount = validateTimestamps ? SLANG_COUNT_OF(entries) : 0;
+    sessionDesc.compilerOptionEntries = entries;
+
+    ComPtr<slang::ISession> session;
+    globalSession->createSession(sessionDesc, session.writeRef());
+    return session;
+}
+
+SLANG_UNIT_TEST(moduleTimestampValidation)
+{
+    String tempDir;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::getTemporaryDirectory(tempDir)));
+    StringBuilder dirName;
+    dirName << "slang-module-timestamps-" << Process::getId();
+    const String dir = Path::combine(tempDir, dirName);
+    Path::createDirectory(dir);
+
+    const String sourcePath = Path::combine(dir, "stamped_module.slang");
+    const String modulePath = Path::combine(dir, "stamped_module.slang-module");
+    const String digestCachePath = Path::combine(dir, "digests.txt");
+
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        File::writeAllText(sourcePath, "module stamped_module; public int f() { return 1; }")));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> moduleBlob;
+    {
+        auto session = _createSession(globalSession, dir, digestCachePath);
+        SLANG_CHECK_ABORT(session != nullptr);
+        ComPtr<slang::IBlob> diagnostics;
+        auto module = session->loadModule("stamped_module", diagnostics.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(moduleBlob.writeRef())));
+        SLANG_CHECK(session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob));
+    }
+
+    // A fresh session sees the unchanged source as up to date.
+    {
+        auto session = _createSession(globalSession, dir, digestCachePath);
+        SLANG_CHECK(session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob));
+    }
+
+    // Any change to the source, including its size, must be detected.
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        File::writeAllText(sourcePath, "module stamped_module; public int f() { return 22; }")));
+    {
+        auto session = _createSession(globalSession, dir, digestCachePath);
+        SLANG_CHECK(!session->isBinaryModuleUpToDate(modulePath.getBuffer(), moduleBlob));
+    }
+
+    File::remove(sourcePath);
+    File::remove(digestCachePath);
+    Path::remove(dir);
+}
+
+SLANG_UNIT_TEST(moduleTimestampsRecordedOnRequest)
+{
+    String tempDir;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::getTemporaryDirectory(tempDir)));
+    StringBuilder dirName;
+    dirName << "slang-module-timestamps-request-" << Process::getId();
+    const String dir = Path::combine(tempDir, dirName);
+    Path::createDirectory(dir);
+
+    const String sourcePath = Path::combine(dir, "request_module.slang");
+    const String digestCachePath = Path::combine(dir, "digests.txt");
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        File::writeAllText(sourcePath, "module request_module; public int f() { return 1; }")));
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    // Serialize the module with the source last modified `hoursAgo`, long enough ago for its
+    // stamp to be trusted.
+    auto serialize = [&](int hoursAgo, bool validateTimestamps)
+    {
+        std::error_code error;
+        std::filesystem::last_write_time(
+            std::filesystem::u8path(sourcePath.getBuffer()),
+            std::filesystem::file_time_type::clock::now() - std::chrono::hours(hoursAgo),
+            error);
+        SLANG_CHECK(!error);
+
+        auto session = _createSession(globalSession, dir, digestCachePath, validateTimestamps);
+        SLANG_CHECK_ABORT(session != nullptr);
+        ComPtr<slang::IBlob> diagnostics;
+        auto module = session->loadModule("request_module", diagnostics.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+        ComPtr<slang::IBlob> blob;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(module->serialize(blob.writeRef())));
+        return blob;
+    };
+
+    auto isSame = [](slang::IBlob* a, slang::IBlob* b)
+    {
+        return a->getBufferSize() == b->getBufferSize() &&
+               memcmp(a->getBufferPointer(), b->getBufferPointer(), a->getBufferSize()) == 0;
+    };
+
+    // Without timestamp validation the output doesn't depend on the state of the file
+    SLANG_CHECK(isSame(serialize(1, false), serialize(2, false)));
+
+    // With it, the stamp taken when the file was read is recorded
+    SLANG_CHECK(!isSame(serialize(1, true), serialize(2, true)));
+
+    File::remove(sourcePath);
+    File::remove(digestCachePath);
+    Path::remove(dir);
+}
+
+SLANG_UNIT_TEST(fileDigestCache)
+{
+    String tempDir;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::getTemporaryDirectory(tempDir)));
+    StringBuilder fileName;
+    fileName << "slang-file-digest-cache-" << Process::getId() << ".txt";
+    const String cachePath = Path::combine(tempDir, fileName);
+
+    // A stamp old enough to be trusted.
+    FileStamp stamp;
+    stamp.size = 123;
+    stamp.modifiedTime = uint64_t(1000000000) * 1000000000;
+    stamp.fileId = 42;
+    const SHA1::Digest digest = SHA1::compute("contents", 8);
+    const String path = "/some dir/file.slang";
+
+    {
+        RefPtr<FileDigestCache> cache = new FileDigestCache(cachePath);
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->load()));
+        cache->setDigest(path, stamp, digest);
+
+        // Stamps of recently modified files are not recorded.
+        FileStamp recentStamp = stamp;
+        recentStamp.modifiedTime = uint64_t(4000000000) * 1000000000;
+        cache->setDigest("recent.slang", recentStamp, digest);
+
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->save()));
+    }
+
+    {
+        RefPtr<FileDigestCache> cache = new FileDigestCache(cachePath);
+        SLANG_CHECK(SLANG_SUCCEEDED(cache->load()));
+
+        SHA1::Digest foundDigest;
+        SLANG_CHECK(cache->tryGetDigest(path, stamp, foundDigest));
+        SLANG_CHECK(foundDigest == digest);
+
+        FileStamp changedStamp = stamp;
+        changedStamp.size++;
+        SLANG_CHECK(!cache->tryGetDigest(path, changedStamp, foundDigest));
+        SLANG_CHECK(!cache->tryGetDigest("other.slang", stamp, foundDigest));
+        SLANG_CHECK(!cache->tryGetDigest("recent.slang", stamp, foundDigest));
+    }
+
+    File::remove(cachePath);
+}
@@ -0,0 +1,88 @@
+// unit-test-name-pool.cpp
+
+#include "../../source/compiler-core/slang-name.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <thread>
+
+using namespace Slang;
+
+SLANG_UNIT_TEST(namePool)
+{
+    RootNamePool rootPool;
+    NamePool namePool;
+    namePool.setRootNamePool(&rootPool);
+
+    // Interning is by content, not by pointer
+    {
+        const char text[] = "hello world";
+        Name* hello = namePool.getName(UnownedStringSlice(text, 5));
+        SLANG_CHECK(hello);
+        SLANG_CHECK(hello->text == "hello");
+        SLANG_CHECK(namePool.getName(String("hello")) == hello);
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("hello")) == hello);
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("world")) == nullptr);
+        SLANG_CHECK(rootPool.getCount() == 1);
+    }
+
+    // Enough names to force the table to grow several times
+    List<Name*> names;
+    for (Index i = 0; i < 5000; ++i)
+    {
+        names.add(namePool.getName(String("name") + String(i)));
+    }
+    for (Index i = 0; i < names.getCount(); ++i)
+    {
+        SLANG_CHECK(namePool.getName(String("name") + String(i)) == names[i]);
+    }
+    SLANG_CHECK(rootPool.getCount() == 5001);
+
+    // Pre-seeding finds existing names and adds new ones
+    {
+        UnownedStringSlice texts[] = {
+            UnownedStringSlice("name0"),
+            UnownedStringSlice("seeded"),
+            UnownedStringSlice("seeded")};
+        rootPool.addNames(makeConstArrayView(texts, SLANG_COUNT_OF(texts)));
+        SLANG_CHECK(rootPool.getCount() == 5002);
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("name0")) == names[0]);
+        SLANG_CHECK(namePool.tryGetName(UnownedStringSlice("seeded")) != nullptr);
+    }
+
+    // Concurrent interning of overlapping sets must agree on a single `Name` per text
+    {
+        const Index kThreadCount = 4;
+        const Index kNameCount = 2000;
+
+        List<List<Name*>> results;
+        results.setCount(kThreadCount);
+
+        List<std::thread> threads;
+        for (Index t = 0; t < kThreadCount; ++t)
+        {
+            threads.add(std::thread(
+                [&, t]()
+                {
+                    NamePool threadPool;
+                    threadPool.setRootNamePool(&rootPool);
+                    for (Index i = 0; i < kNameCount; ++i)
+                    {
+                        results[t].add(threadPool.getName(String("shared") + String(i)));
+                    }
+                }));
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (Index t = 1; t < kThreadCount; ++t)
+        {
+            for (Index i = 0; i < kNameCount; ++i)
+            {
+                SLANG_CHECK(results[t][i] == results[0][i]);
+            }
+        }
+        SLANG_CHECK(rootPool.getCount() == 5002 + kNameCount);
+    }
+}
@@ -0,0 +1,303 @@
+// unit-test-precompiled-prelude.cpp
+
+#include "../../source/compiler-core/slang-artifact-desc-util.h"
+#include "../../source/compiler-core/slang-artifact-util.h"
+#include "../../source/compiler-core/slang-gcc-compiler-util.h"
+#include "../../source/compiler-core/slang-slice-allocator.h"
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-process.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#if !SLANG_WINDOWS_FAMILY
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Slang;
+
+// Test that the precompiled header for a prelude is built once and reused, that a different
+// prelude gets its own, and that `-disable-precompiled-prelude` turns the feature off. Also test
+// that precompiled headers are only kept in a directory that other users can't write to.
+
+namespace
+{ // anonymous
+
+struct PrecompiledHeaderFinder : Path::Visitor
+{
+    void accept(Path::Type type, const UnownedStringSlice& fileName) SLANG_OVERRIDE
+    {
+        if (type == Path::Type::File && fileName.startsWith(toSlice("slang-pch-")))
+        {
+            if (fileName.endsWith(toSlice(".h.gch")))
+                pchFileNames.add(fileName);
+            else if (fileName.endsWith(toSlice(".h")))
+                headerFileNames.add(fileName);
+        }
+    }
+
+    List<String> pchFileNames;
+    List<String> headerFileNames;
+};
+
+struct PrecompiledPreludeTest
+{
+    PrecompiledPreludeTest()
+    {
+        directory = Path::simplify(
+            Path::getParentDirectory(Path::getExecutablePath()) + "/precompiled-prelude-test" +
+            String(Process::getId()));
+        removeFiles();
+        Path::createDirectory(directory);
+    }
+
+    ~PrecompiledPreludeTest() { removeFiles(); }
+
+    void removeFiles()
+    {
+        PrecompiledHeaderFinder finder;
+        Path::find(directory, nullptr, &finder);
+        for (const auto& fileName : finder.pchFileNames)
+            File::remove(Path::combine(directory, fileName));
+        for (const auto& fileName : finder.headerFileNames)
+            File::remove(Path::combine(directory, fileName));
+        Path::remove(directory);
+    }
+
+    /// Compile `prelude` followed by a function to object code.
+    SlangResult compile(const char* prelude, bool usePrecompiledHeader)
+    {
+        StringBuilder source;
+        source << prelude << "int getValue() { return VALUE; }\n";
+
+        auto sourceArtifact = ArtifactUtil::createArtifact(
+            ArtifactDescUtil::makeDescForCompileTarget(SLANG_CPP_SOURCE));
+        sourceArtifact->setName("source.cpp");
+        sourceArtifact->addRepresentationUnknown(StringBlob::moveCreate(source));
+
+        DownstreamCompileOptions options;
+        options.targetType = SLANG_OBJECT_CODE;
+        options.sourceLanguage = SLANG_SOURCE_LANGUAGE_CPP;
+        options.sourceArtifacts = makeSlice(sourceArtifact.readRef(), 1);
+        if (usePrecompiledHeader)
+        {
+            options.precompiledHeaderText = TerminatedCharSlice(prelude);
+            options.precompiledHeaderDirectory =
+                TerminatedCharSlice(directory.getBuffer(), directory.getLength());
+        }
+
+        ComPtr<IArtifact> artifact;
+        SLANG_RETURN_ON_FAIL(compiler->compile(options, artifact.writeRef()));
+        return ArtifactUtil::isSignificant(artifact) ? SLANG_OK : SLANG_FAIL;
+    }
+
+    PrecompiledHeaderFinder find()
+    {
+        PrecompiledHeaderFinder finder;
+        Path::find(directory, nullptr, &finder);
+        return finder;
+    }
+
+    FileStamp getStamp(const String& fileName)
+    {
+        FileStamp stamp;
+        File::getStamp(Path::combine(directory, fileName), stamp);
+        return stamp;
+    }
+
+    String directory;
+    ComPtr<IDownstreamCompiler> compiler;
+};
+
+} // namespace
+
+SLANG_UNIT_TEST(precompiledPrelude)
+{
+    PrecompiledPreludeTest test;
+    if (SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(
+            ExecutableLocation(String(), "g++"),
+            test.compiler)) &&
+        SLANG_FAILED(GCCDownstreamCompilerUtil::createCompiler(
+            ExecutableLocation(String(), "clang++"),
+            test.compiler)))
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    const char* prelude = "#define VALUE 1\n";
+
+    // The first compile builds the precompiled header
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile(prelude, true)));
+    auto finder = test.find();
+    SLANG_CHECK_ABORT(finder.pchFileNames.getCount() == 1);
+    SLANG_CHECK(finder.headerFileNames.getCount() == 1);
+    const String pchFileName = finder.pchFileNames[0];
+    const FileStamp firstStamp = test.getStamp(pchFileName);
+
+    // The second reuses it, rather than building it again
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile(prelude, true)));
+    finder = test.find();
+    SLANG_CHECK(finder.pchFileNames.getCount() == 1);
+    SLANG_CHECK(finder.pchFileNames.indexOf(pchFileName) == 0);
+    const FileStamp secondStamp = test.getStamp(pchFileName);
+    SLANG_CHECK(secondStamp.size == firstStamp.size);
+    SLANG_CHECK(secondStamp.fileId == firstStamp.fileId);
+
+    // A changed prelude gets a precompiled header of its own
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile("#define VALUE 2\n", true)));
+    finder = test.find();
+    SLANG_CHECK(finder.pchFileNames.getCount() == 2);
+    SLANG_CHECK(finder.pchFileNames.indexOf(pchFileName) >= 0);
+
+    // Nothing is built without the precompiled header options
+    SLANG_CHECK(SLANG_SUCCEEDED(test.compile("#define VALUE 3\n", false)));
+    SLANG_CHECK(test.find().pchFileNames.getCount() == 2);
+}
+
+SLANG_UNIT_TEST(disablePrecompiledPrelude)
+{
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    if (SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_GCC)) &&
+        SLANG_FAILED(globalSession->checkPassThroughSupport(SLANG_PASS_THROUGH_CLANG)))
+    {
+        SLANG_IGNORE_TEST;
+    }
+
+    String userCacheDirectory;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(File::getUserCacheDirectory(userCacheDirectory)));
+    const String pchDirectory = Path::combine(Path::combine(userCacheDirectory, "slang"), "pch");
+
+    // Mark the prelude, so the precompiled headers built for it can be found.
+    StringBuilder marker;
+    marker << "// disablePrecompiledPrelude " << Process::getId() << "\n";
+
+    ComPtr<ISlangBlob> defaultPrelude;
+    globalSession->getLanguagePrelude(SLANG_SOURCE_LANGUAGE_CPP, defaultPrelude.writeRef());
+    StringBuilder prelude;
+    prelude << marker;
+    if (defaultPrelude)
+        prelude << StringUtil::getSlice(defaultPrelude);
+    globalSession->setLanguagePrelude(SLANG_SOURCE_LANGUAGE_CPP, prelude.getBuffer());
+
+    auto findMarkedHeaders = [&]()
+    {
+        PrecompiledHeaderFinder finder;
+        Path::find(pchDirectory, nullptr, &finder);
+        List<String> paths;
+        for (const auto& fileName : finder.headerFileNames)
+        {
+            const String path = Path::combine(pchDirectory, fileName);
+            String contents;
+            if (SLANG_SUCCEEDED(File::readAllText(path, contents)) &&
+                contents.startsWith(marker.getUnownedSlice()))
+            {
+                paths.add(path);
+            }
+        }
+        return paths;
+    };
+
+    auto compile = [&](bool disable)
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_OBJECT_CODE;
+
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::DisablePrecompiledPrelude;
+        entry.value.kind = slang::CompilerOptionValueKind::Int;
+        entry.value.intValue0 = 1;
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.compilerOptionEntryCount = disable ? 1 : 0;
+        sessionDesc.compilerOptionEntries = &entry;
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "m",
+            "m.slang",
+            R"(
+            RWStructuredBuffer<float> output;
+            [shader("compute")]
+            [numthreads(4, 1, 1)]
+            void computeMain(uint3 tid: SV_DispatchThreadID)
+            {
+                output[tid.x] = output[tid.x] * 2.0;
+            }
+            )",
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint};
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+        ComPtr<slang::IBlob> code;
+        SLANG_CHECK(SLANG_SUCCEEDED(
+            program->getEntryPointCode(0, 0, code.writeRef(), diagnosticBlob.writeRef())));
+    };
+
+    // Disabled, no precompiled header is built for the prelude
+    compile(true);
+    SLANG_CHECK(findMarkedHeaders().getCount() == 0);
+
+    // Enabled, one is
+    compile(false);
+    auto paths = findMarkedHeaders();
+    SLANG_CHECK(paths.getCount() == 1);
+
+    for (const auto& path : paths)
+    {
+        File::remove(path + ".gch");
+        File::remove(path);
+    }
+}
+
+SLANG_UNIT_TEST(precompiledPreludeDirectory)
+{
+#if SLANG_WINDOWS_FAMILY
+    SLANG_IGNORE_TEST;
+#else
+    const String directory = Path::simplify(
+        Path::getParentDirectory(Path::getExecutablePath()) + "/precompiled-prelude-directory" +
+        String(Process::getId()));
+    Path::remove(directory);
+
+    // A new directory is created so only the current user can access it
+    SLANG_CHECK(SLANG_SUCCEEDED(Path::createPrivateDirectory(directory)));
+    struct stat directoryStat;
+    SLANG_CHECK_ABORT(::stat(directory.getBuffer(), &directoryStat) == 0);
+    SLANG_CHECK((directoryStat.st_mode & 0777) == 0700);
+
+    // An existing directory is accepted as it is
+    SLANG_CHECK(SLANG_SUCCEEDED(Path::createPrivateDirectory(directory)));
+
+    // A directory other users can write to is rejected
+    ::chmod(directory.getBuffer(), 0777);
+    SLANG_CHECK(SLANG_FAILED(Path::createPrivateDirectory(directory)));
+
+    // So is a symbolic link to a directory
+    ::chmod(directory.getBuffer(), 0700);
+    const String linkPath = directory + "-link";
+    File::remove(linkPath);
+    SLANG_CHECK_ABORT(::symlink(directory.getBuffer(), linkPath.getBuffer()) == 0);
+    SLANG_CHECK(SLANG_FAILED(Path::createPrivateDirectory(linkPath)));
+
+    File::remove(linkPath);
+    Path::remove(directory);
+#endif
+}
@@ -0,0 +1,295 @@
+// unit-test-reflection-snapshot.cpp
+
+#include "../../source/core/slang-io.h"
+#include "../../source/core/slang-list.h"
+#include "slang-com-ptr.h"
+#include "slang-reflection-snapshot.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+using namespace slang::reflection_snapshot;
+
+// Test that a reflection snapshot holds the same information as the reflection API,
+// and that the reader rejects data that isn't a valid snapshot.
+
+SLANG_UNIT_TEST(reflectionSnapshot)
+{
+    const char* userSourceBody = R"(
+        struct Material
+        {
+            float4 color;
+            float roughness;
+        };
+
+        ConstantBuffer<Material> material;
+        Texture2D textures[4];
+        RWStructuredBuffer<float> output;
+
+        [shader("compute")]
+        [numthreads(8, 4, 1)]
+        void computeMain(uint3 tid: SV_DispatchThreadID)
+        {
+            output[tid.x] = material.roughness + textures[tid.y].Load(int3(0)).x;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        userSourceBody,
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+    auto layout = program->getLayout(0);
+    SLANG_CHECK_ABORT(layout != nullptr);
+
+    ComPtr<ISlangBlob> snapshot;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(layout->toSnapshot(snapshot.writeRef())));
+
+    Reader reader;
+    SLANG_CHECK_ABORT(reader.init(snapshot->getBufferPointer(), snapshot->getBufferSize()));
+
+    // Global parameters, and their bindings.
+    SLANG_CHECK(reader.getParameterCount() == layout->getParameterCount());
+    for (uint32_t i = 0; i < reader.getParameterCount(); ++i)
+    {
+        auto param = layout->getParameterByIndex(i);
+        auto record = reader.getParameter(i);
+        SLANG_CHECK_ABORT(record != nullptr);
+        SLANG_CHECK(strcmp(reader.getString(record->name), param->getName()) == 0);
+        SLANG_CHECK(record->bindingCount == param->getCategoryCount());
+
+        for (uint32_t j = 0; j < record->bindingCount; ++j)
+        {
+            auto binding = reader.getBinding(record->firstBinding + j);
+            SLANG_CHECK_ABORT(binding != nullptr);
+            auto category = SlangParameterCategory(param->getCategoryByIndex(j));
+            SLANG_CHECK(binding->category == uint32_t(category));
+            SLANG_CHECK(binding->index == param->getOffset(category));
+            SLANG_CHECK(binding->space == param->getBindingSpace(category));
+        }
+    }
+
+    // Types, including the elements of arrays and the fields of structures.
+    auto textures = reader.findParameter("textures");
+    SLANG_CHECK_ABORT(textures != nullptr);
+    auto texturesType = reader.getType(textures->type);
+    SLANG_CHECK_ABORT(texturesType != nullptr);
+    SLANG_CHECK(texturesType->kind == SLANG_TYPE_KIND_ARRAY);
+    SLANG_CHECK(texturesType->elementCount == 4);
+    auto textureType = reader.getType(texturesType->elementType);
+    SLANG_CHECK_ABORT(textureType != nullptr);
+    SLANG_CHECK(textureType->kind == SLANG_TYPE_KIND_RESOURCE);
+    SLANG_CHECK(textureType->resourceShape == SLANG_TEXTURE_2D);
+
+    auto material = reader.findParameter("material");
+    SLANG_CHECK_ABORT(material != nullptr);
+    auto materialBufferType = reader.getType(material->type);
+    SLANG_CHECK_ABORT(materialBufferType != nullptr);
+    SLANG_CHECK(materialBufferType->kind == SLANG_TYPE_KIND_CONSTANT_BUFFER);
+    auto materialType = reader.getType(materialBufferType->elementType);
+    SLANG_CHECK_ABORT(materialType != nullptr);
+    SLANG_CHECK(strcmp(reader.getString(materialType->name), "Material") == 0);
+    SLANG_CHECK(materialType->fieldCount == 2);
+    auto roughness = reader.getField(materialType->firstField + 1);
+    SLANG_CHECK_ABORT(roughness != nullptr);
+    SLANG_CHECK(strcmp(reader.getString(roughness->name), "roughness") == 0);
+    auto roughnessBinding = reader.getBinding(roughness->firstBinding);
+    SLANG_CHECK_ABORT(roughnessBinding != nullptr);
+    SLANG_CHECK(roughnessBinding->category == SLANG_PARAMETER_CATEGORY_UNIFORM);
+    SLANG_CHECK(roughnessBinding->index == 16);
+
+    // Entry points.
+    SLANG_CHECK(reader.getEntryPointCount() == 1);
+    auto computeMain = reader.findEntryPoint("computeMain");
+    SLANG_CHECK_ABORT(computeMain != nullptr);
+    SLANG_CHECK(computeMain->stage == SLANG_STAGE_COMPUTE);
+    SLANG_CHECK(computeMain->threadGroupSize[0] == 8);
+    SLANG_CHECK(computeMain->threadGroupSize[1] == 4);
+    SLANG_CHECK(computeMain->threadGroupSize[2] == 1);
+    SLANG_CHECK(computeMain->parameterCount == 1);
+    SLANG_CHECK(reader.findEntryPoint("missing") == nullptr);
+
+    // Out of range accesses fail without reading outside of the snapshot.
+    SLANG_CHECK(reader.getType(reader.getTypeCount()) == nullptr);
+    SLANG_CHECK(reader.getParameter(reader.getParameterCount()) == nullptr);
+    SLANG_CHECK(strcmp(reader.getString(kNone), "") == 0);
+
+    // Truncated or corrupted data is rejected.
+    const size_t size = snapshot->getBufferSize();
+    List<uint32_t> copy;
+    copy.setCount(Index((size + 3) / 4));
+    memcpy(copy.getBuffer(), snapshot->getBufferPointer(), size);
+
+    Reader otherReader;
+    SLANG_CHECK(otherReader.init(copy.getBuffer(), size));
+    SLANG_CHECK(!otherReader.init(copy.getBuffer(), size - 4));
+    SLANG_CHECK(!otherReader.init(copy.getBuffer(), sizeof(Header) - 1));
+    SLANG_CHECK(!otherReader.init((const char*)copy.getBuffer() + 1, size - 1));
+    SLANG_CHECK(!otherReader.isValid());
+
+    Header* header = (Header*)copy.getBuffer();
+    header->sections[uint32_t(SectionKind::Types)].count += 1000;
+    SLANG_CHECK(!otherReader.init(copy.getBuffer(), size));
+    header->sections[uint32_t(SectionKind::Types)].count -= 1000;
+
+    header->version++;
+    SLANG_CHECK(!otherReader.init(copy.getBuffer(), size));
+    header->version--;
+
+    // As is a snapshot written with the other byte order.
+    header->magic = (kMagic >> 24) | ((kMagic >> 8) & 0xff00) | ((kMagic << 8) & 0xff0000) |
+                    (kMagic << 24);
+    SLANG_CHECK(!otherReader.init(copy.getBuffer(), size));
+}
+
+namespace
+{ // anonymous
+
+struct SnapshotFileFinder
+{
+    ISlangMutableFileSystem* fileSystem;
+    List<String> directories;
+    List<String> snapshotPaths;
+
+    void find(const String& directory)
+    {
+        m_directory = directory;
+        fileSystem->enumeratePathContents(directory.getBuffer(), &_onEntry, this);
+    }
+
+private:
+    static void _onEntry(SlangPathType pathType, const char* name, void* userData)
+    {
+        auto finder = (SnapshotFileFinder*)userData;
+        const String path = Path::combine(finder->m_directory, name);
+        if (pathType == SLANG_PATH_TYPE_DIRECTORY)
+            finder->directories.add(path);
+        else if (Path::getPathExt(path) == "slang-reflection")
+            finder->snapshotPaths.add(path);
+    }
+
+    String m_directory;
+};
+
+} // namespace
+
+// Test that the snapshot is added to the results of a compilation only when it is requested.
+
+SLANG_UNIT_TEST(reflectionSnapshotArtifact)
+{
+    const char* userSourceBody = R"(
+        RWStructuredBuffer<float> output;
+
+        [shader("compute")]
+        [numthreads(4, 1, 1)]
+        void computeMain(uint3 tid: SV_DispatchThreadID)
+        {
+            output[tid.x] = 1.0;
+        }
+        )";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK(slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    auto getResultFileSystem = [&](bool addSnapshot)
+    {
+        slang::TargetDesc targetDesc = {};
+        targetDesc.format = SLANG_HLSL;
+        targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+        slang::CompilerOptionEntry entry;
+        entry.name = slang::CompilerOptionName::ReflectionSnapshotArtifact;
+        entry.value.kind = slang::CompilerOptionValueKind::Int;
+        entry.value.intValue0 = 1;
+
+        slang::SessionDesc sessionDesc = {};
+        sessionDesc.targetCount = 1;
+        sessionDesc.targets = &targetDesc;
+        sessionDesc.compilerOptionEntryCount = addSnapshot ? 1 : 0;
+        sessionDesc.compilerOptionEntries = &entry;
+        ComPtr<slang::ISession> session;
+        SLANG_CHECK_ABORT(
+            globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+        ComPtr<slang::IBlob> diagnosticBlob;
+        auto module = session->loadModuleFromSourceString(
+            "m",
+            "m.slang",
+            userSourceBody,
+            diagnosticBlob.writeRef());
+        SLANG_CHECK_ABORT(module != nullptr);
+
+        ComPtr<slang::IEntryPoint> entryPoint;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+        slang::IComponentType* components[] = {module, entryPoint};
+        ComPtr<slang::IComponentType> program;
+        SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+            session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+        ComPtr<ISlangMutableFileSystem> fileSystem;
+        SLANG_CHECK_ABORT(
+            SLANG_SUCCEEDED(program->getResultAsFileSystem(0, 0, fileSystem.writeRef())));
+        return fileSystem;
+    };
+
+    auto findSnapshots = [](ISlangMutableFileSystem* fileSystem)
+    {
+        SnapshotFileFinder finder;
+        finder.fileSystem = fileSystem;
+        finder.find(".");
+        for (Index i = 0; i < finder.directories.getCount(); ++i)
+        {
+            finder.find(String(finder.directories[i]));
+        }
+        return finder.snapshotPaths;
+    };
+
+    // Not requested, so not added
+    SLANG_CHECK(findSnapshots(getResultFileSystem(false)).getCount() == 0);
+
+    auto fileSystem = getResultFileSystem(true);
+    auto snapshotPaths = findSnapshots(fileSystem);
+    SLANG_CHECK_ABORT(snapshotPaths.getCount() == 1);
+
+    ComPtr<ISlangBlob> snapshotBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        fileSystem->loadFile(snapshotPaths[0].getBuffer(), snapshotBlob.writeRef())));
+
+    // Copy, so the snapshot is aligned for the reader.
+    const size_t size = snapshotBlob->getBufferSize();
+    List<uint32_t> snapshot;
+    snapshot.setCount(Index((size + 3) / 4));
+    memcpy(snapshot.getBuffer(), snapshotBlob->getBufferPointer(), size);
+
+    Reader reader;
+    SLANG_CHECK_ABORT(reader.init(snapshot.getBuffer(), size));
+    SLANG_CHECK(reader.findEntryPoint("computeMain") != nullptr);
+    SLANG_CHECK(reader.findParameter("output") != nullptr);
+}
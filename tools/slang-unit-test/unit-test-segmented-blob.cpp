@@ -0,0 +1,115 @@
+// unit-test-segmented-blob.cpp
+
+#include "../../source/core/slang-blob.h"
+#include "../../source/core/slang-castable.h"
+#include "../../source/core/slang-string-util.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <string.h>
+
+using namespace Slang;
+
+// Test that a segmented blob can be consumed a segment at a time, and holds the same
+// contents as a single buffer when joined.
+
+SLANG_UNIT_TEST(segmentedBlob)
+{
+    {
+        List<String> segments;
+        segments.add("#include <stdio.h>\n");
+        segments.add("");
+        segments.add("int main() { return 0; }\n");
+
+        ComPtr<ISlangBlob> blob = SegmentedBlob::moveCreate(segments);
+        SLANG_CHECK(segments.getCount() == 0);
+
+        const UnownedStringSlice expected =
+            toSlice("#include <stdio.h>\nint main() { return 0; }\n");
+        SLANG_CHECK(blob->getBufferSize() == size_t(expected.getLength()));
+
+        auto segmentedBlob = as<SegmentedBlob>(CastableUtil::getCastable(blob));
+        SLANG_CHECK_ABORT(segmentedBlob);
+
+        // The empty segment is dropped
+        List<String> visited;
+        SLANG_CHECK(SLANG_SUCCEEDED(segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice& segment)
+            {
+                visited.add(segment);
+                return SLANG_OK;
+            })));
+        SLANG_CHECK(visited.getCount() == 2);
+        SLANG_CHECK(visited[1] == "int main() { return 0; }\n");
+
+        // Failure stops the visit
+        Index visitCount = 0;
+        SLANG_CHECK(SLANG_FAILED(segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice&)
+            {
+                visitCount++;
+                return SLANG_FAIL;
+            })));
+        SLANG_CHECK(visitCount == 1);
+
+        // Accessing the buffer joins the segments
+        const char* buffer = (const char*)blob->getBufferPointer();
+        SLANG_CHECK(UnownedStringSlice(buffer, blob->getBufferSize()) == expected);
+        SLANG_CHECK(buffer[blob->getBufferSize()] == 0);
+        SLANG_CHECK(blob->getBufferPointer() == buffer);
+
+        visited.clear();
+        segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice& segment)
+            {
+                visited.add(segment);
+                return SLANG_OK;
+            });
+        SLANG_CHECK(visited.getCount() == 1);
+        SLANG_CHECK(visited[0] == expected);
+    }
+
+    {
+        List<String> segments;
+        segments.add("#define A 1\n");
+        segments.add("#define B 2\n");
+        segments.add("int main() { return A + B; }\n");
+        ComPtr<ISlangBlob> blob = SegmentedBlob::moveCreate(segments);
+        auto segmentedBlob = as<SegmentedBlob>(CastableUtil::getCastable(blob));
+        SLANG_CHECK_ABORT(segmentedBlob);
+
+        // A prefix can span segments
+        SLANG_CHECK(segmentedBlob->startsWith(toSlice("")));
+        SLANG_CHECK(segmentedBlob->startsWith(toSlice("#define A 1\n#define B")));
+        SLANG_CHECK(!segmentedBlob->startsWith(toSlice("#define A 1\n#define C")));
+        SLANG_CHECK(!segmentedBlob->startsWith(
+            toSlice("#define A 1\n#define B 2\nint main() { return A + B; }\n\n")));
+
+        // The tail can start within a segment, or at the start of one
+        ComPtr<ISlangBlob> tail = segmentedBlob->createTail(toSlice("#line 2\n"), 15);
+        SLANG_CHECK(
+            StringUtil::getSlice(tail) ==
+            toSlice("#line 2\nfine B 2\nint main() { return A + B; }\n"));
+
+        tail = segmentedBlob->createTail(toSlice("#line 3\n"), 24);
+        SLANG_CHECK(
+            StringUtil::getSlice(tail) == toSlice("#line 3\nint main() { return A + B; }\n"));
+
+        // Creating a tail doesn't join the segments
+        Index segmentCount = 0;
+        segmentedBlob->forEachSegment(
+            [&](const UnownedStringSlice&)
+            {
+                segmentCount++;
+                return SLANG_OK;
+            });
+        SLANG_CHECK(segmentCount == 3);
+    }
+
+    {
+        // An empty blob is still terminated
+        List<String> segments;
+        ComPtr<ISlangBlob> blob = SegmentedBlob::moveCreate(segments);
+        SLANG_CHECK(blob->getBufferSize() == 0);
+        SLANG_CHECK(strcmp((const char*)blob->getBufferPointer(), "") == 0);
+    }
+}
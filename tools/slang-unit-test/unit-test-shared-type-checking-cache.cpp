@@ -0,0 +1,96 @@
+// unit-test-shared-type-checking-cache.cpp
+
+#include "../../source/core/slang-string.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
+#include "unit-test/slang-unit-test.h"
+
+using namespace Slang;
+
+// Check `source` in a new compile request (and so a new linkage) of `session`, and return the
+// total number of shared type checking cache hits reported by the session so far, or -1 if the
+// count could not be found.
+static int _checkAndGetSharedCacheHitCount(SlangSession* session, const char* source)
+{
+    auto request = spCreateCompileRequest(session);
+
+    const char* args[] = {"-report-perf-benchmark"};
+    spProcessCommandLineArguments(request, args, SLANG_COUNT_OF(args));
+
+    int translationUnitIndex = spAddTranslationUnit(request, SLANG_SOURCE_LANGUAGE_SLANG, nullptr);
+    spAddTranslationUnitSourceString(request, translationUnitIndex, "source.slang", source);
+
+    int hitCount = -1;
+    if (SLANG_SUCCEEDED(spCompile(request)))
+    {
+        const String diagnostics = spGetDiagnosticOutput(request);
+        const char prefix[] = "Shared Type Checking Cache: ";
+        const Index index = diagnostics.indexOf(prefix);
+        if (index >= 0)
+        {
+            hitCount = stringToInt(diagnostics.subString(
+                index + SLANG_COUNT_OF(prefix) - 1,
+                diagnostics.getLength()));
+        }
+    }
+
+    spDestroyCompileRequest(request);
+    return hitCount;
+}
+
+// Test that core module type checking results are shared between linkages of a session, and
+// that a module that could change those results does not use them.
+SLANG_UNIT_TEST(sharedTypeCheckingCache)
+{
+    const char* source = R"(
+        float f(int a, float b, uint c)
+        {
+            return a * b + c - 1;
+        }
+        )";
+
+    // Extending a core module type can change how its conversions and witnesses resolve.
+    const char* extensionSource = R"(
+        extension float
+        {
+            float twice() { return this * 2; }
+        }
+        float f(int a, float b, uint c)
+        {
+            return a * b + c - 1;
+        }
+        )";
+
+    // An operator overload in a namespace is still a candidate for core module operators.
+    const char* namespaceOperatorSource = R"(
+        namespace ops
+        {
+            struct V { int x; }
+            V operator+(V a, V b) { V r; r.x = a.x + b.x; return r; }
+        }
+        float f(int a, float b, uint c)
+        {
+            return a * b + c - 1;
+        }
+        )";
+
+    auto session = spCreateSession();
+
+    // The first linkage fills in any results the core module did not already share.
+    const int firstHitCount = _checkAndGetSharedCacheHitCount(session, source);
+    SLANG_CHECK(firstHitCount >= 0);
+
+    // A second linkage checking the same code should find them.
+    const int secondHitCount = _checkAndGetSharedCacheHitCount(session, source);
+    SLANG_CHECK(secondHitCount > firstHitCount);
+
+    // Linkages whose modules could change core module results must bypass the cache.
+    const int extensionHitCount = _checkAndGetSharedCacheHitCount(session, extensionSource);
+    SLANG_CHECK(extensionHitCount == secondHitCount);
+
+    const int namespaceOperatorHitCount =
+        _checkAndGetSharedCacheHitCount(session, namespaceOperatorSource);
+    SLANG_CHECK(namespaceOperatorHitCount == secondHitCount);
+
+    spDestroySession(session);
+}
@@ -5,8 +5,12 @@
 #include "../../source/compiler-core/slang-json-source-map-util.h"
 #include "../../source/compiler-core/slang-json-value.h"
 #include "../../source/compiler-core/slang-source-map.h"
+#include "../../source/core/slang-io.h"
 #include "../../source/core/slang-rtti-info.h"
 #include "../../source/core/slang-string-escape-util.h"
+#include "../../source/core/slang-string-util.h"
+#include "slang-com-ptr.h"
+#include "slang.h"
 #include "unit-test/slang-unit-test.h"
 
 using namespace Slang;
@@ -122,3 +126,145 @@ SLANG_UNIT_TEST(sourceMap)
 {
     SLANG_CHECK(SLANG_SUCCEEDED(_check()));
 }
+
+namespace
+{ // anonymous
+
+struct SourceMapFileFinder
+{
+    ISlangMutableFileSystem* fileSystem;
+    List<String> directories;
+    List<String> sourceMapPaths;
+
+    void find(const String& directory)
+    {
+        m_directory = directory;
+        fileSystem->enumeratePathContents(directory.getBuffer(), &_onEntry, this);
+    }
+
+private:
+    static void _onEntry(SlangPathType pathType, const char* name, void* userData)
+    {
+        auto finder = (SourceMapFileFinder*)userData;
+        const String path = Path::combine(finder->m_directory, name);
+        if (pathType == SLANG_PATH_TYPE_DIRECTORY)
+            finder->directories.add(path);
+        else if (Path::getPathExt(path) == "map")
+            finder->sourceMapPaths.add(path);
+    }
+
+    String m_directory;
+};
+
+} // namespace
+
+// Test that the source map of generated source that is larger than the chunks the source writer
+// holds it in still maps each line to the right source line.
+
+SLANG_UNIT_TEST(sourceMapLargeOutput)
+{
+    // Each statement stores a distinct value, so its line can be found in the output.
+    const Index statementCount = 8000;
+    const Index valueBase = 1000000;
+
+    StringBuilder source;
+    source << "RWStructuredBuffer<int> output;\n";
+    source << "[shader(\"compute\")]\n";
+    source << "[numthreads(1, 1, 1)]\n";
+    source << "void computeMain()\n";
+    source << "{\n";
+    const Index firstStatementLine = 5;
+    for (Index i = 0; i < statementCount; ++i)
+    {
+        source << "    output[" << i << "] = " << (valueBase + i) << ";\n";
+    }
+    source << "}\n";
+
+    ComPtr<slang::IGlobalSession> globalSession;
+    SLANG_CHECK_ABORT(
+        slang_createGlobalSession(SLANG_API_VERSION, globalSession.writeRef()) == SLANG_OK);
+
+    slang::TargetDesc targetDesc = {};
+    targetDesc.format = SLANG_HLSL;
+    targetDesc.profile = globalSession->findProfile("sm_5_0");
+
+    slang::CompilerOptionEntry entry;
+    entry.name = slang::CompilerOptionName::LineDirectiveMode;
+    entry.value.kind = slang::CompilerOptionValueKind::Int;
+    entry.value.intValue0 = SLANG_LINE_DIRECTIVE_MODE_SOURCE_MAP;
+
+    slang::SessionDesc sessionDesc = {};
+    sessionDesc.targetCount = 1;
+    sessionDesc.targets = &targetDesc;
+    sessionDesc.compilerOptionEntryCount = 1;
+    sessionDesc.compilerOptionEntries = &entry;
+    ComPtr<slang::ISession> session;
+    SLANG_CHECK_ABORT(globalSession->createSession(sessionDesc, session.writeRef()) == SLANG_OK);
+
+    ComPtr<slang::IBlob> diagnosticBlob;
+    auto module = session->loadModuleFromSourceString(
+        "m",
+        "m.slang",
+        source.getBuffer(),
+        diagnosticBlob.writeRef());
+    SLANG_CHECK_ABORT(module != nullptr);
+
+    ComPtr<slang::IEntryPoint> entryPoint;
+    SLANG_CHECK_ABORT(
+        SLANG_SUCCEEDED(module->findEntryPointByName("computeMain", entryPoint.writeRef())));
+
+    slang::IComponentType* components[] = {module, entryPoint};
+    ComPtr<slang::IComponentType> program;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        session->createCompositeComponentType(components, 2, program.writeRef(), nullptr)));
+
+    ComPtr<slang::IBlob> codeBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        program->getEntryPointCode(0, 0, codeBlob.writeRef(), diagnosticBlob.writeRef())));
+    const UnownedStringSlice code = StringUtil::getSlice(codeBlob);
+
+    // The output has to span more than one chunk for the test to be meaningful.
+    SLANG_CHECK_ABORT(code.getLength() > 256 * 1024);
+
+    ComPtr<ISlangMutableFileSystem> fileSystem;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(program->getResultAsFileSystem(0, 0, fileSystem.writeRef())));
+
+    SourceMapFileFinder finder;
+    finder.fileSystem = fileSystem;
+    finder.find(".");
+    for (Index i = 0; i < finder.directories.getCount(); ++i)
+    {
+        finder.find(String(finder.directories[i]));
+    }
+    SLANG_CHECK_ABORT(finder.sourceMapPaths.getCount() == 1);
+
+    ComPtr<ISlangBlob> sourceMapBlob;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(
+        fileSystem->loadFile(finder.sourceMapPaths[0].getBuffer(), sourceMapBlob.writeRef())));
+    SourceMap sourceMap;
+    SLANG_CHECK_ABORT(SLANG_SUCCEEDED(JSONSourceMapUtil::read(sourceMapBlob, sourceMap)));
+
+    // Check statements spread through the output, including either side of chunk boundaries.
+    Index offset = 0;
+    Index generatedLine = 0;
+    for (Index i = 0; i < statementCount; i += 50)
+    {
+        StringBuilder value;
+        value << (valueBase + i);
+        const Index valueOffset = code.indexOf(value.getUnownedSlice());
+        SLANG_CHECK_ABORT(valueOffset >= offset);
+
+        for (; offset < valueOffset; ++offset)
+        {
+            generatedLine += Index(code[offset] == '\n');
+        }
+        SLANG_CHECK_ABORT(generatedLine < sourceMap.getGeneratedLineCount());
+
+        bool found = false;
+        for (const auto& lineEntry : sourceMap.getEntriesForLine(generatedLine))
+        {
+            found = found || lineEntry.sourceLine == firstStatementLine + i;
+        }
+        SLANG_CHECK(found);
+    }
+}
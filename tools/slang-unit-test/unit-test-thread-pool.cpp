@@ -0,0 +1,86 @@
+// unit-test-thread-pool.cpp
+
+#include "../../source/core/slang-thread-pool.h"
+#include "unit-test/slang-unit-test.h"
+
+#include <atomic>
+#include <stdexcept>
+
+using namespace Slang;
+
+// Test that a thread pool runs every iteration of a loop exactly once, including loops nested in
+// other loops, and passes exceptions back to the calling thread.
+
+static void _checkThreadPool(ThreadPool* pool)
+{
+    // Every iteration runs once
+    {
+        const Index count = 1000;
+        std::atomic<int> runCounts[count];
+        for (auto& runCount : runCounts)
+            runCount = 0;
+
+        pool->parallelFor(count, [&](Index i) { runCounts[i]++; });
+
+        bool allRunOnce = true;
+        for (auto& runCount : runCounts)
+            allRunOnce = allRunOnce && runCount == 1;
+        SLANG_CHECK(allRunOnce);
+    }
+
+    // Loops can be nested
+    {
+        std::atomic<Index> total{0};
+        pool->parallelFor(
+            16,
+            [&](Index i) { pool->parallelFor(i, [&](Index j) { total += j + 1; }); });
+
+        Index expected = 0;
+        for (Index i = 0; i < 16; ++i)
+            expected += i * (i + 1) / 2;
+        SLANG_CHECK(total == expected);
+    }
+
+    // An exception is rethrown on the calling thread, and the pool is still usable afterwards
+    {
+        bool caught = false;
+        try
+        {
+            pool->parallelFor(
+                100,
+                [&](Index i)
+                {
+                    if (i == 50)
+                        throw std::runtime_error("iteration failed");
+                });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        SLANG_CHECK(caught);
+
+        std::atomic<Index> runCount{0};
+        pool->parallelFor(10, [&](Index) { runCount++; });
+        SLANG_CHECK(runCount == 10);
+    }
+
+    // Empty loops do nothing
+    pool->parallelFor(0, [&](Index) { SLANG_CHECK(!"unexpected iteration"); });
+}
+
+SLANG_UNIT_TEST(threadPool)
+{
+    {
+        RefPtr<ThreadPool> pool = new ThreadPool(4);
+        SLANG_CHECK(pool->getThreadCount() == 4);
+        _checkThreadPool(pool);
+    }
+
+    // Without any workers everything runs on the calling thread
+    {
+        RefPtr<ThreadPool> pool = new ThreadPool(0);
+        SLANG_CHECK(pool->getThreadCount() == 0);
+        _checkThreadPool(pool);
+    }
+}